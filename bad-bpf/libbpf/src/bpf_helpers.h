@@ -302,6 +302,25 @@ enum libbpf_tristate {
 /* Helper macro to print out debug messages */
 #define bpf_printk(fmt, args...) ___bpf_pick_printk(args)(fmt, ##args)
 
+/*
+ * Send a record over a PERF_EVENT_ARRAY map declared with
+ * __uint(map_extra, N). libbpf turns such a map into a BPF ring buffer
+ * of N bytes when the kernel supports it; this macro emits the matching
+ * helper call, the other branch being dead code the verifier prunes.
+ * perf_buffer__new() consumes either kind of map.
+ *
+ * The helper is chosen for the whole kernel, not for the map, so every
+ * perf event array used by a program calling bpf_event_output() must have
+ * the ring buffer size set; libbpf fails the load otherwise.
+ */
+extern _Bool LINUX_HAS_RINGBUF __kconfig __weak;
+
+#define bpf_event_output(ctx, map, data, size) ({				\
+	LINUX_HAS_RINGBUF							\
+		? bpf_ringbuf_output(map, data, size, 0)			\
+		: bpf_perf_event_output(ctx, map, BPF_F_CURRENT_CPU, data, size); \
+})
+
 struct bpf_iter_num;
 
 extern int bpf_iter_num_new(struct bpf_iter_num *it, int start, int end) __weak __ksym;
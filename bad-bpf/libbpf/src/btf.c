@@ -9,7 +9,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
 #include <sys/utsname.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/stat.h>
 #include <linux/kernel.h>
@@ -36,6 +38,8 @@ struct btf {
 	__u32 raw_size;
 	/* whether target endianness differs from the native one */
 	bool swapped_endian;
+	/* where raw_data comes from and who releases it */
+	enum btf_raw_data_src raw_data_src;
 
 	/*
 	 * When BTF is loaded from an ELF or raw memory it is stored
@@ -121,6 +125,15 @@ struct btf {
 
 	/* Pointer size (in bytes) for a target architecture of this BTF */
 	int ptr_sz;
+
+	/* (name, kind) -> type ID lookup index over this instance's own
+	 * types, built lazily by btf__find_by_name_kind() and dropped on any
+	 * modification; keys are hashes, so hits are verified by name.
+	 * Published with a cmpxchg, see btf_name_kind_idx().
+	 */
+	struct hashmap *name_kind_idx;
+	/* types visited by linear name lookups, see BTF_NAME_IDX_SCANS */
+	__u64 name_scan_cnt;
 };
 
 static inline __u64 ptr_to_u64(const void *ptr)
@@ -908,14 +921,137 @@ __s32 btf__find_by_name(const struct btf *btf, const char *type_name)
 	return libbpf_err(-ENOENT);
 }
 
+static size_t btf_name_kind_hash_fn(long key, void *ctx)
+{
+	return key;
+}
+
+static bool btf_name_kind_equal_fn(long k1, long k2, void *ctx)
+{
+	return k1 == k2;
+}
+
+/*
+ * Building the name index of vmlinux BTF costs about as much as 16 to 20
+ * full linear lookups, and most objects do only a handful. So lookups scan
+ * until they have visited all types this many times over, and only then
+ * build the index: an object doing few lookups never pays for it, one doing
+ * many pays at most twice what the index alone would have cost.
+ */
+#define BTF_NAME_IDX_SCANS 16
+
+static long btf_name_kind_key(const char *name, __u32 kind)
+{
+	return (long)(str_hash(name) * 31 + kind);
+}
+
+static void btf_free_name_kind_idx(struct btf *btf)
+{
+	hashmap__free(btf->name_kind_idx);
+	btf->name_kind_idx = NULL;
+}
+
+static struct hashmap *btf_new_name_kind_idx(const struct btf *btf)
+{
+	__u32 i, nr_types = btf__type_cnt(btf);
+	struct hashmap *idx;
+	int err;
+
+	idx = hashmap__new(btf_name_kind_hash_fn, btf_name_kind_equal_fn, NULL);
+	if (IS_ERR(idx))
+		return idx;
+
+	for (i = btf->start_id; i < nr_types; i++) {
+		const struct btf_type *t = btf__type_by_id(btf, i);
+		const char *name;
+
+		if (!t->name_off)
+			continue;
+		name = btf__name_by_offset(btf, t->name_off);
+		if (!name)
+			continue;
+		err = hashmap__append(idx, btf_name_kind_key(name, btf_kind(t)), i);
+		if (err) {
+			hashmap__free(idx);
+			return ERR_PTR(err);
+		}
+	}
+
+	return idx;
+}
+
+/*
+ * Returns the name index of btf, building it if linear lookups have become
+ * expensive enough, or an error pointer if lookups should keep scanning.
+ * Lookups are logically const and may run concurrently, so several of them
+ * can build an index at the same time: the first one to publish it wins,
+ * the others free theirs. Modifying BTF is not safe against concurrent
+ * lookups anyway, so dropping the index needs no such care.
+ */
+static struct hashmap *btf_name_kind_idx(const struct btf *btf)
+{
+	struct hashmap **slot = &((struct btf *)btf)->name_kind_idx;
+	struct hashmap *idx, *old = NULL;
+	__u64 scanned;
+
+	idx = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+	if (idx)
+		return idx;
+
+	scanned = __atomic_load_n(&btf->name_scan_cnt, __ATOMIC_RELAXED);
+	if (scanned < (__u64)btf->nr_types * BTF_NAME_IDX_SCANS)
+		return ERR_PTR(-EAGAIN);
+
+	idx = btf_new_name_kind_idx(btf);
+	if (IS_ERR(idx))
+		return idx;
+	if (!__atomic_compare_exchange_n(slot, &old, idx, false,
+					 __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		hashmap__free(idx);
+		idx = old;
+	}
+	return idx;
+}
+
 static __s32 btf_find_by_name_kind(const struct btf *btf, int start_id,
 				   const char *type_name, __u32 kind)
 {
 	__u32 i, nr_types = btf__type_cnt(btf);
+	struct hashmap_entry *entry;
+	struct hashmap *idx;
+	__s32 id;
+	long key;
 
 	if (kind == BTF_KIND_UNKN || !strcmp(type_name, "void"))
 		return 0;
 
+	/* base BTF types come first in ID order */
+	if (btf->base_btf && start_id < btf->start_id) {
+		id = btf_find_by_name_kind(btf->base_btf, start_id, type_name, kind);
+		if (id != -ENOENT)
+			return id;
+		start_id = btf->start_id;
+	}
+
+	idx = btf_name_kind_idx(btf);
+	if (!IS_ERR(idx)) {
+		key = btf_name_kind_key(type_name, kind);
+		id = -ENOENT;
+		hashmap__for_each_key_entry(idx, entry, key) {
+			const struct btf_type *t = btf__type_by_id(btf, entry->value);
+
+			/* keep the lowest matching ID, like the linear scan */
+			if (entry->value < start_id || (id > 0 && entry->value > id))
+				continue;
+			if (btf_kind(t) != kind ||
+			    strcmp(btf__name_by_offset(btf, t->name_off), type_name))
+				continue;
+			id = entry->value;
+		}
+		return id > 0 ? id : libbpf_err(-ENOENT);
+	}
+
+	/* no index yet, or no memory for one */
 	for (i = start_id; i < nr_types; i++) {
 		const struct btf_type *t = btf__type_by_id(btf, i);
 		const char *name;
@@ -924,10 +1060,12 @@ static __s32 btf_find_by_name_kind(const struct btf *btf, int start_id,
 			continue;
 		name = btf__name_by_offset(btf, t->name_off);
 		if (name && !strcmp(type_name, name))
-			return i;
+			break;
 	}
+	__atomic_add_fetch(&((struct btf *)btf)->name_scan_cnt, i - start_id,
+			   __ATOMIC_RELAXED);
 
-	return libbpf_err(-ENOENT);
+	return i < nr_types ? i : libbpf_err(-ENOENT);
 }
 
 __s32 btf__find_by_name_kind_own(const struct btf *btf, const char *type_name,
@@ -947,6 +1085,22 @@ static bool btf_is_modifiable(const struct btf *btf)
 	return (void *)btf->hdr != btf->raw_data;
 }
 
+static void btf_free_raw_data(struct btf *btf)
+{
+	switch (btf->raw_data_src) {
+	case BTF_RAW_DATA_MMAP:
+		munmap(btf->raw_data, btf->raw_size);
+		break;
+	case BTF_RAW_DATA_VIEW:
+		break;
+	default:
+		free(btf->raw_data);
+		break;
+	}
+	btf->raw_data = NULL;
+	btf->raw_data_src = BTF_RAW_DATA_COPY;
+}
+
 void btf__free(struct btf *btf)
 {
 	if (IS_ERR_OR_NULL(btf))
@@ -966,9 +1120,10 @@ void btf__free(struct btf *btf)
 		free(btf->types_data);
 		strset__free(btf->strs_set);
 	}
-	free(btf->raw_data);
+	btf_free_raw_data(btf);
 	free(btf->raw_data_swapped);
 	free(btf->type_offs);
+	btf_free_name_kind_idx(btf);
 	free(btf);
 }
 
@@ -1023,14 +1178,22 @@ struct btf *btf__new_empty_split(struct btf *base_btf)
 	return libbpf_ptr(btf_new_empty(base_btf));
 }
 
-static struct btf *btf_new(const void *data, __u32 size, struct btf *base_btf)
+/* Unless src is BTF_RAW_DATA_COPY, the new BTF uses data in place. A
+ * BTF_RAW_DATA_MMAP mapping is owned by the BTF from here on, and unmapped
+ * on failure too.
+ */
+static struct btf *btf_new(const void *data, __u32 size, struct btf *base_btf,
+			   enum btf_raw_data_src src)
 {
 	struct btf *btf;
 	int err;
 
 	btf = calloc(1, sizeof(struct btf));
-	if (!btf)
+	if (!btf) {
+		if (src == BTF_RAW_DATA_MMAP)
+			munmap((void *)data, size);
 		return ERR_PTR(-ENOMEM);
+	}
 
 	btf->nr_types = 0;
 	btf->start_id = 1;
@@ -1043,12 +1206,17 @@ static struct btf *btf_new(const void *data, __u32 size, struct btf *base_btf)
 		btf->start_str_off = base_btf->hdr->str_len;
 	}
 
-	btf->raw_data = malloc(size);
-	if (!btf->raw_data) {
-		err = -ENOMEM;
-		goto done;
+	if (src != BTF_RAW_DATA_COPY) {
+		btf->raw_data = (void *)data;
+		btf->raw_data_src = src;
+	} else {
+		btf->raw_data = malloc(size);
+		if (!btf->raw_data) {
+			err = -ENOMEM;
+			goto done;
+		}
+		memcpy(btf->raw_data, data, size);
 	}
-	memcpy(btf->raw_data, data, size);
 	btf->raw_size = size;
 
 	btf->hdr = btf->raw_data;
@@ -1076,12 +1244,17 @@ done:
 
 struct btf *btf__new(const void *data, __u32 size)
 {
-	return libbpf_ptr(btf_new(data, size, NULL));
+	return libbpf_ptr(btf_new(data, size, NULL, BTF_RAW_DATA_COPY));
+}
+
+struct btf *btf_new_view(void *data, __u32 size)
+{
+	return btf_new(data, size, NULL, BTF_RAW_DATA_VIEW);
 }
 
 struct btf *btf__new_split(const void *data, __u32 size, struct btf *base_btf)
 {
-	return libbpf_ptr(btf_new(data, size, base_btf));
+	return libbpf_ptr(btf_new(data, size, base_btf, BTF_RAW_DATA_COPY));
 }
 
 static struct btf *btf_parse_elf(const char *path, struct btf *base_btf,
@@ -1109,7 +1282,7 @@ static struct btf *btf_parse_elf(const char *path, struct btf *base_btf,
 
 	err = -LIBBPF_ERRNO__FORMAT;
 
-	elf = elf_begin(fd, ELF_C_READ, NULL);
+	elf = elf_begin(fd, ELF_C_READ_MMAP, NULL);
 	if (!elf) {
 		pr_warn("failed to open %s as ELF file\n", path);
 		goto done;
@@ -1170,7 +1343,7 @@ static struct btf *btf_parse_elf(const char *path, struct btf *base_btf,
 		err = -ENODATA;
 		goto done;
 	}
-	btf = btf_new(btf_data->d_buf, btf_data->d_size, base_btf);
+	btf = btf_new(btf_data->d_buf, btf_data->d_size, base_btf, BTF_RAW_DATA_COPY);
 	err = libbpf_get_error(btf);
 	if (err)
 		goto done;
@@ -1274,7 +1447,7 @@ static struct btf *btf_parse_raw(const char *path, struct btf *base_btf)
 	}
 
 	/* finally parse BTF data */
-	btf = btf_new(data, sz, base_btf);
+	btf = btf_new(data, sz, base_btf, BTF_RAW_DATA_COPY);
 
 err_out:
 	free(data);
@@ -1283,6 +1456,49 @@ err_out:
 	return err ? ERR_PTR(err) : btf;
 }
 
+/*
+ * Maps raw BTF instead of reading it, for kernels that allow mmap() of
+ * /sys/kernel/btf/vmlinux: its pages are then shared with the kernel image
+ * rather than copied into every process. Only native-endian BTF can be
+ * parsed in place.
+ */
+static struct btf *btf_parse_raw_mmap(const char *path, struct btf *base_btf)
+{
+	struct btf *btf;
+	struct stat st;
+	void *data;
+	int fd, err;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return ERR_PTR(-errno);
+
+	if (fstat(fd, &st) < 0) {
+		err = -errno;
+		close(fd);
+		return ERR_PTR(err);
+	}
+	if (st.st_size < sizeof(struct btf_header) || st.st_size > UINT_MAX) {
+		close(fd);
+		return ERR_PTR(-EINVAL);
+	}
+
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	err = data == MAP_FAILED ? -errno : 0;
+	close(fd);
+	if (err)
+		return ERR_PTR(err);
+
+	if (((struct btf_header *)data)->magic != BTF_MAGIC) {
+		munmap(data, st.st_size);
+		return ERR_PTR(-EPROTO);
+	}
+
+	/* on failure, btf_new() unmaps data */
+	btf = btf_new(data, st.st_size, base_btf, BTF_RAW_DATA_MMAP);
+	return btf;
+}
+
 struct btf *btf__parse_raw(const char *path)
 {
 	return libbpf_ptr(btf_parse_raw(path, NULL));
@@ -1557,7 +1773,7 @@ struct btf *btf_get_from_fd(int btf_fd, struct btf *base_btf)
 		goto exit_free;
 	}
 
-	btf = btf_new(ptr, btf_info.btf_size, base_btf);
+	btf = btf_new(ptr, btf_info.btf_size, base_btf, BTF_RAW_DATA_COPY);
 
 exit_free:
 	free(ptr);
@@ -1586,10 +1802,8 @@ struct btf *btf__load_from_kernel_by_id(__u32 id)
 
 static void btf_invalidate_raw_data(struct btf *btf)
 {
-	if (btf->raw_data) {
-		free(btf->raw_data);
-		btf->raw_data = NULL;
-	}
+	if (btf->raw_data)
+		btf_free_raw_data(btf);
 	if (btf->raw_data_swapped) {
 		free(btf->raw_data_swapped);
 		btf->raw_data_swapped = NULL;
@@ -1606,6 +1820,9 @@ static int btf_ensure_modifiable(struct btf *btf)
 	struct strset *set = NULL;
 	int err = -ENOMEM;
 
+	/* types are about to change, the name index has to be rebuilt */
+	btf_free_name_kind_idx(btf);
+
 	if (btf_is_modifiable(btf)) {
 		/* any BTF modification invalidates raw_data */
 		btf_invalidate_raw_data(btf);
@@ -2996,11 +3213,12 @@ void btf_ext__free(struct btf_ext *btf_ext)
 	free(btf_ext->func_info.sec_idxs);
 	free(btf_ext->line_info.sec_idxs);
 	free(btf_ext->core_relo_info.sec_idxs);
-	free(btf_ext->data);
+	if (!btf_ext->data_is_view)
+		free(btf_ext->data);
 	free(btf_ext);
 }
 
-struct btf_ext *btf_ext__new(const __u8 *data, __u32 size)
+static struct btf_ext *btf_ext_new(const __u8 *data, __u32 size, bool view)
 {
 	struct btf_ext *btf_ext;
 	int err;
@@ -3010,12 +3228,17 @@ struct btf_ext *btf_ext__new(const __u8 *data, __u32 size)
 		return libbpf_err_ptr(-ENOMEM);
 
 	btf_ext->data_size = size;
-	btf_ext->data = malloc(size);
-	if (!btf_ext->data) {
-		err = -ENOMEM;
-		goto done;
+	if (view) {
+		btf_ext->data = (void *)data;
+		btf_ext->data_is_view = true;
+	} else {
+		btf_ext->data = malloc(size);
+		if (!btf_ext->data) {
+			err = -ENOMEM;
+			goto done;
+		}
+		memcpy(btf_ext->data, data, size);
 	}
-	memcpy(btf_ext->data, data, size);
 
 	err = btf_ext_parse_hdr(btf_ext->data, size);
 	if (err)
@@ -3050,6 +3273,16 @@ done:
 	return btf_ext;
 }
 
+struct btf_ext *btf_ext__new(const __u8 *data, __u32 size)
+{
+	return btf_ext_new(data, size, false);
+}
+
+struct btf_ext *btf_ext_new_view(void *data, __u32 size)
+{
+	return btf_ext_new(data, size, true);
+}
+
 const void *btf_ext__raw_data(const struct btf_ext *btf_ext, __u32 *size)
 {
 	*size = btf_ext->data_size;
@@ -3066,6 +3299,7 @@ static struct btf_dedup *btf_dedup_new(struct btf *btf, const struct btf_dedup_o
 static void btf_dedup_free(struct btf_dedup *d);
 static int btf_dedup_prep(struct btf_dedup *d);
 static int btf_dedup_strings(struct btf_dedup *d);
+static int btf_dedup_hash_types(struct btf_dedup *d);
 static int btf_dedup_prim_types(struct btf_dedup *d);
 static int btf_dedup_struct_types(struct btf_dedup *d);
 static int btf_dedup_ref_types(struct btf_dedup *d);
@@ -3240,6 +3474,11 @@ int btf__dedup(struct btf *btf, const struct btf_dedup_opts *opts)
 		pr_debug("btf_dedup_strings failed:%d\n", err);
 		goto done;
 	}
+	err = btf_dedup_hash_types(d);
+	if (err < 0) {
+		pr_debug("btf_dedup_hash_types failed:%d\n", err);
+		goto done;
+	}
 	err = btf_dedup_prim_types(d);
 	if (err < 0) {
 		pr_debug("btf_dedup_prim_types failed:%d\n", err);
@@ -3272,6 +3511,8 @@ int btf__dedup(struct btf *btf, const struct btf_dedup_opts *opts)
 	}
 
 done:
+	/* types were merged and renumbered in place */
+	btf_free_name_kind_idx(btf);
 	btf_dedup_free(d);
 	return libbpf_err(err);
 }
@@ -3313,6 +3554,11 @@ struct btf_dedup {
 	struct btf_dedup_opts opts;
 	/* temporary strings deduplication state */
 	struct strset *strs_set;
+	/* Signature hashes of primitive and struct/union types, indexed by
+	 * type ID - btf->start_id; computed by worker threads ahead of the
+	 * prim and struct passes when opts.thread_cnt > 1, NULL otherwise
+	 */
+	long *type_hashes;
 };
 
 static long hash_combine(long h, long value)
@@ -3369,6 +3615,9 @@ static void btf_dedup_free(struct btf_dedup *d)
 	free(d->hypot_list);
 	d->hypot_list = NULL;
 
+	free(d->type_hashes);
+	d->type_hashes = NULL;
+
 	free(d);
 }
 
@@ -3401,6 +3650,7 @@ static struct btf_dedup *btf_dedup_new(struct btf *btf, const struct btf_dedup_o
 
 	d->btf = btf;
 	d->btf_ext = OPTS_GET(opts, btf_ext, NULL);
+	d->opts.thread_cnt = OPTS_GET(opts, thread_cnt, 0);
 
 	d->dedup_table = hashmap__new(hash_fn, btf_dedup_equal_fn, NULL);
 	if (IS_ERR(d->dedup_table)) {
@@ -3769,6 +4019,109 @@ static bool btf_compat_array(struct btf_type *t1, struct btf_type *t2)
 	return btf_array(t1)->nelems == btf_array(t2)->nelems;
 }
 
+/*
+ * Signature hash of a type that doesn't depend on dedup results of other
+ * types: INT, ENUM/ENUM64, FWD, FLOAT, STRUCT/UNION. These can be computed
+ * for all types in parallel before the prim and struct passes run.
+ */
+static long btf_hash_standalone(struct btf_type *t)
+{
+	switch (btf_kind(t)) {
+	case BTF_KIND_INT:
+		return btf_hash_int_decl_tag(t);
+	case BTF_KIND_ENUM:
+	case BTF_KIND_ENUM64:
+		return btf_hash_enum(t);
+	case BTF_KIND_FWD:
+	case BTF_KIND_FLOAT:
+		return btf_hash_common(t);
+	case BTF_KIND_STRUCT:
+	case BTF_KIND_UNION:
+		return btf_hash_struct(t);
+	default:
+		return 0;
+	}
+}
+
+static long btf_dedup_standalone_hash(struct btf_dedup *d, __u32 type_id, struct btf_type *t)
+{
+	if (d->type_hashes)
+		return d->type_hashes[type_id - d->btf->start_id];
+	return btf_hash_standalone(t);
+}
+
+struct btf_dedup_hash_worker {
+	struct btf_dedup *d;
+	__u32 start;
+	__u32 end;
+	pthread_t tid;
+	bool started;
+};
+
+static void *btf_dedup_hash_worker_fn(void *arg)
+{
+	struct btf_dedup_hash_worker *w = arg;
+	struct btf_dedup *d = w->d;
+	__u32 i;
+
+	for (i = w->start; i < w->end; i++)
+		d->type_hashes[i] = btf_hash_standalone(btf_type_by_id(d->btf, d->btf->start_id + i));
+	return NULL;
+}
+
+/* below that, thread startup costs more than the hashing */
+#define BTF_DEDUP_MIN_TYPES_PER_THREAD 4096
+
+/*
+ * Precompute signature hashes of all standalone types with opts.thread_cnt
+ * threads, each taking a contiguous range of type IDs. Workers only read
+ * type data and write their own slots; the prim and struct passes then
+ * consume hashes in type ID order, exactly as if computed inline, so the
+ * result is identical to single-threaded dedup.
+ */
+static int btf_dedup_hash_types(struct btf_dedup *d)
+{
+	struct btf_dedup_hash_worker *workers;
+	__u32 nr_types = d->btf->nr_types;
+	__u32 thread_cnt = d->opts.thread_cnt;
+	__u32 i, chunk;
+
+	if (thread_cnt > nr_types / BTF_DEDUP_MIN_TYPES_PER_THREAD)
+		thread_cnt = nr_types / BTF_DEDUP_MIN_TYPES_PER_THREAD;
+	if (thread_cnt <= 1)
+		return 0;
+
+	d->type_hashes = calloc(nr_types, sizeof(*d->type_hashes));
+	workers = calloc(thread_cnt, sizeof(*workers));
+	if (!d->type_hashes || !workers) {
+		free(workers);
+		return -ENOMEM;
+	}
+
+	chunk = (nr_types + thread_cnt - 1) / thread_cnt;
+	for (i = 0; i < thread_cnt; i++) {
+		workers[i].d = d;
+		workers[i].start = i * chunk;
+		workers[i].end = min(nr_types, (i + 1) * chunk);
+		/* the calling thread takes the first range */
+		if (i == 0)
+			continue;
+		workers[i].started = !pthread_create(&workers[i].tid, NULL,
+						     btf_dedup_hash_worker_fn, &workers[i]);
+	}
+
+	btf_dedup_hash_worker_fn(&workers[0]);
+	for (i = 1; i < thread_cnt; i++) {
+		if (workers[i].started)
+			pthread_join(workers[i].tid, NULL);
+		else
+			btf_dedup_hash_worker_fn(&workers[i]);
+	}
+
+	free(workers);
+	return 0;
+}
+
 /*
  * Calculate type signature hash of FUNC_PROTO, including referenced type IDs,
  * under assumption that they were already resolved to canonical type IDs and
@@ -3942,7 +4295,7 @@ static int btf_dedup_prim_type(struct btf_dedup *d, __u32 type_id)
 		return 0;
 
 	case BTF_KIND_INT:
-		h = btf_hash_int_decl_tag(t);
+		h = btf_dedup_standalone_hash(d, type_id, t);
 		for_each_dedup_cand(d, hash_entry, h) {
 			cand_id = hash_entry->value;
 			cand = btf_type_by_id(d->btf, cand_id);
@@ -3955,7 +4308,7 @@ static int btf_dedup_prim_type(struct btf_dedup *d, __u32 type_id)
 
 	case BTF_KIND_ENUM:
 	case BTF_KIND_ENUM64:
-		h = btf_hash_enum(t);
+		h = btf_dedup_standalone_hash(d, type_id, t);
 		for_each_dedup_cand(d, hash_entry, h) {
 			cand_id = hash_entry->value;
 			cand = btf_type_by_id(d->btf, cand_id);
@@ -3977,7 +4330,7 @@ static int btf_dedup_prim_type(struct btf_dedup *d, __u32 type_id)
 
 	case BTF_KIND_FWD:
 	case BTF_KIND_FLOAT:
-		h = btf_hash_common(t);
+		h = btf_dedup_standalone_hash(d, type_id, t);
 		for_each_dedup_cand(d, hash_entry, h) {
 			cand_id = hash_entry->value;
 			cand = btf_type_by_id(d->btf, cand_id);
@@ -4480,7 +4833,7 @@ static int btf_dedup_struct_type(struct btf_dedup *d, __u32 type_id)
 	if (kind != BTF_KIND_STRUCT && kind != BTF_KIND_UNION)
 		return 0;
 
-	h = btf_hash_struct(t);
+	h = btf_dedup_standalone_hash(d, type_id, t);
 	for_each_dedup_cand(d, hash_entry, h) {
 		__u32 cand_id = hash_entry->value;
 		int eq;
@@ -4962,6 +5315,11 @@ struct btf *btf__load_vmlinux_btf(void)
 		pr_warn("kernel BTF is missing at '%s', was CONFIG_DEBUG_INFO_BTF enabled?\n",
 			sysfs_btf_path);
 	} else {
+		btf = btf_parse_raw_mmap(sysfs_btf_path, NULL);
+		if (!IS_ERR(btf)) {
+			pr_debug("mapped kernel BTF from '%s'\n", sysfs_btf_path);
+			return btf;
+		}
 		btf = btf__parse(sysfs_btf_path, NULL);
 		if (!btf) {
 			err = -errno;
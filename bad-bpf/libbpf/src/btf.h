@@ -225,9 +225,13 @@ struct btf_dedup_opts {
 	struct btf_ext *btf_ext;
 	/* force hash collisions (used for testing) */
 	bool force_collisions;
+	/* number of threads computing type signature hashes up front;
+	 * 0 or 1 keeps dedup single-threaded. Output is identical either way.
+	 */
+	__u32 thread_cnt;
 	size_t :0;
 };
-#define btf_dedup_opts__last_field force_collisions
+#define btf_dedup_opts__last_field thread_cnt
 
 LIBBPF_API int btf__dedup(struct btf *btf, const struct btf_dedup_opts *opts);
 
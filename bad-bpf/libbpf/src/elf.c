@@ -6,9 +6,12 @@
 #include <libelf.h>
 #include <gelf.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
 #include <linux/kernel.h>
 
 #include "libbpf_internal.h"
+#include "hashmap.h"
 #include "str_error.h"
 
 /* A SHT_GNU_versym section holds 16-bit words. This bit is set if
@@ -369,34 +372,369 @@ out:
 	return ret;
 }
 
-/* Find offset of function name in ELF object specified by path. "name" matches
- * symbol name or name@@LIB for library functions.
+/* Index of all symbols of one st_type in a binary, both from SHT_DYNSYM and
+ * SHT_SYMTAB, so that resolving many names doesn't walk the symbol tables
+ * once per name (uprobe-multi attaches to thousands of functions in binaries
+ * with hundreds of thousands of symbols). Symbols are stored in symbol table
+ * order, dynsym first, and chained by their name without "@VERSION" suffix
+ * through a hashmap, so a lookup costs only as much as the number of
+ * symbols sharing that name.
+ *
+ * Indexes are built once and kept in a small process-wide cache keyed by
+ * device, inode, size, and modification time of the binary, so repeated
+ * attaches to the same binary (e.g., libc for many PIDs) don't even have to
+ * open it again.
  */
-long elf_find_func_offset_from_file(const char *binary_path, const char *name)
+struct elf_sym_ent {
+	size_t name_off;
+	size_t vername_off;	/* 0, if no version */
+	unsigned long offset;
+	int next;		/* next symbol with the same name, or -1 */
+	int bind;
+	bool dynsym;
+};
+
+struct elf_sym_index {
+	dev_t dev;
+	ino_t ino;
+	off_t size;
+	struct timespec mtime;
+	int st_type;
+	int e_type;
+	int refcnt;
+
+	char *strs;
+	size_t strs_len;
+	size_t strs_cap;
+	struct elf_sym_ent *syms;
+	size_t sym_cnt;
+	size_t sym_cap;
+	struct hashmap *by_name;
+};
+
+#define ELF_SYM_INDEX_CACHE_SZ 4
+
+static struct elf_sym_index *sym_index_cache[ELF_SYM_INDEX_CACHE_SZ];
+static pthread_mutex_t sym_index_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* hash and compare symbol names up to "@VERSION" suffix */
+static size_t sym_base_name_hash(long key, void *ctx)
+{
+	const char *s = (const char *)key;
+	size_t h = 0;
+
+	for (; *s && *s != '@'; s++)
+		h = h * 31 + *s;
+	return h;
+}
+
+static bool sym_base_name_equal(long key1, long key2, void *ctx)
+{
+	const char *a = (const char *)key1, *b = (const char *)key2;
+
+	for (; *a && *a != '@' && *a == *b; a++, b++)
+		;
+	return (*a == '\0' || *a == '@') && (*b == '\0' || *b == '@');
+}
+
+static void elf_sym_index_free(struct elf_sym_index *idx)
+{
+	if (!idx)
+		return;
+
+	hashmap__free(idx->by_name);
+	free(idx->strs);
+	free(idx->syms);
+	free(idx);
+}
+
+static long elf_sym_index_add_str(struct elf_sym_index *idx, const char *s)
+{
+	size_t off = idx->strs_len, len = strlen(s) + 1;
+	int err;
+
+	err = libbpf_ensure_mem((void **)&idx->strs, &idx->strs_cap, 1, off + len);
+	if (err)
+		return err;
+
+	memcpy(idx->strs + off, s, len);
+	idx->strs_len += len;
+	return off;
+}
+
+static int elf_sym_index_build(struct elf_sym_index *idx, Elf *elf, const char *binary_path)
+{
+	int i, err, sh_types[2] = { SHT_DYNSYM, SHT_SYMTAB };
+	GElf_Ehdr ehdr;
+	long off, head;
+
+	if (!gelf_getehdr(elf, &ehdr)) {
+		pr_warn("elf: failed to get ehdr from %s: %s\n", binary_path, elf_errmsg(-1));
+		return -LIBBPF_ERRNO__FORMAT;
+	}
+	idx->e_type = ehdr.e_type;
+
+	/* offset 0 is reserved for "no version" */
+	off = elf_sym_index_add_str(idx, "");
+	if (off < 0)
+		return off;
+
+	for (i = 0; i < ARRAY_SIZE(sh_types); i++) {
+		struct elf_sym_iter iter;
+		struct elf_sym *sym;
+
+		err = elf_sym_iter_new(&iter, elf, binary_path, sh_types[i], idx->st_type);
+		if (err == -ENOENT)
+			continue;
+		if (err)
+			return err;
+
+		while ((sym = elf_sym_iter_next(&iter))) {
+			struct elf_sym_ent *ent;
+			const char *vername;
+
+			err = libbpf_ensure_mem((void **)&idx->syms, &idx->sym_cap,
+						sizeof(*idx->syms), idx->sym_cnt + 1);
+			if (err)
+				return err;
+			ent = &idx->syms[idx->sym_cnt];
+			memset(ent, 0, sizeof(*ent));
+
+			off = elf_sym_index_add_str(idx, sym->name);
+			if (off < 0)
+				return off;
+			ent->name_off = off;
+
+			/* only dynamic symbols are matched by verdef version name */
+			vername = sh_types[i] == SHT_DYNSYM ? elf_get_vername(&iter, sym->ver) : NULL;
+			if (vername) {
+				off = elf_sym_index_add_str(idx, vername);
+				if (off < 0)
+					return off;
+				ent->vername_off = off;
+			}
+
+			ent->offset = elf_sym_offset(sym);
+			ent->bind = GELF_ST_BIND(sym->sym.st_info);
+			ent->dynsym = sh_types[i] == SHT_DYNSYM;
+			ent->next = -1;
+			idx->sym_cnt++;
+		}
+	}
+
+	idx->by_name = hashmap__new(sym_base_name_hash, sym_base_name_equal, NULL);
+	if (IS_ERR(idx->by_name)) {
+		err = PTR_ERR(idx->by_name);
+		idx->by_name = NULL;
+		return err;
+	}
+
+	/* strs won't be reallocated anymore, so names can be used as keys;
+	 * go backwards, so that each chain ends up in symbol table order
+	 */
+	for (i = (int)idx->sym_cnt - 1; i >= 0; i--) {
+		const char *name = idx->strs + idx->syms[i].name_off;
+
+		if (hashmap__find(idx->by_name, name, &head))
+			idx->syms[i].next = head;
+		err = hashmap__set(idx->by_name, name, i, NULL, NULL);
+		if (err)
+			return err;
+	}
+
+	return 0;
+}
+
+static bool elf_sym_index_matches(const struct elf_sym_index *idx, const struct stat *st,
+				  int st_type)
 {
+	return idx->dev == st->st_dev && idx->ino == st->st_ino &&
+	       idx->size == st->st_size && idx->st_type == st_type &&
+	       idx->mtime.tv_sec == st->st_mtim.tv_sec &&
+	       idx->mtime.tv_nsec == st->st_mtim.tv_nsec;
+}
+
+static void elf_sym_index_put(struct elf_sym_index *idx)
+{
+	bool last;
+
+	pthread_mutex_lock(&sym_index_lock);
+	last = --idx->refcnt == 0;
+	pthread_mutex_unlock(&sym_index_lock);
+
+	if (last)
+		elf_sym_index_free(idx);
+}
+
+/* Get symbol index of *st_type* symbols for the binary at *binary_path*,
+ * building and caching it, if necessary. Has to be released with
+ * elf_sym_index_put().
+ */
+static struct elf_sym_index *elf_sym_index_get(const char *binary_path, int st_type)
+{
+	struct elf_sym_index *idx, *old = NULL;
 	struct elf_fd elf_fd;
-	long ret = -ENOENT;
+	struct stat st;
+	int i, err;
+
+	/* if stat() fails, elf_open() below will fail and report it */
+	if (stat(binary_path, &st) == 0) {
+		pthread_mutex_lock(&sym_index_lock);
+		for (i = 0; i < ELF_SYM_INDEX_CACHE_SZ; i++) {
+			idx = sym_index_cache[i];
+			if (idx && elf_sym_index_matches(idx, &st, st_type)) {
+				idx->refcnt++;
+				pthread_mutex_unlock(&sym_index_lock);
+				return idx;
+			}
+		}
+		pthread_mutex_unlock(&sym_index_lock);
+	}
 
-	ret = elf_open(binary_path, &elf_fd);
-	if (ret)
-		return ret;
-	ret = elf_find_func_offset(elf_fd.elf, binary_path, name);
+	err = elf_open(binary_path, &elf_fd);
+	if (err)
+		return ERR_PTR(err);
+
+	idx = calloc(1, sizeof(*idx));
+	if (!idx) {
+		err = -ENOMEM;
+		goto err_out;
+	}
+
+	/* key by the file we actually index, not the one we stat()'ed */
+	if (fstat(elf_fd.fd, &st)) {
+		err = -errno;
+		goto err_out;
+	}
+	idx->dev = st.st_dev;
+	idx->ino = st.st_ino;
+	idx->size = st.st_size;
+	idx->mtime = st.st_mtim;
+	idx->st_type = st_type;
+	idx->refcnt = 1;
+
+	err = elf_sym_index_build(idx, elf_fd.elf, binary_path);
+	if (err)
+		goto err_out;
 	elf_close(&elf_fd);
-	return ret;
+
+	/* cache it, evicting the least recently built index, if full */
+	pthread_mutex_lock(&sym_index_lock);
+	old = sym_index_cache[0];
+	memmove(sym_index_cache, sym_index_cache + 1,
+		(ELF_SYM_INDEX_CACHE_SZ - 1) * sizeof(*sym_index_cache));
+	sym_index_cache[ELF_SYM_INDEX_CACHE_SZ - 1] = idx;
+	idx->refcnt++;
+	pthread_mutex_unlock(&sym_index_lock);
+
+	if (old)
+		elf_sym_index_put(old);
+	return idx;
+
+err_out:
+	elf_sym_index_free(idx);
+	elf_close(&elf_fd);
+	return ERR_PTR(err);
 }
 
-struct symbol {
-	const char *name;
-	int bind;
-	int idx;
-};
+/* Same as elf_find_func_offset(), but using symbol index */
+static long elf_sym_index_find_func_offset(const struct elf_sym_index *idx,
+					   const char *binary_path, const char *name)
+{
+	const struct elf_sym_ent *ent;
+	const char *at_symbol, *lib_ver;
+	int t, i, last_bind, cur_bind;
+	long ret = -ENOENT, head;
+	bool found = false;
+
+	/* Does name specify "@@LIB_VER" or "@LIB_VER" ? */
+	at_symbol = strchr(name, '@');
+	if (at_symbol) {
+		/* skip second @ if it's @@LIB_VER case */
+		if (at_symbol[1] == '@')
+			at_symbol++;
+		lib_ver = at_symbol + 1;
+	} else {
+		lib_ver = NULL;
+	}
+
+	if (!hashmap__find(idx->by_name, name, &head))
+		head = -1;
+
+	/* Search SHT_DYNSYM first, then SHT_SYMTAB, see elf_find_func_offset() */
+	for (t = 0; t < 2 && !(found && ret > 0); t++) {
+		bool dynsym = t == 0;
+
+		last_bind = -1;
+		for (i = head; i >= 0; i = ent->next) {
+			ent = &idx->syms[i];
+			if (ent->dynsym != dynsym)
+				continue;
+			/* chain only has symbols with matching name part, so
+			 * only "@LIB_VER" part is left to check
+			 */
+			if (lib_ver && dynsym &&
+			    (!ent->vername_off || strcmp(idx->strs + ent->vername_off, lib_ver) != 0))
+				continue;
+			if (lib_ver && !dynsym && strcmp(idx->strs + ent->name_off, name) != 0)
+				continue;
+
+			cur_bind = ent->bind;
+
+			if (found && ret > 0) {
+				/* handle multiple matches */
+				if (ent->offset == ret) {
+					/* same offset, no problem */
+					continue;
+				} else if (last_bind != STB_WEAK && cur_bind != STB_WEAK) {
+					/* Only accept one non-weak bind. */
+					pr_warn("elf: ambiguous match for '%s', '%s' in '%s'\n",
+						idx->strs + ent->name_off, name, binary_path);
+					return -LIBBPF_ERRNO__FORMAT;
+				} else if (cur_bind == STB_WEAK) {
+					/* already have a non-weak bind, and
+					 * this is a weak bind, so ignore.
+					 */
+					continue;
+				}
+			}
+
+			ret = ent->offset;
+			last_bind = cur_bind;
+			found = true;
+		}
+	}
+
+	if (found && ret > 0) {
+		pr_debug("elf: symbol address match for '%s' in '%s': 0x%lx\n", name, binary_path,
+			 ret);
+	} else if (found) {
+		pr_warn("elf: '%s' is 0 in symtab for '%s': %s\n", name, binary_path,
+			idx->e_type == ET_DYN ? "should not be 0 in a shared library" :
+						"try using shared library path instead");
+		ret = -ENOENT;
+	} else {
+		pr_warn("elf: failed to find symbol '%s' in '%s'\n", name, binary_path);
+		ret = -ENOENT;
+	}
+	return ret;
+}
 
-static int symbol_cmp(const void *a, const void *b)
+/* Find offset of function name in ELF object specified by path. "name" matches
+ * symbol name or name@@LIB for library functions.
+ */
+long elf_find_func_offset_from_file(const char *binary_path, const char *name)
 {
-	const struct symbol *sym_a = a;
-	const struct symbol *sym_b = b;
+	struct elf_sym_index *idx;
+	long ret;
+
+	idx = elf_sym_index_get(binary_path, STT_FUNC);
+	if (IS_ERR(idx))
+		return PTR_ERR(idx);
 
-	return strcmp(sym_a->name, sym_b->name);
+	ret = elf_sym_index_find_func_offset(idx, binary_path, name);
+	elf_sym_index_put(idx);
+	return ret;
 }
 
 /*
@@ -408,80 +746,70 @@ int elf_resolve_syms_offsets(const char *binary_path, int cnt,
 			     const char **syms, unsigned long **poffsets,
 			     int st_type)
 {
-	int sh_types[2] = { SHT_DYNSYM, SHT_SYMTAB };
-	int err = 0, i, cnt_done = 0;
+	const struct elf_sym_ent *ent;
+	struct elf_sym_index *idx;
 	unsigned long *offsets;
-	struct symbol *symbols;
-	struct elf_fd elf_fd;
+	bool missing = false;
+	int err = 0, i, j;
+	long head;
 
-	err = elf_open(binary_path, &elf_fd);
-	if (err)
-		return err;
+	idx = elf_sym_index_get(binary_path, st_type);
+	if (IS_ERR(idx))
+		return PTR_ERR(idx);
 
 	offsets = calloc(cnt, sizeof(*offsets));
-	symbols = calloc(cnt, sizeof(*symbols));
-
-	if (!offsets || !symbols) {
+	if (!offsets) {
 		err = -ENOMEM;
 		goto out;
 	}
 
 	for (i = 0; i < cnt; i++) {
-		symbols[i].name = syms[i];
-		symbols[i].idx = i;
-	}
-
-	qsort(symbols, cnt, sizeof(*symbols), symbol_cmp);
-
-	for (i = 0; i < ARRAY_SIZE(sh_types); i++) {
-		struct elf_sym_iter iter;
-		struct elf_sym *sym;
+		unsigned long *offset = &offsets[i];
+		bool found = false;
+		int found_bind = 0;
 
-		err = elf_sym_iter_new(&iter, elf_fd.elf, binary_path, sh_types[i], st_type);
-		if (err == -ENOENT)
+		/* keep going, ambiguous matches take precedence over missing ones */
+		if (!hashmap__find(idx->by_name, syms[i], &head)) {
+			missing = true;
 			continue;
-		if (err)
-			goto out;
+		}
 
-		while ((sym = elf_sym_iter_next(&iter))) {
-			unsigned long sym_offset = elf_sym_offset(sym);
-			int bind = GELF_ST_BIND(sym->sym.st_info);
-			struct symbol *found, tmp = {
-				.name = sym->name,
-			};
-			unsigned long *offset;
-
-			found = bsearch(&tmp, symbols, cnt, sizeof(*symbols), symbol_cmp);
-			if (!found)
+		for (j = head; j >= 0; j = ent->next) {
+			const char *sym_name;
+
+			ent = &idx->syms[j];
+			sym_name = idx->strs + ent->name_off;
+			if (strcmp(sym_name, syms[i]) != 0)
 				continue;
 
-			offset = &offsets[found->idx];
 			if (*offset > 0) {
 				/* same offset, no problem */
-				if (*offset == sym_offset)
+				if (*offset == ent->offset)
 					continue;
 				/* handle multiple matches */
-				if (found->bind != STB_WEAK && bind != STB_WEAK) {
+				if (found_bind != STB_WEAK && ent->bind != STB_WEAK) {
 					/* Only accept one non-weak bind. */
 					pr_warn("elf: ambiguous match found '%s@%lu' in '%s' previous offset %lu\n",
-						sym->name, sym_offset, binary_path, *offset);
+						sym_name, ent->offset, binary_path, *offset);
 					err = -ESRCH;
 					goto out;
-				} else if (bind == STB_WEAK) {
+				} else if (ent->bind == STB_WEAK) {
 					/* already have a non-weak bind, and
 					 * this is a weak bind, so ignore.
 					 */
 					continue;
 				}
-			} else {
-				cnt_done++;
 			}
-			*offset = sym_offset;
-			found->bind = bind;
+			*offset = ent->offset;
+			found_bind = ent->bind;
+			found = true;
 		}
+
+		if (!found)
+			missing = true;
 	}
 
-	if (cnt != cnt_done) {
+	if (missing) {
 		err = -ENOENT;
 		goto out;
 	}
@@ -489,10 +817,9 @@ int elf_resolve_syms_offsets(const char *binary_path, int cnt,
 	*poffsets = offsets;
 
 out:
-	free(symbols);
 	if (err)
 		free(offsets);
-	elf_close(&elf_fd);
+	elf_sym_index_put(idx);
 	return err;
 }
 
@@ -504,28 +831,25 @@ out:
 int elf_resolve_pattern_offsets(const char *binary_path, const char *pattern,
 				unsigned long **poffsets, size_t *pcnt)
 {
-	int sh_types[2] = { SHT_SYMTAB, SHT_DYNSYM };
 	unsigned long *offsets = NULL;
-	size_t cap = 0, cnt = 0;
-	struct elf_fd elf_fd;
+	size_t cap = 0, cnt = 0, j;
+	struct elf_sym_index *idx;
 	int err = 0, i;
 
-	err = elf_open(binary_path, &elf_fd);
-	if (err)
-		return err;
+	idx = elf_sym_index_get(binary_path, STT_FUNC);
+	if (IS_ERR(idx))
+		return PTR_ERR(idx);
 
-	for (i = 0; i < ARRAY_SIZE(sh_types); i++) {
-		struct elf_sym_iter iter;
-		struct elf_sym *sym;
+	/* SHT_SYMTAB symbols first, then SHT_DYNSYM ones */
+	for (i = 0; i < 2; i++) {
+		bool dynsym = i == 1;
 
-		err = elf_sym_iter_new(&iter, elf_fd.elf, binary_path, sh_types[i], STT_FUNC);
-		if (err == -ENOENT)
-			continue;
-		if (err)
-			goto out;
+		for (j = 0; j < idx->sym_cnt; j++) {
+			const struct elf_sym_ent *ent = &idx->syms[j];
 
-		while ((sym = elf_sym_iter_next(&iter))) {
-			if (!glob_match(sym->name, pattern))
+			if (ent->dynsym != dynsym)
+				continue;
+			if (!glob_match(idx->strs + ent->name_off, pattern))
 				continue;
 
 			err = libbpf_ensure_mem((void **) &offsets, &cap, sizeof(*offsets),
@@ -533,7 +857,7 @@ int elf_resolve_pattern_offsets(const char *binary_path, const char *pattern,
 			if (err)
 				goto out;
 
-			offsets[cnt++] = elf_sym_offset(sym);
+			offsets[cnt++] = ent->offset;
 		}
 
 		/* If we found anything in the first symbol section,
@@ -553,6 +877,6 @@ int elf_resolve_pattern_offsets(const char *binary_path, const char *pattern,
 out:
 	if (err)
 		free(offsets);
-	elf_close(&elf_fd);
+	elf_sym_index_put(idx);
 	return err;
 }
@@ -204,6 +204,18 @@ static int probe_kern_array_mmap(int token_fd)
 	return probe_fd(fd);
 }
 
+static int probe_kern_ringbuf(int token_fd)
+{
+	LIBBPF_OPTS(bpf_map_create_opts, opts,
+		.map_flags = token_fd ? BPF_F_TOKEN_FD : 0,
+		.token_fd = token_fd,
+	);
+	int fd;
+
+	fd = bpf_map_create(BPF_MAP_TYPE_RINGBUF, "libbpf_rb", 0, 0, getpagesize(), &opts);
+	return probe_fd(fd);
+}
+
 static int probe_kern_exp_attach_type(int token_fd)
 {
 	LIBBPF_OPTS(bpf_prog_load_opts, opts,
@@ -534,6 +546,9 @@ static struct kern_feature_desc {
 	[FEAT_ARG_CTX_TAG] = {
 		"kernel-side __arg_ctx tag", probe_kern_arg_ctx_tag,
 	},
+	[FEAT_RINGBUF] = {
+		"BPF ring buffer", probe_kern_ringbuf,
+	},
 };
 
 bool feat_supported(struct kern_feature_cache *cache, enum kern_feature_id feat_id)
@@ -21,6 +21,7 @@
 /* start with 4 buckets */
 #define HASHMAP_MIN_CAP_BITS 2
 
+#ifndef LIBBPF_HASHMAP_OPEN_ADDRESSING
 static void hashmap_add_entry(struct hashmap_entry **pprev,
 			      struct hashmap_entry *entry)
 {
@@ -34,6 +35,7 @@ static void hashmap_del_entry(struct hashmap_entry **pprev,
 	*pprev = entry->next;
 	entry->next = NULL;
 }
+#endif
 
 void hashmap__init(struct hashmap *map, hashmap_hash_fn hash_fn,
 		   hashmap_equal_fn equal_fn, void *ctx)
@@ -42,7 +44,13 @@ void hashmap__init(struct hashmap *map, hashmap_hash_fn hash_fn,
 	map->equal_fn = equal_fn;
 	map->ctx = ctx;
 
+#ifdef LIBBPF_HASHMAP_OPEN_ADDRESSING
+	map->entries = NULL;
+	map->ctrl = NULL;
+	map->deleted = 0;
+#else
 	map->buckets = NULL;
+#endif
 	map->cap = 0;
 	map->cap_bits = 0;
 	map->sz = 0;
@@ -62,6 +70,13 @@ struct hashmap *hashmap__new(hashmap_hash_fn hash_fn,
 
 void hashmap__clear(struct hashmap *map)
 {
+#ifdef LIBBPF_HASHMAP_OPEN_ADDRESSING
+	free(map->entries);
+	free(map->ctrl);
+	map->entries = NULL;
+	map->ctrl = NULL;
+	map->deleted = 0;
+#else
 	struct hashmap_entry *cur, *tmp;
 	size_t bkt;
 
@@ -70,6 +85,7 @@ void hashmap__clear(struct hashmap *map)
 	}
 	free(map->buckets);
 	map->buckets = NULL;
+#endif
 	map->cap = map->cap_bits = map->sz = 0;
 }
 
@@ -92,6 +108,182 @@ size_t hashmap__capacity(const struct hashmap *map)
 	return map->cap;
 }
 
+#ifdef LIBBPF_HASHMAP_OPEN_ADDRESSING
+
+static unsigned char hashmap_tag(size_t h)
+{
+	/* low bits, hash_bits() picks the bucket from the high ones */
+	return HASHMAP_SLOT_FULL | (h & 0x7f);
+}
+
+static bool hashmap_needs_to_grow(struct hashmap *map)
+{
+	/* grow if empty or more than 62.5% filled, tombstones included;
+	 * linear probe chains get long quickly past that
+	 */
+	return (map->cap == 0) || ((map->sz + map->deleted + 1) * 8 / 5 > map->cap);
+}
+
+static int hashmap_grow(struct hashmap *map)
+{
+	struct hashmap_entry *new_entries;
+	size_t new_cap_bits, new_cap;
+	unsigned char *new_ctrl;
+	size_t h, bkt, i;
+
+	/* mostly tombstones: rehashing at the same size is enough */
+	new_cap_bits = map->cap_bits;
+	if ((map->sz + 1) * 2 > map->cap)
+		new_cap_bits++;
+	if (new_cap_bits < HASHMAP_MIN_CAP_BITS)
+		new_cap_bits = HASHMAP_MIN_CAP_BITS;
+
+	new_cap = 1UL << new_cap_bits;
+	new_entries = malloc(new_cap * sizeof(new_entries[0]));
+	new_ctrl = calloc(new_cap, sizeof(new_ctrl[0]));
+	if (!new_entries || !new_ctrl) {
+		free(new_entries);
+		free(new_ctrl);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < map->cap; i++) {
+		if (!hashmap_slot_full(map, i))
+			continue;
+		h = map->hash_fn(map->entries[i].key, map->ctx);
+		bkt = hash_bits(h, new_cap_bits);
+		while (new_ctrl[bkt] != HASHMAP_SLOT_EMPTY)
+			bkt = (bkt + 1) & (new_cap - 1);
+		new_ctrl[bkt] = map->ctrl[i];
+		new_entries[bkt] = map->entries[i];
+	}
+
+	free(map->entries);
+	free(map->ctrl);
+	map->entries = new_entries;
+	map->ctrl = new_ctrl;
+	map->cap = new_cap;
+	map->cap_bits = new_cap_bits;
+	map->deleted = 0;
+
+	return 0;
+}
+
+static bool hashmap_find_slot(const struct hashmap *map, long key, size_t h, size_t *slot)
+{
+	unsigned char tag = hashmap_tag(h);
+	size_t bkt;
+
+	if (!map->cap)
+		return false;
+
+	for (bkt = hash_bits(h, map->cap_bits);
+	     map->ctrl[bkt] != HASHMAP_SLOT_EMPTY;
+	     bkt = (bkt + 1) & (map->cap - 1)) {
+		if (map->ctrl[bkt] == tag && map->equal_fn(map->entries[bkt].key, key, map->ctx)) {
+			*slot = bkt;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int hashmap_insert(struct hashmap *map, long key, long value,
+		   enum hashmap_insert_strategy strategy,
+		   long *old_key, long *old_value)
+{
+	struct hashmap_entry *entry;
+	size_t h, bkt;
+	int err;
+
+	if (old_key)
+		*old_key = 0;
+	if (old_value)
+		*old_value = 0;
+
+	h = map->hash_fn(key, map->ctx);
+	if (strategy != HASHMAP_APPEND &&
+	    hashmap_find_slot(map, key, h, &bkt)) {
+		entry = &map->entries[bkt];
+		if (old_key)
+			*old_key = entry->key;
+		if (old_value)
+			*old_value = entry->value;
+
+		if (strategy == HASHMAP_SET || strategy == HASHMAP_UPDATE) {
+			entry->key = key;
+			entry->value = value;
+			return 0;
+		} else if (strategy == HASHMAP_ADD) {
+			return -EEXIST;
+		}
+	}
+
+	if (strategy == HASHMAP_UPDATE)
+		return -ENOENT;
+
+	if (hashmap_needs_to_grow(map)) {
+		err = hashmap_grow(map);
+		if (err)
+			return err;
+	}
+
+	/* first free slot, reusing tombstones */
+	bkt = hash_bits(h, map->cap_bits);
+	while (hashmap_slot_full(map, bkt))
+		bkt = (bkt + 1) & (map->cap - 1);
+	if (map->ctrl[bkt] == HASHMAP_SLOT_DELETED)
+		map->deleted--;
+
+	map->ctrl[bkt] = hashmap_tag(h);
+	map->entries[bkt].key = key;
+	map->entries[bkt].value = value;
+	map->sz++;
+
+	return 0;
+}
+
+bool hashmap_find(const struct hashmap *map, long key, long *value)
+{
+	size_t bkt;
+
+	if (!hashmap_find_slot(map, key, map->hash_fn(key, map->ctx), &bkt))
+		return false;
+
+	if (value)
+		*value = map->entries[bkt].value;
+	return true;
+}
+
+bool hashmap_delete(struct hashmap *map, long key,
+		    long *old_key, long *old_value)
+{
+	size_t bkt;
+
+	if (!hashmap_find_slot(map, key, map->hash_fn(key, map->ctx), &bkt))
+		return false;
+
+	if (old_key)
+		*old_key = map->entries[bkt].key;
+	if (old_value)
+		*old_value = map->entries[bkt].value;
+
+	/* the entry itself stays intact for iterators still pointing at it */
+	if (map->ctrl[(bkt + 1) & (map->cap - 1)] == HASHMAP_SLOT_EMPTY) {
+		/* end of a probe chain, no tombstone needed */
+		map->ctrl[bkt] = HASHMAP_SLOT_EMPTY;
+	} else {
+		map->ctrl[bkt] = HASHMAP_SLOT_DELETED;
+		map->deleted++;
+	}
+	map->sz--;
+
+	return true;
+}
+
+#else /* !LIBBPF_HASHMAP_OPEN_ADDRESSING */
+
 static bool hashmap_needs_to_grow(struct hashmap *map)
 {
 	/* grow if empty or more than 75% filled */
@@ -238,3 +430,5 @@ bool hashmap_delete(struct hashmap *map, long key,
 
 	return true;
 }
+
+#endif /* LIBBPF_HASHMAP_OPEN_ADDRESSING */
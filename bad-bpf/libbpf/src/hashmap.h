@@ -66,9 +66,38 @@ struct hashmap_entry {
 		long value;
 		void *pvalue;
 	};
+#ifndef LIBBPF_HASHMAP_OPEN_ADDRESSING
 	struct hashmap_entry *next;
+#endif
 };
 
+#ifdef LIBBPF_HASHMAP_OPEN_ADDRESSING
+/*
+ * Open addressing variant (build with HASHMAP=open): entries live inline in
+ * one array probed linearly, so inserts don't allocate and lookups touch
+ * few cache lines. Each slot has a control byte: empty, deleted, or 0x80
+ * plus 7 bits of the key's hash, compared before calling equal_fn.
+ * Deletion leaves a tombstone, which keeps entries in place and iteration
+ * safe against removals.
+ */
+#define HASHMAP_SLOT_EMPTY	0x00
+#define HASHMAP_SLOT_DELETED	0x01
+#define HASHMAP_SLOT_FULL	0x80
+
+struct hashmap {
+	hashmap_hash_fn hash_fn;
+	hashmap_equal_fn equal_fn;
+	void *ctx;
+
+	struct hashmap_entry *entries;
+	unsigned char *ctrl;
+	size_t cap;
+	size_t cap_bits;
+	size_t sz;
+	/* tombstones, they count against the load factor */
+	size_t deleted;
+};
+#else
 struct hashmap {
 	hashmap_hash_fn hash_fn;
 	hashmap_equal_fn equal_fn;
@@ -79,6 +108,7 @@ struct hashmap {
 	size_t cap_bits;
 	size_t sz;
 };
+#endif
 
 void hashmap__init(struct hashmap *map, hashmap_hash_fn hash_fn,
 		   hashmap_equal_fn equal_fn, void *ctx);
@@ -103,7 +133,7 @@ size_t hashmap__capacity(const struct hashmap *map);
  *   associated with the same key. Most useful read API for such hashmap is
  *   hashmap__for_each_key_entry() iteration. If hashmap__find() is still
  *   used, it will return last inserted key/value entry (first in a bucket
- *   chain).
+ *   chain); with the open addressing variant it returns any one of them.
  */
 enum hashmap_insert_strategy {
 	HASHMAP_ADD,
@@ -159,6 +189,78 @@ bool hashmap_find(const struct hashmap *map, long key, long *value);
 #define hashmap__find(map, key, value) \
 	hashmap_find((map), (long)(key), hashmap_cast_ptr(value))
 
+#ifdef LIBBPF_HASHMAP_OPEN_ADDRESSING
+
+static inline bool hashmap_slot_full(const struct hashmap *map, size_t bkt)
+{
+	return map->ctrl[bkt] & HASHMAP_SLOT_FULL;
+}
+
+/* first slot of the probe sequence of key, NULL if it ends right away */
+static inline struct hashmap_entry *hashmap_probe_first(const struct hashmap *map, long key)
+{
+	size_t bkt;
+
+	if (!map->cap)
+		return NULL;
+	bkt = hash_bits(map->hash_fn(key, map->ctx), map->cap_bits);
+	return map->ctrl[bkt] == HASHMAP_SLOT_EMPTY ? NULL : &map->entries[bkt];
+}
+
+static inline struct hashmap_entry *hashmap_probe_next(const struct hashmap *map,
+						       const struct hashmap_entry *cur)
+{
+	size_t bkt = (cur - map->entries + 1) & (map->cap - 1);
+
+	return map->ctrl[bkt] == HASHMAP_SLOT_EMPTY ? NULL : &map->entries[bkt];
+}
+
+/*
+ * hashmap__for_each_entry - iterate over all entries in hashmap
+ * @map: hashmap to iterate
+ * @cur: struct hashmap_entry * used as a loop cursor
+ * @bkt: integer used as a bucket loop cursor
+ */
+#define hashmap__for_each_entry(map, cur, bkt)				    \
+	for (bkt = 0; bkt < map->cap; bkt++)				    \
+		if (!hashmap_slot_full(map, bkt)) {} else		    \
+		if ((cur = &map->entries[bkt]), false) {} else
+
+/*
+ * hashmap__for_each_entry_safe - iterate over all entries in hashmap, safe
+ * against removals
+ * @map: hashmap to iterate
+ * @cur: struct hashmap_entry * used as a loop cursor
+ * @tmp: unused, kept for compatibility with the chained variant
+ * @bkt: integer used as a bucket loop cursor
+ */
+#define hashmap__for_each_entry_safe(map, cur, tmp, bkt)		    \
+	for (bkt = 0; bkt < map->cap; bkt++)				    \
+		if (!hashmap_slot_full(map, bkt)) {} else		    \
+		if ((cur = tmp = &map->entries[bkt]), (void)tmp, false) {} else
+
+/*
+ * hashmap__for_each_key_entry - iterate over entries associated with given key
+ * @map: hashmap to iterate
+ * @cur: struct hashmap_entry * used as a loop cursor
+ * @key: key to iterate entries for
+ */
+#define hashmap__for_each_key_entry(map, cur, _key)			    \
+	for (cur = hashmap_probe_first(map, (_key));			    \
+	     cur;							    \
+	     cur = hashmap_probe_next(map, cur))			    \
+		if (hashmap_slot_full(map, cur - map->entries) &&	    \
+		    map->equal_fn(cur->key, (_key), map->ctx))
+
+#define hashmap__for_each_key_entry_safe(map, cur, tmp, _key)		    \
+	for (cur = hashmap_probe_first(map, (_key));			    \
+	     cur && ({ tmp = cur; (void)tmp; true; });			    \
+	     cur = hashmap_probe_next(map, cur))			    \
+		if (hashmap_slot_full(map, cur - map->entries) &&	    \
+		    map->equal_fn(cur->key, (_key), map->ctx))
+
+#else /* !LIBBPF_HASHMAP_OPEN_ADDRESSING */
+
 /*
  * hashmap__for_each_entry - iterate over all entries in hashmap
  * @map: hashmap to iterate
@@ -205,4 +307,6 @@ bool hashmap_find(const struct hashmap *map, long key, long *value);
 	     cur = tmp)							    \
 		if (map->equal_fn(cur->key, (_key), map->ctx))
 
+#endif /* LIBBPF_HASHMAP_OPEN_ADDRESSING */
+
 #endif /* __LIBBPF_HASHMAP_H */
@@ -43,6 +43,7 @@
 #include <sys/vfs.h>
 #include <sys/utsname.h>
 #include <sys/resource.h>
+#include <pthread.h>
 #include <libelf.h>
 #include <gelf.h>
 #include <zlib.h>
@@ -643,6 +644,27 @@ struct elf_state {
 
 struct usdt_manager;
 
+/* One resolved CO-RE relocation, identified by its .BTF.ext position */
+struct core_cache_rec {
+	__u32 sec_num;
+	__u32 relo_idx;
+	struct bpf_core_relo_res res;
+};
+
+/* Persistent CO-RE relocation cache of a bpf_object being loaded */
+struct core_cache {
+	__u64 key;
+	struct core_cache_rec *recs;
+	size_t rec_cnt;
+	size_t rec_cap;
+	/* (sec_num, relo_idx) -> index into recs */
+	struct hashmap *idx;
+	/* recs came from a valid cache file */
+	bool from_disk;
+	/* recs has entries the cache file doesn't */
+	bool dirty;
+};
+
 struct bpf_object {
 	char name[BPF_OBJ_NAME_LEN];
 	char license[64];
@@ -668,6 +690,16 @@ struct bpf_object {
 	/* Information when doing ELF related work. Only valid if efile.elf is not NULL */
 	struct elf_state efile;
 
+	/* Private copy-on-write mapping of the object file. Unlike efile, it
+	 * stays around after open, as btf and btf_ext point into it, until
+	 * bpf_object__unmap_file() at the end of load. [file_view_start,
+	 * file_view_end) is the part btf and btf_ext were parsed from.
+	 */
+	void *file_map;
+	size_t file_map_sz;
+	size_t file_view_start;
+	size_t file_view_end;
+
 	struct btf *btf;
 	struct btf_ext *btf_ext;
 
@@ -681,6 +713,12 @@ struct bpf_object {
 	char *btf_custom_path;
 	/* vmlinux BTF override for CO-RE relocations */
 	struct btf *btf_vmlinux_override;
+	/* Directory of the persistent CO-RE relocation cache */
+	char *core_cache_dir;
+	/* Max number of threads verifying programs concurrently */
+	__u32 prog_load_threads;
+	/* CO-RE relocation results loaded from/to be saved to the cache */
+	struct core_cache *core_cache;
 	/* Lazily initialized kernel module BTFs */
 	struct module_btf *btf_modules;
 	bool btf_modules_loaded;
@@ -1343,6 +1381,83 @@ static void bpf_object__elf_finish(struct bpf_object *obj)
 	obj->efile.obj_buf_sz = 0;
 }
 
+/*
+ * Maps the object file for the lifetime of obj, so that section data,
+ * including .BTF and .BTF.ext, is used where it lies rather than copied to
+ * the heap. The mapping is private and writable: the few pages libbpf
+ * patches in place (BTF fixups) get copied on write, the rest stay shared
+ * with the page cache. Not fatal if it fails, libelf reads the file then.
+ */
+static void bpf_object__map_file(struct bpf_object *obj)
+{
+	struct stat st;
+	void *map;
+
+	if (fstat(obj->efile.fd, &st) || !S_ISREG(st.st_mode) || st.st_size == 0)
+		return;
+
+	map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, obj->efile.fd, 0);
+	if (map == MAP_FAILED)
+		return;
+
+	obj->file_map = map;
+	obj->file_map_sz = st.st_size;
+	obj->file_view_start = st.st_size;
+	obj->file_view_end = 0;
+}
+
+/*
+ * Detaches btf and btf_ext from the object file once load is done, so that
+ * a loaded object doesn't depend on the file for the rest of its lifetime
+ * (a truncated file would raise SIGBUS, a rewritten one change the data
+ * under it). The pages they were parsed from are replaced by an anonymous
+ * copy at the same address, as pointers into them have been handed out;
+ * the rest of the file is unmapped. If that fails, the mapping stays.
+ */
+static void bpf_object__unmap_file(struct bpf_object *obj)
+{
+	size_t page_sz = sysconf(_SC_PAGE_SIZE), start, end, map_end;
+	void *map = obj->file_map, *copy;
+
+	if (!map)
+		return;
+
+	map_end = roundup(obj->file_map_sz, page_sz);
+	if (obj->file_view_start >= obj->file_view_end) {
+		munmap(map, map_end);
+		obj->file_map = NULL;
+		obj->file_map_sz = 0;
+		return;
+	}
+
+	start = obj->file_view_start / page_sz * page_sz;
+	end = roundup(obj->file_view_end, page_sz);
+	copy = mmap(NULL, end - start, PROT_READ | PROT_WRITE,
+		    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (copy == MAP_FAILED) {
+		pr_debug("object '%s': failed to copy BTF out of the file: %d\n",
+			 obj->name, -errno);
+		return;
+	}
+	memcpy(copy, map + start, end - start);
+	if (mremap(copy, end - start, end - start, MREMAP_MAYMOVE | MREMAP_FIXED,
+		   map + start) == MAP_FAILED) {
+		pr_debug("object '%s': failed to copy BTF out of the file: %d\n",
+			 obj->name, -errno);
+		munmap(copy, end - start);
+		return;
+	}
+
+	if (start)
+		munmap(map, start);
+	if (end < map_end)
+		munmap(map + end, map_end - end);
+	obj->file_map = map + start;
+	obj->file_map_sz = end - start;
+	obj->file_view_start -= start;
+	obj->file_view_end -= start;
+}
+
 static int bpf_object__elf_init(struct bpf_object *obj)
 {
 	Elf64_Ehdr *ehdr;
@@ -1368,7 +1483,11 @@ static int bpf_object__elf_init(struct bpf_object *obj)
 			return err;
 		}
 
-		elf = elf_begin(obj->efile.fd, ELF_C_READ_MMAP, NULL);
+		bpf_object__map_file(obj);
+		if (obj->file_map)
+			elf = elf_memory(obj->file_map, obj->file_map_sz);
+		else
+			elf = elf_begin(obj->efile.fd, ELF_C_READ_MMAP, NULL);
 	}
 
 	if (!elf) {
@@ -2889,6 +3008,29 @@ static bool kernel_needs_btf(const struct bpf_object *obj)
 	return obj->efile.st_ops_shndx >= 0 || obj->efile.st_ops_link_shndx >= 0;
 }
 
+/*
+ * Whether section data can be parsed in place: it has to live in the file
+ * mapping (libelf hands out copies for, e.g., compressed sections) and be
+ * aligned for direct access.
+ */
+static bool obj_data_in_file_map(const struct bpf_object *obj, const Elf_Data *data)
+{
+	const char *buf = data->d_buf;
+	const char *map = obj->file_map;
+
+	return map && buf >= map && buf + data->d_size <= map + obj->file_map_sz &&
+	       ((uintptr_t)buf % sizeof(__u32)) == 0;
+}
+
+/* Records that section data is used in place, see bpf_object__unmap_file() */
+static void obj_add_file_view(struct bpf_object *obj, const Elf_Data *data)
+{
+	size_t off = (const char *)data->d_buf - (const char *)obj->file_map;
+
+	obj->file_view_start = min(obj->file_view_start, off);
+	obj->file_view_end = max(obj->file_view_end, off + data->d_size);
+}
+
 static int bpf_object__init_btf(struct bpf_object *obj,
 				Elf_Data *btf_data,
 				Elf_Data *btf_ext_data)
@@ -2896,7 +3038,12 @@ static int bpf_object__init_btf(struct bpf_object *obj,
 	int err = -ENOENT;
 
 	if (btf_data) {
-		obj->btf = btf__new(btf_data->d_buf, btf_data->d_size);
+		if (obj_data_in_file_map(obj, btf_data)) {
+			obj->btf = btf_new_view(btf_data->d_buf, btf_data->d_size);
+			obj_add_file_view(obj, btf_data);
+		} else {
+			obj->btf = btf__new(btf_data->d_buf, btf_data->d_size);
+		}
 		err = libbpf_get_error(obj->btf);
 		if (err) {
 			obj->btf = NULL;
@@ -2915,7 +3062,12 @@ static int bpf_object__init_btf(struct bpf_object *obj,
 				 BTF_EXT_ELF_SEC, BTF_ELF_SEC);
 			goto out;
 		}
-		obj->btf_ext = btf_ext__new(btf_ext_data->d_buf, btf_ext_data->d_size);
+		if (obj_data_in_file_map(obj, btf_ext_data)) {
+			obj->btf_ext = btf_ext_new_view(btf_ext_data->d_buf, btf_ext_data->d_size);
+			obj_add_file_view(obj, btf_ext_data);
+		} else {
+			obj->btf_ext = btf_ext__new(btf_ext_data->d_buf, btf_ext_data->d_size);
+		}
 		err = libbpf_get_error(obj->btf_ext);
 		if (err) {
 			pr_warn("Error loading ELF section %s: %d. Ignored and continue.\n",
@@ -3125,7 +3277,8 @@ static bool obj_needs_vmlinux_btf(const struct bpf_object *obj)
 	/* CO-RE relocations need kernel BTF, only when btf_custom_path
 	 * is not specified
 	 */
-	if (obj->btf_ext && obj->btf_ext->core_relo_info.len && !obj->btf_custom_path)
+	if (obj->btf_ext && obj->btf_ext->core_relo_info.len && !obj->btf_custom_path &&
+	    !(obj->core_cache && obj->core_cache->from_disk))
 		return true;
 
 	/* Support for typed ksyms needs kernel BTF */
@@ -3152,6 +3305,138 @@ static bool obj_needs_vmlinux_btf(const struct bpf_object *obj)
 	return false;
 }
 
+struct shared_module_btf {
+	struct btf *btf;
+	__u32 id;
+};
+
+/*
+ * Kernel BTF is parsed once per process and shared read-only by every
+ * bpf_object; module BTFs are split on top of it and live as long as it
+ * does.
+ */
+static struct btf *shared_vmlinux_btf;
+static int shared_vmlinux_refcnt;
+/* references held by libbpf_vmlinux_btf_prewarm(), part of the above */
+static int shared_vmlinux_prewarm_cnt;
+static struct shared_module_btf *shared_module_btfs;
+static size_t shared_module_btf_cnt;
+static size_t shared_module_btf_cap;
+static pthread_mutex_t shared_btf_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct btf *vmlinux_btf_get(void)
+{
+	struct btf *btf;
+	int err;
+
+	pthread_mutex_lock(&shared_btf_lock);
+	if (!shared_vmlinux_btf) {
+		btf = btf__load_vmlinux_btf();
+		err = libbpf_get_error(btf);
+		if (err) {
+			pthread_mutex_unlock(&shared_btf_lock);
+			return ERR_PTR(err);
+		}
+		shared_vmlinux_btf = btf;
+	}
+	shared_vmlinux_refcnt++;
+	btf = shared_vmlinux_btf;
+	pthread_mutex_unlock(&shared_btf_lock);
+
+	return btf;
+}
+
+static void vmlinux_btf_put(struct btf *btf)
+{
+	size_t i;
+
+	if (!btf)
+		return;
+
+	pthread_mutex_lock(&shared_btf_lock);
+	if (--shared_vmlinux_refcnt > 0) {
+		pthread_mutex_unlock(&shared_btf_lock);
+		return;
+	}
+
+	for (i = 0; i < shared_module_btf_cnt; i++)
+		btf__free(shared_module_btfs[i].btf);
+	zfree(&shared_module_btfs);
+	shared_module_btf_cnt = 0;
+	shared_module_btf_cap = 0;
+	btf__free(shared_vmlinux_btf);
+	shared_vmlinux_btf = NULL;
+	pthread_mutex_unlock(&shared_btf_lock);
+}
+
+/* Caller must hold a vmlinux_btf_get() reference, which owns the result */
+static struct btf *module_btf_get(__u32 id, int fd)
+{
+	struct shared_module_btf *mod;
+	struct btf *btf;
+	size_t i;
+	int err;
+
+	pthread_mutex_lock(&shared_btf_lock);
+	for (i = 0; i < shared_module_btf_cnt; i++) {
+		if (shared_module_btfs[i].id == id) {
+			btf = shared_module_btfs[i].btf;
+			goto out;
+		}
+	}
+
+	btf = btf_get_from_fd(fd, shared_vmlinux_btf);
+	err = libbpf_get_error(btf);
+	if (!err) {
+		mod = libbpf_add_mem((void **)&shared_module_btfs, &shared_module_btf_cap,
+				     sizeof(*shared_module_btfs), shared_module_btf_cnt,
+				     SIZE_MAX, 1);
+		err = mod ? 0 : -ENOMEM;
+	}
+	if (err) {
+		if (!IS_ERR(btf))
+			btf__free(btf);
+		btf = ERR_PTR(err);
+		goto out;
+	}
+	mod->btf = btf;
+	mod->id = id;
+	shared_module_btf_cnt++;
+out:
+	pthread_mutex_unlock(&shared_btf_lock);
+	return btf;
+}
+
+int libbpf_vmlinux_btf_prewarm(void)
+{
+	struct btf *btf;
+	int err;
+
+	btf = vmlinux_btf_get();
+	err = libbpf_get_error(btf);
+	if (err)
+		return libbpf_err(err);
+
+	pthread_mutex_lock(&shared_btf_lock);
+	shared_vmlinux_prewarm_cnt++;
+	pthread_mutex_unlock(&shared_btf_lock);
+	return 0;
+}
+
+void libbpf_vmlinux_btf_release(void)
+{
+	struct btf *btf = NULL;
+
+	/* only ever drop a prewarm reference, never one of a BPF object */
+	pthread_mutex_lock(&shared_btf_lock);
+	if (shared_vmlinux_prewarm_cnt > 0) {
+		shared_vmlinux_prewarm_cnt--;
+		btf = shared_vmlinux_btf;
+	}
+	pthread_mutex_unlock(&shared_btf_lock);
+	vmlinux_btf_put(btf);
+}
+
 static int bpf_object__load_vmlinux_btf(struct bpf_object *obj, bool force)
 {
 	int err;
@@ -3163,7 +3448,7 @@ static int bpf_object__load_vmlinux_btf(struct bpf_object *obj, bool force)
 	if (!force && !obj_needs_vmlinux_btf(obj))
 		return 0;
 
-	obj->btf_vmlinux = btf__load_vmlinux_btf();
+	obj->btf_vmlinux = vmlinux_btf_get();
 	err = libbpf_get_error(obj->btf_vmlinux);
 	if (err) {
 		pr_warn("Error loading vmlinux BTF: %d\n", err);
@@ -5273,7 +5558,13 @@ static int load_module_btfs(struct bpf_object *obj)
 			continue;
 		}
 
-		btf = btf_get_from_fd(fd, obj->btf_vmlinux);
+		if (!obj->btf_vmlinux) {
+			err = -ENOENT;
+			pr_warn("module [%s]'s BTF object #%d needs vmlinux BTF\n", name, id);
+			goto err_out;
+		}
+
+		btf = module_btf_get(id, fd);
 		err = libbpf_get_error(btf);
 		if (err) {
 			pr_warn("failed to load module [%s]'s BTF object #%d: %d\n",
@@ -5485,10 +5776,382 @@ static int bpf_core_resolve_relo(struct bpf_program *prog,
 				       targ_res);
 }
 
+#define CORE_CACHE_MAGIC 0x52434243 /* "CBCR" */
+#define CORE_CACHE_VERSION 1
+
+struct core_cache_hdr {
+	__u32 magic;
+	__u32 version;
+	__u64 key;
+	__u32 rec_cnt;
+	__u32 rec_sz;
+	__u32 csum;
+	__u32 pad;
+};
+
+static __u64 core_cache_hash(__u64 h, const void *data, size_t len)
+{
+	const unsigned char *p = data;
+	size_t i;
+
+	/* FNV-1a */
+	for (i = 0; i < len; i++) {
+		h ^= p[i];
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+static long core_cache_rec_key(__u32 sec_num, __u32 relo_idx)
+{
+	return (long)(((__u64)sec_num << 32) | relo_idx);
+}
+
+static void core_cache_free(struct core_cache *cache)
+{
+	if (!cache)
+		return;
+	hashmap__free(cache->idx);
+	free(cache->recs);
+	free(cache);
+}
+
+static int core_cache_add(struct core_cache *cache, __u32 sec_num, __u32 relo_idx,
+			  const struct bpf_core_relo_res *res)
+{
+	struct core_cache_rec *rec;
+	int err;
+
+	rec = libbpf_add_mem((void **)&cache->recs, &cache->rec_cap, sizeof(*cache->recs),
+			     cache->rec_cnt, INT_MAX, 1);
+	if (!rec)
+		return -ENOMEM;
+
+	/* zero padding, records are checksummed and written out raw */
+	memset(rec, 0, sizeof(*rec));
+	rec->sec_num = sec_num;
+	rec->relo_idx = relo_idx;
+	rec->res = *res;
+
+	err = hashmap__add(cache->idx, core_cache_rec_key(sec_num, relo_idx), cache->rec_cnt);
+	if (err)
+		return err;
+	cache->rec_cnt++;
+	return 0;
+}
+
+static const struct bpf_core_relo_res *
+core_cache_find(const struct core_cache *cache, __u32 sec_num, __u32 relo_idx)
+{
+	long i;
+
+	if (!hashmap__find(cache->idx, core_cache_rec_key(sec_num, relo_idx), &i))
+		return NULL;
+	return &cache->recs[i].res;
+}
+
+/* Module BTFs are candidates too. Names alone would miss a module that was
+ * rebuilt and reloaded under the same name, so hash each module's BTF
+ * object ID as well, which the kernel assigns anew on every load. Without
+ * the privileges to iterate them load_module_btfs() doesn't see any module
+ * BTFs either, so they don't contribute then.
+ */
+static int core_cache_mods_key(__u64 *key)
+{
+	struct bpf_btf_info info;
+	__u64 h = *key;
+	char name[64];
+	__u32 id = 0, len;
+	int err, fd;
+
+	while (true) {
+		err = bpf_btf_get_next_id(id, &id);
+		if (err && (errno == ENOENT || errno == EPERM))
+			break;
+		if (err)
+			return -errno;
+
+		fd = bpf_btf_get_fd_by_id(id);
+		if (fd < 0) {
+			if (errno == ENOENT)
+				continue; /* BTF was unloaded meanwhile */
+			return -errno;
+		}
+
+		len = sizeof(info);
+		memset(&info, 0, sizeof(info));
+		info.name = ptr_to_u64(name);
+		info.name_len = sizeof(name);
+		err = bpf_btf_get_info_by_fd(fd, &info, &len);
+		err = err ? -errno : 0;
+		close(fd);
+		if (err)
+			return err;
+
+		/* program BTFs come and go, vmlinux is covered by the build ID */
+		if (!info.kernel_btf || strcmp(name, "vmlinux") == 0)
+			continue;
+
+		h = core_cache_hash(h, name, strnlen(name, sizeof(name)));
+		h = core_cache_hash(h, &info.id, sizeof(info.id));
+	}
+
+	*key = h;
+	return 0;
+}
+
+/* Identity of the BTF that CO-RE relocations resolve against: the running
+ * kernel's build ID plus the loaded module BTFs, or the custom BTF file.
+ */
+static int core_cache_targ_key(const char *targ_btf_path, __u64 *key)
+{
+	__u64 h = *key;
+	char buf[4096];
+	struct utsname un;
+	struct stat st;
+	ssize_t n;
+	int fd;
+
+	if (targ_btf_path) {
+		if (stat(targ_btf_path, &st))
+			return -errno;
+		h = core_cache_hash(h, targ_btf_path, strlen(targ_btf_path));
+		h = core_cache_hash(h, &st.st_dev, sizeof(st.st_dev));
+		h = core_cache_hash(h, &st.st_ino, sizeof(st.st_ino));
+		h = core_cache_hash(h, &st.st_size, sizeof(st.st_size));
+		h = core_cache_hash(h, &st.st_mtim, sizeof(st.st_mtim));
+		*key = h;
+		return 0;
+	}
+
+	/* ELF notes of the running kernel, NT_GNU_BUILD_ID among them */
+	fd = open("/sys/kernel/notes", O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+	while ((n = read(fd, buf, sizeof(buf))) > 0)
+		h = core_cache_hash(h, buf, n);
+	close(fd);
+	if (n < 0)
+		return -errno;
+
+	if (uname(&un))
+		return -errno;
+	h = core_cache_hash(h, un.release, strlen(un.release));
+	h = core_cache_hash(h, un.version, strlen(un.version));
+
+	*key = h;
+	return core_cache_mods_key(key);
+}
+
+static int core_cache_path(const struct bpf_object *obj, char *buf, size_t buf_sz)
+{
+	int len;
+
+	len = snprintf(buf, buf_sz, "%s/%016llx.core", obj->core_cache_dir,
+		       (unsigned long long)obj->core_cache->key);
+	if (len < 0 || len >= buf_sz)
+		return -ENAMETOOLONG;
+	return 0;
+}
+
+/* Cached results are patched straight into instructions, so only entries
+ * the loading user wrote can be trusted: the directory must be theirs and
+ * closed to everyone else.
+ */
+static int core_cache_check_dir(const struct bpf_object *obj, bool warn)
+{
+	struct stat st;
+
+	if (stat(obj->core_cache_dir, &st))
+		return -errno;
+	if (!S_ISDIR(st.st_mode) || st.st_uid != geteuid() || (st.st_mode & 077)) {
+		if (warn)
+			pr_warn("object '%s': ignoring CO-RE cache dir '%s', it must be owned by the user with mode 0700\n",
+				obj->name, obj->core_cache_dir);
+		return -EPERM;
+	}
+	return 0;
+}
+
+static int core_cache_read(struct bpf_object *obj)
+{
+	struct core_cache *cache = obj->core_cache;
+	struct core_cache_rec *recs = NULL;
+	struct core_cache_hdr hdr;
+	char path[PATH_MAX];
+	struct stat st;
+	size_t i, sz;
+	int fd, err;
+
+	err = core_cache_path(obj, path, sizeof(path));
+	if (err)
+		return err;
+	fd = open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+	if (fd < 0)
+		return -errno;
+
+	err = -EPERM;
+	if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_uid != geteuid())
+		goto out;
+	err = -EINVAL;
+	if (read(fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+		goto out;
+	if (hdr.magic != CORE_CACHE_MAGIC || hdr.version != CORE_CACHE_VERSION ||
+	    hdr.key != cache->key || hdr.rec_sz != sizeof(*recs))
+		goto out;
+
+	sz = (size_t)hdr.rec_cnt * sizeof(*recs);
+	recs = malloc(sz ? : 1);
+	if (!recs) {
+		err = -ENOMEM;
+		goto out;
+	}
+	if (read(fd, recs, sz) != (ssize_t)sz)
+		goto out;
+	if (crc32(0, (const Bytef *)recs, sz) != hdr.csum)
+		goto out;
+
+	for (i = 0; i < hdr.rec_cnt; i++) {
+		err = core_cache_add(cache, recs[i].sec_num, recs[i].relo_idx, &recs[i].res);
+		if (err)
+			goto out;
+	}
+	cache->from_disk = true;
+	err = 0;
+out:
+	free(recs);
+	close(fd);
+	return err;
+}
+
+static int core_cache_write(struct bpf_object *obj)
+{
+	struct core_cache *cache = obj->core_cache;
+	struct core_cache_hdr hdr = {};
+	char path[PATH_MAX], tmp[PATH_MAX];
+	size_t sz;
+	int fd, err = 0;
+
+	err = core_cache_path(obj, path, sizeof(path));
+	if (err)
+		return err;
+	err = snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path);
+	if (err < 0 || err >= sizeof(tmp))
+		return -ENAMETOOLONG;
+	if (mkdir(obj->core_cache_dir, 0700) && errno != EEXIST)
+		return -errno;
+	err = core_cache_check_dir(obj, false);
+	if (err)
+		return err;
+	fd = mkstemp(tmp);
+	if (fd < 0)
+		return -errno;
+
+	sz = cache->rec_cnt * sizeof(*cache->recs);
+	hdr.magic = CORE_CACHE_MAGIC;
+	hdr.version = CORE_CACHE_VERSION;
+	hdr.key = cache->key;
+	hdr.rec_cnt = cache->rec_cnt;
+	hdr.rec_sz = sizeof(*cache->recs);
+	hdr.csum = crc32(0, (const Bytef *)cache->recs, sz);
+
+	if (write(fd, &hdr, sizeof(hdr)) != sizeof(hdr) ||
+	    write(fd, cache->recs, sz) != (ssize_t)sz)
+		err = -EIO;
+	if (close(fd) && !err)
+		err = -errno;
+	/* readers only ever see complete files */
+	if (!err && rename(tmp, path))
+		err = -errno;
+	if (err)
+		unlink(tmp);
+	return err;
+}
+
+/* Sets up obj->core_cache if the object was opened with core_cache_dir.
+ * Cache problems are never fatal, the object is then relocated as usual.
+ */
+static int bpf_object__open_core_cache(struct bpf_object *obj, const char *targ_btf_path)
+{
+	struct core_cache *cache;
+	const void *btf_data;
+	__u32 btf_sz;
+	__u64 key;
+	int err;
+
+	if (!obj->core_cache_dir || obj->gen_loader || obj->core_cache ||
+	    !obj->btf_ext || !obj->btf_ext->core_relo_info.len)
+		return 0;
+	/* a missing directory is created when the cache is written */
+	err = core_cache_check_dir(obj, true);
+	if (err && err != -ENOENT)
+		return 0;
+
+	key = core_cache_hash(0xcbf29ce484222325ULL, libbpf_version_string(),
+			      strlen(libbpf_version_string()));
+	btf_data = btf__raw_data(obj->btf, &btf_sz);
+	if (!btf_data)
+		return 0;
+	key = core_cache_hash(key, btf_data, btf_sz);
+	key = core_cache_hash(key, obj->btf_ext->data, obj->btf_ext->data_size);
+	err = core_cache_targ_key(targ_btf_path, &key);
+	if (err) {
+		pr_debug("object '%s': CO-RE cache disabled, can't identify target BTF: %d\n",
+			 obj->name, err);
+		return 0;
+	}
+
+	cache = calloc(1, sizeof(*cache));
+	if (!cache)
+		return 0;
+	cache->key = key;
+	cache->idx = hashmap__new(bpf_core_hash_fn, bpf_core_equal_fn, NULL);
+	if (IS_ERR(cache->idx)) {
+		cache->idx = NULL;
+		core_cache_free(cache);
+		return 0;
+	}
+	obj->core_cache = cache;
+
+	err = core_cache_read(obj);
+	if (err) {
+		/* start over, the file may have been partially applied */
+		hashmap__clear(cache->idx);
+		cache->rec_cnt = 0;
+		pr_debug("object '%s': no usable CO-RE cache entry %016llx: %d\n",
+			 obj->name, (unsigned long long)key, err);
+	} else {
+		pr_debug("object '%s': using %zu cached CO-RE relocations\n",
+			 obj->name, cache->rec_cnt);
+	}
+	return 0;
+}
+
+static int bpf_object__load_core_targ_btf(struct bpf_object *obj, const char *targ_btf_path)
+{
+	int err;
+
+	if (!targ_btf_path)
+		return bpf_object__load_vmlinux_btf(obj, true);
+	if (obj->btf_vmlinux_override)
+		return 0;
+
+	obj->btf_vmlinux_override = btf__parse(targ_btf_path, NULL);
+	err = libbpf_get_error(obj->btf_vmlinux_override);
+	if (err) {
+		pr_warn("failed to parse target BTF: %d\n", err);
+		obj->btf_vmlinux_override = NULL;
+		return err;
+	}
+	return 0;
+}
+
 static int
 bpf_object__relocate_core(struct bpf_object *obj, const char *targ_btf_path)
 {
 	const struct btf_ext_info_sec *sec;
+	const struct bpf_core_relo_res *cached_res;
+	struct core_cache *cache = obj->core_cache;
 	struct bpf_core_relo_res targ_res;
 	const struct bpf_core_relo *rec;
 	const struct btf_ext_info *seg;
@@ -5502,15 +6165,6 @@ bpf_object__relocate_core(struct bpf_object *obj, const char *targ_btf_path)
 	if (obj->btf_ext->core_relo_info.len == 0)
 		return 0;
 
-	if (targ_btf_path) {
-		obj->btf_vmlinux_override = btf__parse(targ_btf_path, NULL);
-		err = libbpf_get_error(obj->btf_vmlinux_override);
-		if (err) {
-			pr_warn("failed to parse target BTF: %d\n", err);
-			return err;
-		}
-	}
-
 	cand_cache = hashmap__new(bpf_core_hash_fn, bpf_core_equal_fn, NULL);
 	if (IS_ERR(cand_cache)) {
 		err = PTR_ERR(cand_cache);
@@ -5574,11 +6228,22 @@ bpf_object__relocate_core(struct bpf_object *obj, const char *targ_btf_path)
 			if (prog->obj->gen_loader)
 				continue;
 
-			err = bpf_core_resolve_relo(prog, rec, i, obj->btf, cand_cache, &targ_res);
-			if (err) {
-				pr_warn("prog '%s': relo #%d: failed to relocate: %d\n",
-					prog->name, i, err);
-				goto out;
+			cached_res = cache ? core_cache_find(cache, sec_num - 1, i) : NULL;
+			if (cached_res) {
+				targ_res = *cached_res;
+			} else {
+				/* target BTF is only parsed once a relocation misses the cache */
+				err = bpf_object__load_core_targ_btf(obj, targ_btf_path);
+				if (err)
+					goto out;
+				err = bpf_core_resolve_relo(prog, rec, i, obj->btf, cand_cache, &targ_res);
+				if (err) {
+					pr_warn("prog '%s': relo #%d: failed to relocate: %d\n",
+						prog->name, i, err);
+					goto out;
+				}
+				if (cache && !core_cache_add(cache, sec_num - 1, i, &targ_res))
+					cache->dirty = true;
 			}
 
 			err = bpf_core_patch_insn(prog->name, insn, insn_idx, rec, i, &targ_res);
@@ -5590,11 +6255,21 @@ bpf_object__relocate_core(struct bpf_object *obj, const char *targ_btf_path)
 		}
 	}
 
+	if (cache && cache->dirty) {
+		err = core_cache_write(obj);
+		if (err)
+			pr_debug("object '%s': failed to save CO-RE cache: %d\n", obj->name, err);
+		err = 0;
+	}
+
 out:
 	/* obj->btf_vmlinux and module BTFs are freed after object load */
 	btf__free(obj->btf_vmlinux_override);
 	obj->btf_vmlinux_override = NULL;
 
+	core_cache_free(obj->core_cache);
+	obj->core_cache = NULL;
+
 	if (!IS_ERR_OR_NULL(cand_cache)) {
 		hashmap__for_each_entry(cand_cache, entry, i) {
 			bpf_core_free_cands(entry->pvalue);
@@ -6636,6 +7311,42 @@ err_out:
 	return err;
 }
 
+/* bpf_event_output() emits bpf_ringbuf_output() whenever the kernel has ring
+ * buffers, so a program reading LINUX_HAS_RINGBUF must not write to a perf
+ * buffer libbpf left alone: the verifier would reject the helper call with
+ * a message that doesn't point at the missing map_extra.
+ */
+static int bpf_program_check_event_output(struct bpf_object *obj, struct bpf_program *prog)
+{
+	const struct bpf_map *perf_map = NULL;
+	bool has_ringbuf_ext = false;
+	int i;
+
+	if (!kernel_supports(obj, FEAT_RINGBUF))
+		return 0;
+
+	for (i = 0; i < prog->nr_reloc; i++) {
+		const struct reloc_desc *relo = &prog->reloc_desc[i];
+		const struct extern_desc *ext;
+
+		if (relo->type == RELO_EXTERN_LD64) {
+			ext = &obj->externs[relo->ext_idx];
+			if (ext->type == EXT_KCFG && strcmp(ext->name, "LINUX_HAS_RINGBUF") == 0)
+				has_ringbuf_ext = true;
+		} else if (relo->type == RELO_LD64 &&
+			   obj->maps[relo->map_idx].def.type == BPF_MAP_TYPE_PERF_EVENT_ARRAY) {
+			perf_map = &obj->maps[relo->map_idx];
+		}
+	}
+
+	if (has_ringbuf_ext && perf_map) {
+		pr_warn("prog '%s': bpf_event_output() needs map_extra set on perf buffer map '%s'\n",
+			prog->name, perf_map->name);
+		return -EINVAL;
+	}
+	return 0;
+}
+
 static int bpf_object__relocate(struct bpf_object *obj, const char *targ_btf_path)
 {
 	struct bpf_program *prog;
@@ -6724,6 +7435,10 @@ static int bpf_object__relocate(struct bpf_object *obj, const char *targ_btf_pat
 		if (!prog->autoload)
 			continue;
 
+		err = bpf_program_check_event_output(obj, prog);
+		if (err)
+			return err;
+
 		/* Process data relos for main programs */
 		err = bpf_object__relocate_data(obj, prog);
 		if (err) {
@@ -7033,18 +7748,17 @@ static int libbpf_prepare_prog_load(struct bpf_program *prog,
 
 static void fixup_verifier_log(struct bpf_program *prog, char *buf, size_t buf_sz);
 
-static int bpf_object_load_prog(struct bpf_object *obj, struct bpf_program *prog,
-				struct bpf_insn *insns, int insns_cnt,
-				const char *license, __u32 kern_version, int *prog_fd)
+/*
+ * Fills in BPF_PROG_LOAD attributes for prog. This can resolve attach
+ * targets, probe kernel features and run sec_def callbacks, all of which
+ * update shared object state, so it's always done from the loading thread.
+ */
+static int bpf_object_prepare_prog_load(struct bpf_object *obj, struct bpf_program *prog,
+					struct bpf_prog_load_opts *load_attr,
+					const char **prog_name, struct bpf_insn **insns,
+					int *insns_cnt, __u32 kern_version)
 {
-	LIBBPF_OPTS(bpf_prog_load_opts, load_attr);
-	const char *prog_name = NULL;
-	char *cp, errmsg[STRERR_BUFSIZE];
-	size_t log_buf_size = 0;
-	char *log_buf = NULL, *tmp;
-	int btf_fd, ret, err;
-	bool own_log_buf = true;
-	__u32 log_level = prog->log_level;
+	int btf_fd, err;
 
 	if (prog->type == BPF_PROG_TYPE_UNSPEC) {
 		/*
@@ -7056,59 +7770,95 @@ static int bpf_object_load_prog(struct bpf_object *obj, struct bpf_program *prog
 		return -EINVAL;
 	}
 
-	if (!insns || !insns_cnt)
+	if (!*insns || !*insns_cnt)
 		return -EINVAL;
 
+	*prog_name = NULL;
 	if (kernel_supports(obj, FEAT_PROG_NAME))
-		prog_name = prog->name;
-	load_attr.attach_prog_fd = prog->attach_prog_fd;
-	load_attr.attach_btf_obj_fd = prog->attach_btf_obj_fd;
-	load_attr.attach_btf_id = prog->attach_btf_id;
-	load_attr.kern_version = kern_version;
-	load_attr.prog_ifindex = prog->prog_ifindex;
+		*prog_name = prog->name;
+	load_attr->attach_prog_fd = prog->attach_prog_fd;
+	load_attr->attach_btf_obj_fd = prog->attach_btf_obj_fd;
+	load_attr->attach_btf_id = prog->attach_btf_id;
+	load_attr->kern_version = kern_version;
+	load_attr->prog_ifindex = prog->prog_ifindex;
 
 	/* specify func_info/line_info only if kernel supports them */
 	btf_fd = btf__fd(obj->btf);
 	if (btf_fd >= 0 && kernel_supports(obj, FEAT_BTF_FUNC)) {
-		load_attr.prog_btf_fd = btf_fd;
-		load_attr.func_info = prog->func_info;
-		load_attr.func_info_rec_size = prog->func_info_rec_size;
-		load_attr.func_info_cnt = prog->func_info_cnt;
-		load_attr.line_info = prog->line_info;
-		load_attr.line_info_rec_size = prog->line_info_rec_size;
-		load_attr.line_info_cnt = prog->line_info_cnt;
-	}
-	load_attr.log_level = log_level;
-	load_attr.prog_flags = prog->prog_flags;
-	load_attr.fd_array = obj->fd_array;
-
-	load_attr.token_fd = obj->token_fd;
+		load_attr->prog_btf_fd = btf_fd;
+		load_attr->func_info = prog->func_info;
+		load_attr->func_info_rec_size = prog->func_info_rec_size;
+		load_attr->func_info_cnt = prog->func_info_cnt;
+		load_attr->line_info = prog->line_info;
+		load_attr->line_info_rec_size = prog->line_info_rec_size;
+		load_attr->line_info_cnt = prog->line_info_cnt;
+	}
+	load_attr->log_level = prog->log_level;
+	load_attr->prog_flags = prog->prog_flags;
+	load_attr->fd_array = obj->fd_array;
+
+	load_attr->token_fd = obj->token_fd;
 	if (obj->token_fd)
-		load_attr.prog_flags |= BPF_F_TOKEN_FD;
+		load_attr->prog_flags |= BPF_F_TOKEN_FD;
 
 	/* adjust load_attr if sec_def provides custom preload callback */
 	if (prog->sec_def && prog->sec_def->prog_prepare_load_fn) {
-		err = prog->sec_def->prog_prepare_load_fn(prog, &load_attr, prog->sec_def->cookie);
+		err = prog->sec_def->prog_prepare_load_fn(prog, load_attr, prog->sec_def->cookie);
 		if (err < 0) {
 			pr_warn("prog '%s': failed to prepare load attributes: %d\n",
 				prog->name, err);
 			return err;
 		}
-		insns = prog->insns;
-		insns_cnt = prog->insns_cnt;
+		*insns = prog->insns;
+		*insns_cnt = prog->insns_cnt;
 	}
 
 	/* allow prog_prepare_load_fn to change expected_attach_type */
-	load_attr.expected_attach_type = prog->expected_attach_type;
+	load_attr->expected_attach_type = prog->expected_attach_type;
+	return 0;
+}
 
-	if (obj->gen_loader) {
-		bpf_gen__prog_load(obj->gen_loader, prog->type, prog->name,
-				   license, insns, insns_cnt, &load_attr,
-				   prog - obj->programs);
-		*prog_fd = -1;
-		return 0;
+/* Reports the outcome of a program load, along with its verifier log */
+static void pr_prog_load_result(struct bpf_program *prog, int err, const char *log_buf)
+{
+	char errmsg[STRERR_BUFSIZE];
+
+	if (!err) {
+		if (log_buf)
+			pr_debug("prog '%s': -- BEGIN PROG LOAD LOG --\n%s-- END PROG LOAD LOG --\n",
+				 prog->name, log_buf);
+		return;
 	}
 
+	pr_warn("prog '%s': BPF program load failed: %s\n", prog->name,
+		libbpf_strerror_r(-err, errmsg, sizeof(errmsg)));
+	pr_perm_msg(err);
+
+	if (log_buf && log_buf[0] != '\0') {
+		pr_warn("prog '%s': -- BEGIN PROG LOAD LOG --\n%s-- END PROG LOAD LOG --\n",
+			prog->name, log_buf);
+	}
+}
+
+/*
+ * Issues BPF_PROG_LOAD with attributes from bpf_object_prepare_prog_load(),
+ * retrying with a verifier log on failure. Only reads object state, so
+ * programs of one object may be loaded from several threads at once. With
+ * log_out, the verifier log libbpf allocated is handed to the caller
+ * instead of being printed right away.
+ */
+static int bpf_object_do_prog_load(struct bpf_object *obj, struct bpf_program *prog,
+				   struct bpf_prog_load_opts *load_attr, const char *prog_name,
+				   struct bpf_insn *insns, int insns_cnt,
+				   const char *license, int *prog_fd, char **log_out)
+{
+	char *cp, errmsg[STRERR_BUFSIZE];
+	size_t log_buf_size = 0;
+	char *log_buf = NULL, *tmp;
+	bool own_log_buf = true;
+	__u32 log_level = prog->log_level;
+	int ret;
+
 retry_load:
 	/* if log_level is zero, we don't request logs initially even if
 	 * custom log_buf is specified; if the program load fails, then we'll
@@ -7137,15 +7887,19 @@ retry_load:
 		}
 	}
 
-	load_attr.log_buf = log_buf;
-	load_attr.log_size = log_buf_size;
-	load_attr.log_level = log_level;
+	load_attr->log_buf = log_buf;
+	load_attr->log_size = log_buf_size;
+	load_attr->log_level = log_level;
 
-	ret = bpf_prog_load(prog->type, prog_name, license, insns, insns_cnt, &load_attr);
+	ret = bpf_prog_load(prog->type, prog_name, license, insns, insns_cnt, load_attr);
 	if (ret >= 0) {
 		if (log_level && own_log_buf) {
-			pr_debug("prog '%s': -- BEGIN PROG LOAD LOG --\n%s-- END PROG LOAD LOG --\n",
-				 prog->name, log_buf);
+			if (log_out) {
+				*log_out = log_buf;
+				log_buf = NULL;
+			} else {
+				pr_prog_load_result(prog, 0, log_buf);
+			}
 		}
 
 		if (obj->has_rodata && kernel_supports(obj, FEAT_PROG_BIND_MAP)) {
@@ -7190,13 +7944,13 @@ retry_load:
 	/* post-process verifier log to improve error descriptions */
 	fixup_verifier_log(prog, log_buf, log_buf_size);
 
-	cp = libbpf_strerror_r(errno, errmsg, sizeof(errmsg));
-	pr_warn("prog '%s': BPF program load failed: %s\n", prog->name, cp);
-	pr_perm_msg(ret);
-
-	if (own_log_buf && log_buf && log_buf[0] != '\0') {
-		pr_warn("prog '%s': -- BEGIN PROG LOAD LOG --\n%s-- END PROG LOAD LOG --\n",
-			prog->name, log_buf);
+	if (log_out) {
+		if (own_log_buf) {
+			*log_out = log_buf;
+			log_buf = NULL;
+		}
+	} else {
+		pr_prog_load_result(prog, ret, own_log_buf ? log_buf : NULL);
 	}
 
 out:
@@ -7205,6 +7959,31 @@ out:
 	return ret;
 }
 
+static int bpf_object_load_prog(struct bpf_object *obj, struct bpf_program *prog,
+				struct bpf_insn *insns, int insns_cnt,
+				const char *license, __u32 kern_version, int *prog_fd)
+{
+	LIBBPF_OPTS(bpf_prog_load_opts, load_attr);
+	const char *prog_name;
+	int err;
+
+	err = bpf_object_prepare_prog_load(obj, prog, &load_attr, &prog_name,
+					   &insns, &insns_cnt, kern_version);
+	if (err)
+		return err;
+
+	if (obj->gen_loader) {
+		bpf_gen__prog_load(obj->gen_loader, prog->type, prog->name,
+				   license, insns, insns_cnt, &load_attr,
+				   prog - obj->programs);
+		*prog_fd = -1;
+		return 0;
+	}
+
+	return bpf_object_do_prog_load(obj, prog, &load_attr, prog_name, insns, insns_cnt,
+				       license, prog_fd, NULL);
+}
+
 static char *find_prev_line(char *buf, char *cur)
 {
 	char *p;
@@ -7444,14 +8223,125 @@ static int bpf_program_record_relos(struct bpf_program *prog)
 				.kind = relo->core_relo->kind,
 			};
 
-			bpf_gen__record_relo_core(obj->gen_loader, &cr);
-			break;
+			bpf_gen__record_relo_core(obj->gen_loader, &cr);
+			break;
+		}
+		default:
+			continue;
+		}
+	}
+	return 0;
+}
+
+struct prog_load_job {
+	struct bpf_program *prog;
+	struct bpf_prog_load_opts attr;
+	const char *prog_name;
+	struct bpf_insn *insns;
+	int insns_cnt;
+	int err;
+	char *log;
+};
+
+struct prog_load_pool {
+	struct bpf_object *obj;
+	struct prog_load_job *jobs;
+	int job_cnt;
+	int next_job;
+};
+
+static void *prog_load_worker_fn(void *arg)
+{
+	struct prog_load_pool *pool = arg;
+	struct prog_load_job *job;
+	int i;
+
+	/* programs differ wildly in verification time, so hand them out one by one */
+	while ((i = __atomic_fetch_add(&pool->next_job, 1, __ATOMIC_RELAXED)) < pool->job_cnt) {
+		job = &pool->jobs[i];
+		job->err = bpf_object_do_prog_load(pool->obj, job->prog, &job->attr,
+						   job->prog_name, job->insns, job->insns_cnt,
+						   pool->obj->license, &job->prog->fd, &job->log);
+	}
+	return NULL;
+}
+
+/*
+ * Loads programs on up to obj->prog_load_threads threads, the calling one
+ * included. Everything that touches shared state (attach target lookup,
+ * feature probing, sec_def callbacks) happens up front on the calling
+ * thread; workers then only issue BPF_PROG_LOAD. Verifier logs are held
+ * back and printed in program order afterwards, and the first failing
+ * program in that order determines the result, so reporting doesn't depend
+ * on thread scheduling.
+ */
+static int bpf_object__load_progs_parallel(struct bpf_object *obj, int log_level)
+{
+	struct prog_load_pool pool = { .obj = obj };
+	struct prog_load_job *job;
+	struct bpf_program *prog;
+	pthread_t *tids;
+	int i, thread_cnt, started = 0, err = 0;
+
+	pool.jobs = calloc(obj->nr_programs, sizeof(*pool.jobs));
+	if (!pool.jobs)
+		return -ENOMEM;
+
+	for (i = 0; i < obj->nr_programs; i++) {
+		prog = &obj->programs[i];
+		if (prog_is_subprog(obj, prog))
+			continue;
+		if (!prog->autoload) {
+			pr_debug("prog '%s': skipped loading\n", prog->name);
+			continue;
+		}
+		prog->log_level |= log_level;
+
+		job = &pool.jobs[pool.job_cnt];
+		job->prog = prog;
+		job->insns = prog->insns;
+		job->insns_cnt = prog->insns_cnt;
+		job->attr.sz = sizeof(job->attr);
+		err = bpf_object_prepare_prog_load(obj, prog, &job->attr, &job->prog_name,
+						   &job->insns, &job->insns_cnt, obj->kern_version);
+		if (err) {
+			pr_warn("prog '%s': failed to load: %d\n", prog->name, err);
+			goto out;
 		}
-		default:
-			continue;
+		pool.job_cnt++;
+	}
+	/* probed by workers on success, make sure they find it cached */
+	if (obj->has_rodata)
+		kernel_supports(obj, FEAT_PROG_BIND_MAP);
+
+	thread_cnt = min(obj->prog_load_threads, (__u32)pool.job_cnt);
+	tids = calloc(thread_cnt, sizeof(*tids));
+	for (i = 1; tids && i < thread_cnt; i++) {
+		if (pthread_create(&tids[started], NULL, prog_load_worker_fn, &pool))
+			break;
+		started++;
+	}
+	/* whatever threads couldn't be started, the calling one makes up for */
+	prog_load_worker_fn(&pool);
+	for (i = 0; i < started; i++)
+		pthread_join(tids[i], NULL);
+	free(tids);
+
+	for (i = 0; i < pool.job_cnt; i++) {
+		job = &pool.jobs[i];
+		pr_prog_load_result(job->prog, job->err, job->log);
+		if (job->err) {
+			pr_warn("prog '%s': failed to load: %d\n", job->prog->name, job->err);
+			err = job->err;
+			break;
 		}
 	}
-	return 0;
+
+out:
+	for (i = 0; i < pool.job_cnt; i++)
+		free(pool.jobs[i].log);
+	free(pool.jobs);
+	return err;
 }
 
 static int
@@ -7468,6 +8358,15 @@ bpf_object__load_progs(struct bpf_object *obj, int log_level)
 			return err;
 	}
 
+	/* a shared object-wide log buffer rules out concurrent loads */
+	if (obj->prog_load_threads > 1 && !obj->gen_loader && !obj->log_buf) {
+		err = bpf_object__load_progs_parallel(obj, log_level);
+		if (err)
+			return err;
+		bpf_object__free_relocs(obj);
+		return 0;
+	}
+
 	for (i = 0; i < obj->nr_programs; i++) {
 		prog = &obj->programs[i];
 		if (prog_is_subprog(obj, prog))
@@ -7532,6 +8431,7 @@ static struct bpf_object *bpf_object_open(const char *path, const void *obj_buf,
 					  const struct bpf_object_open_opts *opts)
 {
 	const char *obj_name, *kconfig, *btf_tmp_path, *token_path;
+	const char *core_cache_dir;
 	struct bpf_object *obj;
 	char tmp_name[64];
 	int err;
@@ -7607,6 +8507,17 @@ static struct bpf_object *bpf_object_open(const char *path, const void *obj_buf,
 		}
 	}
 
+	obj->prog_load_threads = OPTS_GET(opts, prog_load_threads, 0);
+
+	core_cache_dir = OPTS_GET(opts, core_cache_dir, NULL);
+	if (core_cache_dir) {
+		obj->core_cache_dir = strdup(core_cache_dir);
+		if (!obj->core_cache_dir) {
+			err = -ENOMEM;
+			goto out;
+		}
+	}
+
 	kconfig = OPTS_GET(opts, kconfig, NULL);
 	if (kconfig) {
 		obj->kconfig = strdup(kconfig);
@@ -7685,6 +8596,31 @@ static int bpf_object__sanitize_maps(struct bpf_object *obj)
 	struct bpf_map *m;
 
 	bpf_object__for_each_map(m, obj) {
+		/* Perf buffers with map_extra set, which the kernel has no use
+		 * for on them, become a ring buffer of that many bytes if the
+		 * kernel has them; bpf_event_output() picks the matching
+		 * helper through LINUX_HAS_RINGBUF and perf_buffer__new()
+		 * consumes either. map_extra is cleared either way.
+		 */
+		if (m->def.type == BPF_MAP_TYPE_PERF_EVENT_ARRAY && m->map_extra) {
+			if (m->map_extra > UINT_MAX) {
+				pr_warn("map '%s': ring buffer size %llu is too big\n",
+					m->name, (unsigned long long)m->map_extra);
+				return -EINVAL;
+			}
+			if (kernel_supports(obj, FEAT_RINGBUF)) {
+				pr_debug("map '%s': using BPF ringbuf of %llu bytes instead of perf buffer\n",
+					 m->name, (unsigned long long)m->map_extra);
+				m->def.type = BPF_MAP_TYPE_RINGBUF;
+				m->def.key_size = 0;
+				m->def.value_size = 0;
+				m->def.max_entries = adjust_ringbuf_sz(m->map_extra);
+				m->btf_key_type_id = 0;
+				m->btf_value_type_id = 0;
+			}
+			m->map_extra = 0;
+			continue;
+		}
 		if (!bpf_map__is_internal(m))
 			continue;
 		if (!kernel_supports(obj, FEAT_ARRAY_MMAP))
@@ -7694,37 +8630,286 @@ static int bpf_object__sanitize_maps(struct bpf_object *obj)
 	return 0;
 }
 
-int libbpf_kallsyms_parse(kallsyms_cb_t cb, void *ctx)
+typedef int (*line_cb_t)(char *line, size_t len, void *ctx);
+
+#define LINE_READER_CHUNK (64 * 1024)
+
+/* Reads a text file in large chunks and calls cb with each line, the
+ * terminating newline replaced by '\0'. Much cheaper than fscanf() on
+ * /proc/kallsyms and tracefs function lists, which have 100k+ lines.
+ */
+static int libbpf_read_lines(const char *path, line_cb_t cb, void *ctx)
 {
-	char sym_type, sym_name[500];
-	unsigned long long sym_addr;
-	int ret, err = 0;
-	FILE *f;
+	size_t cap = LINE_READER_CHUNK, start = 0, end = 0;
+	char *buf, *nl, *tmp;
+	int fd, err = 0;
+	ssize_t n;
 
-	f = fopen("/proc/kallsyms", "re");
-	if (!f) {
-		err = -errno;
-		pr_warn("failed to open /proc/kallsyms: %d\n", err);
-		return err;
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+
+	buf = malloc(cap + 1);
+	if (!buf) {
+		close(fd);
+		return -ENOMEM;
 	}
 
 	while (true) {
-		ret = fscanf(f, "%llx %c %499s%*[^\n]\n",
-			     &sym_addr, &sym_type, sym_name);
-		if (ret == EOF && feof(f))
+		/* keep the partial line, make room for the next chunk */
+		if (start) {
+			memmove(buf, buf + start, end - start);
+			end -= start;
+			start = 0;
+		}
+		if (end == cap) {
+			tmp = realloc(buf, cap * 2 + 1);
+			if (!tmp) {
+				err = -ENOMEM;
+				break;
+			}
+			buf = tmp;
+			cap *= 2;
+		}
+
+		n = read(fd, buf + end, cap - end);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0) {
+			err = -errno;
 			break;
-		if (ret != 3) {
-			pr_warn("failed to read kallsyms entry: %d\n", ret);
-			err = -EINVAL;
+		}
+		if (n == 0) {
+			/* last line without a newline */
+			if (end > start) {
+				buf[end] = '\0';
+				err = cb(buf + start, end - start, ctx);
+			}
 			break;
 		}
+		end += n;
+
+		while ((nl = memchr(buf + start, '\n', end - start))) {
+			*nl = '\0';
+			err = cb(buf + start, nl - buf - start, ctx);
+			if (err)
+				goto out;
+			start = nl - buf + 1;
+		}
+	}
+out:
+	free(buf);
+	close(fd);
+	return err;
+}
+
+static const char *parse_hex_ull(const char *s, unsigned long long *val)
+{
+	unsigned long long v = 0;
+	const char *p = s;
+	int d;
+
+	for (;; p++) {
+		if (*p >= '0' && *p <= '9')
+			d = *p - '0';
+		else if (*p >= 'a' && *p <= 'f')
+			d = *p - 'a' + 10;
+		else if (*p >= 'A' && *p <= 'F')
+			d = *p - 'A' + 10;
+		else
+			break;
+		v = (v << 4) | d;
+	}
+	*val = v;
+	return p == s ? NULL : p;
+}
+
+/* Splits off the first whitespace-delimited word of *s */
+static char *next_word(char **s)
+{
+	char *p = *s, *w;
+
+	while (*p == ' ' || *p == '\t')
+		p++;
+	if (!*p)
+		return NULL;
+	w = p;
+	while (*p && *p != ' ' && *p != '\t')
+		p++;
+	if (*p)
+		*p++ = '\0';
+	*s = p;
+	return w;
+}
+
+/* Parses "<addr> <type> <name>[\t[module]]" */
+static int parse_kallsyms_line(char *line, unsigned long long *addr, char *type, char **name)
+{
+	char *p;
+
+	p = (char *)parse_hex_ull(line, addr);
+	if (!p || *p != ' ' || !p[1] || p[2] != ' ')
+		return -EINVAL;
+	*type = p[1];
+	p += 3;
+	*name = next_word(&p);
+	return *name ? 0 : -EINVAL;
+}
+
+struct kallsyms_entry {
+	unsigned long long addr;
+	__u32 name_off;
+	char type;
+};
+
+/* Parsed /proc/kallsyms, shared by every user in the process */
+struct kallsyms_table {
+	struct kallsyms_entry *syms;
+	size_t cnt;
+	size_t cap;
+	char *strs;
+	size_t strs_len;
+	size_t strs_cap;
+	/* identity of the loaded module set the table was built for */
+	__u64 modules_hash;
+	int refcnt;
+};
+
+static struct kallsyms_table *kallsyms_cache;
+static pthread_mutex_t kallsyms_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void kallsyms_table_put(struct kallsyms_table *tab)
+{
+	bool last;
+
+	pthread_mutex_lock(&kallsyms_cache_lock);
+	last = --tab->refcnt == 0;
+	pthread_mutex_unlock(&kallsyms_cache_lock);
+	if (!last)
+		return;
+	free(tab->syms);
+	free(tab->strs);
+	free(tab);
+}
+
+static int kallsyms_table_add(char *line, size_t len, void *ctx)
+{
+	struct kallsyms_table *tab = ctx;
+	struct kallsyms_entry *sym;
+	unsigned long long addr;
+	size_t name_len;
+	char type, *name;
+	int err;
+
+	err = parse_kallsyms_line(line, &addr, &type, &name);
+	if (err) {
+		pr_warn("failed to read kallsyms entry: '%s'\n", line);
+		return err;
+	}
+	name_len = strlen(name) + 1;
+
+	err = libbpf_ensure_mem((void **)&tab->strs, &tab->strs_cap, 1,
+				tab->strs_len + name_len);
+	if (err)
+		return err;
+	sym = libbpf_add_mem((void **)&tab->syms, &tab->cap, sizeof(*tab->syms),
+			     tab->cnt, SIZE_MAX, 1);
+	if (!sym)
+		return -ENOMEM;
+
+	memcpy(tab->strs + tab->strs_len, name, name_len);
+	sym->addr = addr;
+	sym->type = type;
+	sym->name_off = tab->strs_len;
+	tab->strs_len += name_len;
+	tab->cnt++;
+	return 0;
+}
+
+static int modules_hash_line(char *line, size_t len, void *ctx)
+{
+	char *name, *word, *last = NULL;
+	__u64 *h = ctx;
+
+	/* module name and load address; skip refcounts, which keep changing */
+	name = next_word(&line);
+	while ((word = next_word(&line)))
+		last = word;
+	if (!name || !last)
+		return 0;
+	*h = (*h ^ str_hash(name)) * 0x100000001b3ULL;
+	*h = (*h ^ str_hash(last)) * 0x100000001b3ULL;
+	return 0;
+}
+
+static __u64 kallsyms_modules_hash(void)
+{
+	__u64 h = 0xcbf29ce484222325ULL;
+
+	/* no /proc/modules: no loadable modules, kallsyms can't change */
+	libbpf_read_lines("/proc/modules", modules_hash_line, &h);
+	return h;
+}
+
+/* Returns the memoized kallsyms table, rebuilt if modules came or went */
+static struct kallsyms_table *kallsyms_table_get(void)
+{
+	__u64 modules_hash = kallsyms_modules_hash();
+	struct kallsyms_table *tab, *old = NULL;
+	int err;
 
-		err = cb(sym_addr, sym_type, sym_name, ctx);
+	pthread_mutex_lock(&kallsyms_cache_lock);
+	tab = kallsyms_cache;
+	if (tab && tab->modules_hash == modules_hash) {
+		tab->refcnt++;
+		pthread_mutex_unlock(&kallsyms_cache_lock);
+		return tab;
+	}
+	pthread_mutex_unlock(&kallsyms_cache_lock);
+
+	tab = calloc(1, sizeof(*tab));
+	if (!tab)
+		return ERR_PTR(-ENOMEM);
+	tab->modules_hash = modules_hash;
+	/* one reference for the cache, one for the caller */
+	tab->refcnt = 2;
+
+	err = libbpf_read_lines("/proc/kallsyms", kallsyms_table_add, tab);
+	if (err) {
+		pr_warn("failed to read /proc/kallsyms: %d\n", err);
+		free(tab->syms);
+		free(tab->strs);
+		free(tab);
+		return ERR_PTR(err);
+	}
+
+	pthread_mutex_lock(&kallsyms_cache_lock);
+	old = kallsyms_cache;
+	kallsyms_cache = tab;
+	pthread_mutex_unlock(&kallsyms_cache_lock);
+	if (old)
+		kallsyms_table_put(old);
+	return tab;
+}
+
+int libbpf_kallsyms_parse(kallsyms_cb_t cb, void *ctx)
+{
+	struct kallsyms_table *tab;
+	size_t i;
+	int err = 0;
+
+	tab = kallsyms_table_get();
+	if (IS_ERR(tab))
+		return PTR_ERR(tab);
+
+	for (i = 0; i < tab->cnt; i++) {
+		err = cb(tab->syms[i].addr, tab->syms[i].type,
+			 tab->strs + tab->syms[i].name_off, ctx);
 		if (err)
 			break;
 	}
 
-	fclose(f);
+	kallsyms_table_put(tab);
 	return err;
 }
 
@@ -7993,6 +9178,8 @@ static int bpf_object__resolve_externs(struct bpf_object *obj,
 				value = kernel_supports(obj, FEAT_BPF_COOKIE);
 			} else if (strcmp(ext->name, "LINUX_HAS_SYSCALL_WRAPPER") == 0) {
 				value = kernel_supports(obj, FEAT_SYSCALL_WRAPPER);
+			} else if (strcmp(ext->name, "LINUX_HAS_RINGBUF") == 0) {
+				value = kernel_supports(obj, FEAT_RINGBUF);
 			} else if (!str_has_pfx(ext->name, "LINUX_") || !ext->is_weak) {
 				/* Currently libbpf supports only CONFIG_ and LINUX_ prefixed
 				 * __kconfig externs, where LINUX_ ones are virtual and filled out
@@ -8106,6 +9293,7 @@ static int bpf_object_load(struct bpf_object *obj, int extra_log_level, const ch
 
 	err = bpf_object_prepare_token(obj);
 	err = err ? : bpf_object__probe_loading(obj);
+	err = err ? : bpf_object__open_core_cache(obj, obj->btf_custom_path ? : target_btf_path);
 	err = err ? : bpf_object__load_vmlinux_btf(obj, false);
 	err = err ? : bpf_object__resolve_externs(obj, obj->kconfig);
 	err = err ? : bpf_object__sanitize_maps(obj);
@@ -8131,15 +9319,16 @@ static int bpf_object_load(struct bpf_object *obj, int extra_log_level, const ch
 	/* clean up module BTFs */
 	for (i = 0; i < obj->btf_module_cnt; i++) {
 		close(obj->btf_modules[i].fd);
-		btf__free(obj->btf_modules[i].btf);
 		free(obj->btf_modules[i].name);
 	}
 	free(obj->btf_modules);
 
-	/* clean up vmlinux BTF */
-	btf__free(obj->btf_vmlinux);
+	/* drop shared vmlinux BTF, module BTFs go away along with it */
+	vmlinux_btf_put(obj->btf_vmlinux);
 	obj->btf_vmlinux = NULL;
 
+	bpf_object__unmap_file(obj);
+
 	obj->loaded = true; /* doesn't matter if successfully or not */
 
 	if (err)
@@ -8616,13 +9805,18 @@ void bpf_object__close(struct bpf_object *obj)
 	bpf_object__elf_finish(obj);
 	bpf_object_unload(obj);
 	btf__free(obj->btf);
-	btf__free(obj->btf_vmlinux);
+	vmlinux_btf_put(obj->btf_vmlinux);
 	btf_ext__free(obj->btf_ext);
+	/* only after btf and btf_ext, which may point into it */
+	if (obj->file_map)
+		munmap(obj->file_map, obj->file_map_sz);
 
 	for (i = 0; i < obj->nr_maps; i++)
 		bpf_map__destroy(&obj->maps[i]);
 
 	zfree(&obj->btf_custom_path);
+	zfree(&obj->core_cache_dir);
+	core_cache_free(obj->core_cache);
 	zfree(&obj->kconfig);
 
 	for (i = 0; i < obj->nr_extern; i++)
@@ -9485,7 +10679,7 @@ int libbpf_find_vmlinux_btf_id(const char *name,
 	struct btf *btf;
 	int err;
 
-	btf = btf__load_vmlinux_btf();
+	btf = vmlinux_btf_get();
 	err = libbpf_get_error(btf);
 	if (err) {
 		pr_warn("vmlinux BTF is not found\n");
@@ -9496,7 +10690,7 @@ int libbpf_find_vmlinux_btf_id(const char *name,
 	if (err <= 0)
 		pr_warn("%s is not found in vmlinux BTF\n", name);
 
-	btf__free(btf);
+	vmlinux_btf_put(btf);
 	return libbpf_err(err);
 }
 
@@ -10862,6 +12056,8 @@ bool glob_match(const char *str, const char *pat)
 
 struct kprobe_multi_resolve {
 	const char *pattern;
+	/* length of the literal prefix of pattern, checked before glob_match() */
+	size_t prefix_len;
 	unsigned long *addrs;
 	size_t cap;
 	size_t cnt;
@@ -10870,9 +12066,16 @@ struct kprobe_multi_resolve {
 struct avail_kallsyms_data {
 	char **syms;
 	size_t cnt;
+	size_t cap;
 	struct kprobe_multi_resolve *res;
 };
 
+static bool kprobe_multi_match(const struct kprobe_multi_resolve *res, const char *name)
+{
+	return strncmp(name, res->pattern, res->prefix_len) == 0 &&
+	       glob_match(name, res->pattern);
+}
+
 static int avail_func_cmp(const void *a, const void *b)
 {
 	return strcmp(*(const char **)a, *(const char **)b);
@@ -10896,75 +12099,66 @@ static int avail_kallsyms_cb(unsigned long long sym_addr, char sym_type,
 	return 0;
 }
 
-static int libbpf_available_kallsyms_parse(struct kprobe_multi_resolve *res)
+static int avail_funcs_line(char *line, size_t len, void *ctx)
 {
-	const char *available_functions_file = tracefs_available_filter_functions();
-	struct avail_kallsyms_data data;
-	char sym_name[500];
-	FILE *f;
-	int err = 0, ret, i;
-	char **syms = NULL;
-	size_t cap = 0, cnt = 0;
+	struct avail_kallsyms_data *data = ctx;
+	char *sym_name, *name;
+	int err;
 
-	f = fopen(available_functions_file, "re");
-	if (!f) {
-		err = -errno;
-		pr_warn("failed to open %s: %d\n", available_functions_file, err);
-		return err;
+	sym_name = next_word(&line);
+	if (!sym_name) {
+		pr_warn("failed to parse available_filter_functions entry: '%s'\n", line);
+		return -EINVAL;
 	}
 
-	while (true) {
-		char *name;
-
-		ret = fscanf(f, "%499s%*[^\n]\n", sym_name);
-		if (ret == EOF && feof(f))
-			break;
+	if (!kprobe_multi_match(data->res, sym_name))
+		return 0;
 
-		if (ret != 1) {
-			pr_warn("failed to parse available_filter_functions entry: %d\n", ret);
-			err = -EINVAL;
-			goto cleanup;
-		}
+	err = libbpf_ensure_mem((void **)&data->syms, &data->cap, sizeof(*data->syms),
+				data->cnt + 1);
+	if (err)
+		return err;
 
-		if (!glob_match(sym_name, res->pattern))
-			continue;
+	name = strdup(sym_name);
+	if (!name)
+		return -errno;
 
-		err = libbpf_ensure_mem((void **)&syms, &cap, sizeof(*syms), cnt + 1);
-		if (err)
-			goto cleanup;
+	data->syms[data->cnt++] = name;
+	return 0;
+}
 
-		name = strdup(sym_name);
-		if (!name) {
-			err = -errno;
-			goto cleanup;
-		}
+static int libbpf_available_kallsyms_parse(struct kprobe_multi_resolve *res)
+{
+	const char *available_functions_file = tracefs_available_filter_functions();
+	struct avail_kallsyms_data data = {
+		.res = res,
+	};
+	int err, i;
 
-		syms[cnt++] = name;
+	err = libbpf_read_lines(available_functions_file, avail_funcs_line, &data);
+	if (err) {
+		pr_warn("failed to read %s: %d\n", available_functions_file, err);
+		goto cleanup;
 	}
 
 	/* no entries found, bail out */
-	if (cnt == 0) {
+	if (data.cnt == 0) {
 		err = -ENOENT;
 		goto cleanup;
 	}
 
 	/* sort available functions */
-	qsort(syms, cnt, sizeof(*syms), avail_func_cmp);
+	qsort(data.syms, data.cnt, sizeof(*data.syms), avail_func_cmp);
 
-	data.syms = syms;
-	data.res = res;
-	data.cnt = cnt;
 	libbpf_kallsyms_parse(avail_kallsyms_cb, &data);
 
 	if (res->cnt == 0)
 		err = -ENOENT;
 
 cleanup:
-	for (i = 0; i < cnt; i++)
-		free((char *)syms[i]);
-	free(syms);
-
-	fclose(f);
+	for (i = 0; i < data.cnt; i++)
+		free(data.syms[i]);
+	free(data.syms);
 	return err;
 }
 
@@ -10973,50 +12167,44 @@ static bool has_available_filter_functions_addrs(void)
 	return access(tracefs_available_filter_functions_addrs(), R_OK) != -1;
 }
 
-static int libbpf_available_kprobes_parse(struct kprobe_multi_resolve *res)
+static int avail_kprobes_line(char *line, size_t len, void *ctx)
 {
-	const char *available_path = tracefs_available_filter_functions_addrs();
-	char sym_name[500];
-	FILE *f;
-	int ret, err = 0;
+	struct kprobe_multi_resolve *res = ctx;
 	unsigned long long sym_addr;
+	char *p, *sym_name;
+	int err;
 
-	f = fopen(available_path, "re");
-	if (!f) {
-		err = -errno;
-		pr_warn("failed to open %s: %d\n", available_path, err);
-		return err;
+	p = (char *)parse_hex_ull(line, &sym_addr);
+	sym_name = p ? next_word(&p) : NULL;
+	if (!sym_name) {
+		pr_warn("failed to parse available_filter_functions_addrs entry: '%s'\n", line);
+		return -EINVAL;
 	}
 
-	while (true) {
-		ret = fscanf(f, "%llx %499s%*[^\n]\n", &sym_addr, sym_name);
-		if (ret == EOF && feof(f))
-			break;
+	if (!kprobe_multi_match(res, sym_name))
+		return 0;
 
-		if (ret != 2) {
-			pr_warn("failed to parse available_filter_functions_addrs entry: %d\n",
-				ret);
-			err = -EINVAL;
-			goto cleanup;
-		}
+	err = libbpf_ensure_mem((void **)&res->addrs, &res->cap,
+				sizeof(*res->addrs), res->cnt + 1);
+	if (err)
+		return err;
 
-		if (!glob_match(sym_name, res->pattern))
-			continue;
+	res->addrs[res->cnt++] = (unsigned long)sym_addr;
+	return 0;
+}
 
-		err = libbpf_ensure_mem((void **)&res->addrs, &res->cap,
-					sizeof(*res->addrs), res->cnt + 1);
-		if (err)
-			goto cleanup;
+static int libbpf_available_kprobes_parse(struct kprobe_multi_resolve *res)
+{
+	const char *available_path = tracefs_available_filter_functions_addrs();
+	int err;
 
-		res->addrs[res->cnt++] = (unsigned long)sym_addr;
+	err = libbpf_read_lines(available_path, avail_kprobes_line, res);
+	if (err) {
+		pr_warn("failed to read %s: %d\n", available_path, err);
+		return err;
 	}
 
-	if (res->cnt == 0)
-		err = -ENOENT;
-
-cleanup:
-	fclose(f);
-	return err;
+	return res->cnt == 0 ? -ENOENT : 0;
 }
 
 struct bpf_link *
@@ -11055,6 +12243,7 @@ bpf_program__attach_kprobe_multi_opts(const struct bpf_program *prog,
 		return libbpf_err_ptr(-EINVAL);
 
 	if (pattern) {
+		res.prefix_len = strcspn(pattern, "*?");
 		if (has_available_filter_functions_addrs())
 			err = libbpf_available_kprobes_parse(&res);
 		else
@@ -12568,6 +13757,8 @@ struct perf_buffer {
 	int cpu_cnt; /* number of allocated CPU buffers */
 	int epoll_fd; /* perf event FD */
 	int map_fd; /* BPF_MAP_TYPE_PERF_EVENT_ARRAY BPF map FD */
+	/* set instead of cpu_bufs if map_fd turned out to be a BPF ringbuf */
+	struct ring_buffer *rb;
 };
 
 static void perf_buffer__free_cpu_buf(struct perf_buffer *pb,
@@ -12592,6 +13783,7 @@ void perf_buffer__free(struct perf_buffer *pb)
 
 	if (IS_ERR_OR_NULL(pb))
 		return;
+	ring_buffer__free(pb->rb);
 	if (pb->cpu_bufs) {
 		for (i = 0; i < pb->cpu_cnt; i++) {
 			struct perf_cpu_buf *cpu_buf = pb->cpu_bufs[i];
@@ -12720,6 +13912,51 @@ struct perf_buffer *perf_buffer__new_raw(int map_fd, size_t page_cnt,
 	return libbpf_ptr(__perf_buffer__new(map_fd, page_cnt, &p));
 }
 
+static int perf_buffer__ringbuf_sample(void *ctx, void *data, size_t size)
+{
+	struct perf_buffer *pb = ctx;
+
+	/* ringbuf samples don't carry the CPU they were produced on */
+	pb->sample_cb(pb->ctx, 0, data, size);
+	return 0;
+}
+
+/* Compatibility mode for PERF_EVENT_ARRAY maps that libbpf turned into a
+ * BPF ringbuf at load time (see bpf_object__sanitize_maps()): one ordered
+ * ring instead of per-CPU buffers, delivered through the perf_buffer
+ * sample callback. Records are never lost on the consumer side, so
+ * lost_cb is not called.
+ */
+static struct perf_buffer *perf_buffer__new_ringbuf(int map_fd, struct perf_buffer_params *p)
+{
+	struct perf_buffer *pb;
+	int err;
+
+	if (!p->sample_cb) {
+		pr_warn("map fd %d is a BPF ringbuf, only perf_buffer__new() can consume it\n",
+			map_fd);
+		return ERR_PTR(-EINVAL);
+	}
+
+	pb = calloc(1, sizeof(*pb));
+	if (!pb)
+		return ERR_PTR(-ENOMEM);
+
+	pb->sample_cb = p->sample_cb;
+	pb->ctx = p->ctx;
+	pb->map_fd = map_fd;
+	pb->epoll_fd = -1;
+	pb->cpu_cnt = 1;
+
+	pb->rb = ring_buffer__new(map_fd, perf_buffer__ringbuf_sample, pb, NULL);
+	if (!pb->rb) {
+		err = -errno;
+		free(pb);
+		return ERR_PTR(err);
+	}
+	return pb;
+}
+
 static struct perf_buffer *__perf_buffer__new(int map_fd, size_t page_cnt,
 					      struct perf_buffer_params *p)
 {
@@ -12754,6 +13991,8 @@ static struct perf_buffer *__perf_buffer__new(int map_fd, size_t page_cnt,
 		pr_debug("failed to get map info for FD %d; API not supported? Ignoring...\n",
 			 map_fd);
 	} else {
+		if (map.type == BPF_MAP_TYPE_RINGBUF)
+			return perf_buffer__new_ringbuf(map_fd, p);
 		if (map.type != BPF_MAP_TYPE_PERF_EVENT_ARRAY) {
 			pr_warn("map '%s' should be BPF_MAP_TYPE_PERF_EVENT_ARRAY\n",
 				map.name);
@@ -12930,6 +14169,8 @@ static int perf_buffer__process_records(struct perf_buffer *pb,
 
 int perf_buffer__epoll_fd(const struct perf_buffer *pb)
 {
+	if (pb->rb)
+		return ring_buffer__epoll_fd(pb->rb);
 	return pb->epoll_fd;
 }
 
@@ -12937,6 +14178,9 @@ int perf_buffer__poll(struct perf_buffer *pb, int timeout_ms)
 {
 	int i, cnt, err;
 
+	if (pb->rb)
+		return ring_buffer__poll(pb->rb, timeout_ms);
+
 	cnt = epoll_wait(pb->epoll_fd, pb->events, pb->cpu_cnt, timeout_ms);
 	if (cnt < 0)
 		return -errno;
@@ -12973,6 +14217,10 @@ int perf_buffer__buffer_fd(const struct perf_buffer *pb, size_t buf_idx)
 	if (buf_idx >= pb->cpu_cnt)
 		return libbpf_err(-EINVAL);
 
+	/* the ringbuf map FD itself is pollable */
+	if (pb->rb)
+		return pb->map_fd;
+
 	cpu_buf = pb->cpu_bufs[buf_idx];
 	if (!cpu_buf)
 		return libbpf_err(-ENOENT);
@@ -12987,6 +14235,10 @@ int perf_buffer__buffer(struct perf_buffer *pb, int buf_idx, void **buf, size_t
 	if (buf_idx >= pb->cpu_cnt)
 		return libbpf_err(-EINVAL);
 
+	/* no perf mmap layout to hand out */
+	if (pb->rb)
+		return libbpf_err(-EOPNOTSUPP);
+
 	cpu_buf = pb->cpu_bufs[buf_idx];
 	if (!cpu_buf)
 		return libbpf_err(-ENOENT);
@@ -13011,6 +14263,9 @@ int perf_buffer__consume_buffer(struct perf_buffer *pb, size_t buf_idx)
 	if (buf_idx >= pb->cpu_cnt)
 		return libbpf_err(-EINVAL);
 
+	if (pb->rb)
+		return perf_buffer__consume(pb);
+
 	cpu_buf = pb->cpu_bufs[buf_idx];
 	if (!cpu_buf)
 		return libbpf_err(-ENOENT);
@@ -13022,6 +14277,11 @@ int perf_buffer__consume(struct perf_buffer *pb)
 {
 	int i, err;
 
+	if (pb->rb) {
+		err = ring_buffer__consume(pb->rb);
+		return err < 0 ? err : 0;
+	}
+
 	for (i = 0; i < pb->cpu_cnt; i++) {
 		struct perf_cpu_buf *cpu_buf = pb->cpu_bufs[i];
 
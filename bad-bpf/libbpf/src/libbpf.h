@@ -20,6 +20,14 @@
 #include "libbpf_common.h"
 #include "libbpf_legacy.h"
 
+/* This libbpf carries extensions that upstream releases don't have (ring
+ * buffer batching and busy polling, the CO-RE cache, bpf_netlink_batch,
+ * bpf_prog_sampler, bpf_map_dump, ...), exported in their own
+ * LIBBPF_RL_EXT_1.0 version node. Test for this macro, not for a libbpf
+ * version, before using them.
+ */
+#define LIBBPF_HAS_RL_EXT 1
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -196,10 +204,31 @@ struct bpf_object_open_opts {
 	 * point (/sys/fs/bpf), in case this default behavior is undesirable.
 	 */
 	const char *bpf_token_path;
+	/* Directory for a persistent cache of CO-RE relocation results.
+	 * If set, libbpf stores resolved relocations there after a
+	 * successful load, keyed by running kernel (build ID and set of
+	 * module BTFs, or *btf_custom_path*) and by the object's BTF. Later
+	 * loads of the same object on the same kernel apply them directly,
+	 * skipping candidate search and, if nothing else needs it, vmlinux
+	 * BTF parsing. Cache files are checksummed; a corrupted, stale or
+	 * unwritable cache only costs a regular CO-RE pass.
+	 * The directory is ignored unless it is owned by the caller and not
+	 * accessible to anyone else (mode 0700), and so are cache files that
+	 * are symlinks or owned by someone else.
+	 */
+	const char *core_cache_dir;
+	/* Number of threads to verify programs on at load time. With more
+	 * than one, programs are submitted to BPF_PROG_LOAD concurrently,
+	 * which cuts load time of objects with many expensive programs on
+	 * multi-core machines; the load result and logged errors are the same
+	 * as for a sequential load. The libbpf print callback may then be
+	 * called from several threads. Ignored if *kernel_log_buf* is set.
+	 */
+	__u32 prog_load_threads;
 
 	size_t :0;
 };
-#define bpf_object_open_opts__last_field bpf_token_path
+#define bpf_object_open_opts__last_field prog_load_threads
 
 /**
  * @brief **bpf_object__open()** creates a bpf_object by opening
@@ -307,6 +336,22 @@ LIBBPF_API int libbpf_attach_type_by_name(const char *name,
 LIBBPF_API int libbpf_find_vmlinux_btf_id(const char *name,
 					  enum bpf_attach_type attach_type);
 
+/**
+ * @brief **libbpf_vmlinux_btf_prewarm()** parses kernel BTF into the
+ * process-wide copy that all BPF objects share, and holds a reference to it.
+ * Calling it at startup moves the cost of parsing kernel BTF out of the first
+ * bpf_object__load() and keeps the BTF cached between loads.
+ * @return 0, on success; negative error code, otherwise
+ */
+LIBBPF_API int libbpf_vmlinux_btf_prewarm(void);
+
+/**
+ * @brief **libbpf_vmlinux_btf_release()** drops a reference taken by
+ * **libbpf_vmlinux_btf_prewarm()**, and does nothing if there is none left.
+ * Kernel BTF is freed once no loaded or loading BPF object uses it anymore.
+ */
+LIBBPF_API void libbpf_vmlinux_btf_release(void);
+
 /* Accessors of bpf_program */
 struct bpf_program;
 
@@ -1261,6 +1306,158 @@ LIBBPF_API int bpf_tc_detach(const struct bpf_tc_hook *hook,
 LIBBPF_API int bpf_tc_query(const struct bpf_tc_hook *hook,
 			    struct bpf_tc_opts *opts);
 
+/* Batched TC/XDP netlink requests
+ *
+ * Requests queued on a batch are sent over a single netlink socket, many
+ * per sendmsg(), and their acks are collected afterwards. This replaces a
+ * socket and a round trip per call of the functions above when attaching
+ * to many interfaces at once.
+ *
+ * Each bpf_netlink_batch__*() call validates its arguments and queues one
+ * request. *hook* and *opts* passed to bpf_netlink_batch__tc_attach() have
+ * to stay valid until bpf_netlink_batch__submit(), which fills in *opts*
+ * like bpf_tc_attach() does. If *res* is not NULL, the request's result
+ * (0 or negative error code) is stored there on submit.
+ */
+struct bpf_netlink_batch;
+
+LIBBPF_API struct bpf_netlink_batch *bpf_netlink_batch__new(void);
+LIBBPF_API void bpf_netlink_batch__free(struct bpf_netlink_batch *batch);
+LIBBPF_API int bpf_netlink_batch__tc_hook_create(struct bpf_netlink_batch *batch,
+						 struct bpf_tc_hook *hook, int *res);
+LIBBPF_API int bpf_netlink_batch__tc_attach(struct bpf_netlink_batch *batch,
+					    const struct bpf_tc_hook *hook,
+					    struct bpf_tc_opts *opts, int *res);
+LIBBPF_API int bpf_netlink_batch__xdp_attach(struct bpf_netlink_batch *batch,
+					     int ifindex, int prog_fd, __u32 flags,
+					     const struct bpf_xdp_attach_opts *opts,
+					     int *res);
+/**
+ * @brief **bpf_netlink_batch__submit()** sends all queued requests, in
+ * order, and waits for their results. The batch is empty afterwards and
+ * can be reused.
+ * @return 0, if all requests succeeded; otherwise, the error of the first
+ * failed request in queue order
+ */
+LIBBPF_API int bpf_netlink_batch__submit(struct bpf_netlink_batch *batch);
+
+/* BPF program run-time statistics */
+#define BPF_PROG_SAMPLE_HIST_SLOTS 32
+
+struct bpf_prog_sample {
+	const char *name;
+	int prog_fd;
+	/* totals since the program was added to the sampler */
+	__u64 run_time_ns;
+	__u64 run_cnt;
+	__u64 recursion_misses;
+	/* the interval between the last two samples */
+	__u64 interval_ns;
+	__u64 interval_run_time_ns;
+	__u64 interval_run_cnt;
+	/* Invocations by the average ns/invocation of the interval they ran
+	 * in: slot i counts [2^i, 2^(i+1)) ns, slot 0 also 0 ns, the last
+	 * slot everything above.
+	 */
+	__u64 hist[BPF_PROG_SAMPLE_HIST_SLOTS];
+};
+
+struct bpf_prog_sampler_opts {
+	size_t sz; /* size of this struct, for forward/backward compatibility */
+	size_t :0;
+};
+
+#define bpf_prog_sampler_opts__last_field sz
+
+struct bpf_prog_sampler;
+
+/**
+ * @brief **bpf_prog_sampler__new()** enables BPF_STATS_RUN_TIME for as long
+ * as the sampler exists and starts tracking every loaded program of *obj*.
+ * Other programs, e.g. of a light skeleton, can be added with
+ * **bpf_prog_sampler__add_prog()**.
+ *
+ * Each **bpf_prog_sampler__sample()** call reads the kernel's run_time_ns
+ * and run_cnt of every tracked program and updates its
+ * struct bpf_prog_sample. CPU overhead of a program over the last interval,
+ * in percent of one CPU, is 100 * interval_run_time_ns / interval_ns.
+ *
+ * Run-time stats make every program invocation slightly more expensive, so
+ * only keep a sampler around while the numbers are wanted.
+ * @param obj BPF object whose programs to track, can be NULL
+ * @param opts optional options, can be NULL
+ * @return sampler on success; NULL with errno set on error (e.g. EPERM
+ * without CAP_SYS_ADMIN, EINVAL on kernels before 5.8)
+ */
+LIBBPF_API struct bpf_prog_sampler *
+bpf_prog_sampler__new(const struct bpf_object *obj, const struct bpf_prog_sampler_opts *opts);
+LIBBPF_API void bpf_prog_sampler__free(struct bpf_prog_sampler *s);
+/**
+ * @brief **bpf_prog_sampler__add_prog()** starts tracking the program
+ * behind *prog_fd*. The sampler keeps its own duplicate of *prog_fd*.
+ * @param name name to report, or NULL to use the kernel's program name
+ * @return 0 on success; negative error code otherwise
+ */
+LIBBPF_API int bpf_prog_sampler__add_prog(struct bpf_prog_sampler *s, int prog_fd,
+					  const char *name);
+LIBBPF_API int bpf_prog_sampler__sample(struct bpf_prog_sampler *s);
+LIBBPF_API int bpf_prog_sampler__prog_cnt(const struct bpf_prog_sampler *s);
+/**
+ * @brief **bpf_prog_sampler__prog()** returns the statistics of the
+ * *idx*-th tracked program, in the order they were added. The pointer is
+ * valid until the next **bpf_prog_sampler__add_prog()** or
+ * **bpf_prog_sampler__free()**.
+ */
+LIBBPF_API const struct bpf_prog_sample *
+bpf_prog_sampler__prog(const struct bpf_prog_sampler *s, int idx);
+
+/* Whole-map iteration */
+struct bpf_map_dump_opts {
+	size_t sz; /* size of this struct, for forward/backward compatibility */
+	/* elements fetched by the first batch lookup, 64 if zero; grows
+	 * while batches come back full
+	 */
+	__u32 batch_size;
+	size_t :0;
+};
+
+#define bpf_map_dump_opts__last_field batch_size
+
+struct bpf_map_dump;
+
+/**
+ * @brief **bpf_map_dump__new()** prepares to iterate over all elements of
+ * the map behind *map_fd*.
+ *
+ * Elements are fetched with **bpf_map_lookup_batch()**, in batches that
+ * grow as long as they come back full and whenever a hash bucket does not
+ * fit. On kernels or map types without batch operations it falls back to
+ * **bpf_map_get_next_key()** and **bpf_map_lookup_elem()**.
+ *
+ * @param map_fd BPF map file descriptor, must outlive the iterator
+ * @param opts optional options, can be NULL
+ * @return iterator on success; NULL with errno set on error
+ */
+LIBBPF_API struct bpf_map_dump *
+bpf_map_dump__new(int map_fd, const struct bpf_map_dump_opts *opts);
+LIBBPF_API void bpf_map_dump__free(struct bpf_map_dump *d);
+/**
+ * @brief **bpf_map_dump__next()** returns the next element of the map.
+ *
+ * Values of per-CPU maps are unpacked into an array of
+ * **libbpf_num_possible_cpus()** values of the map's value size each,
+ * without the kernel's 8-byte padding. *key* and *value* stay valid until
+ * the next call.
+ *
+ * @param d iterator
+ * @param key set to the element's key
+ * @param value set to the element's value; can be NULL
+ * @return 0 on success; -ENOENT after the last element; negative error
+ * code otherwise
+ */
+LIBBPF_API int bpf_map_dump__next(struct bpf_map_dump *d, const void **key,
+				  const void **value);
+
 /* Ring buffer APIs */
 struct ring_buffer;
 struct ring;
@@ -1270,9 +1467,19 @@ typedef int (*ring_buffer_sample_fn)(void *ctx, void *data, size_t size);
 
 struct ring_buffer_opts {
 	size_t sz; /* size of this struct, for forward/backward compatibility */
+	/* Busy-poll budget in microseconds. If non-zero, ring_buffer__poll()
+	 * first spins on the rings' producer positions for up to that long,
+	 * but never longer than its timeout, and only then sleeps in
+	 * epoll_wait(). A zero timeout never spins. The budget adapts: it
+	 * shrinks (down to 1/16th) while spinning finds nothing and grows
+	 * back when it does. This also picks up samples from producers
+	 * submitting with BPF_RB_NO_WAKEUP, which never wake up epoll.
+	 */
+	__u32 busy_poll_us;
+	size_t :0;
 };
 
-#define ring_buffer_opts__last_field sz
+#define ring_buffer_opts__last_field busy_poll_us
 
 LIBBPF_API struct ring_buffer *
 ring_buffer__new(int map_fd, ring_buffer_sample_fn sample_cb, void *ctx,
@@ -1284,6 +1491,101 @@ LIBBPF_API int ring_buffer__poll(struct ring_buffer *rb, int timeout_ms);
 LIBBPF_API int ring_buffer__consume(struct ring_buffer *rb);
 LIBBPF_API int ring_buffer__epoll_fd(const struct ring_buffer *rb);
 
+/* A single ringbuf record, as handed to ring_buffer_batch_fn */
+struct ring_buffer_sample {
+	void *data;
+	size_t size;
+};
+
+typedef int (*ring_buffer_batch_fn)(void *ctx,
+				    const struct ring_buffer_sample *samples,
+				    size_t cnt);
+
+struct ring_buffer_batch_opts {
+	size_t sz; /* size of this struct, for forward/backward compatibility */
+	/* maximum number of samples passed to one callback invocation;
+	 * 0 means 64
+	 */
+	size_t batch_size;
+	/* flush the batch early once that many bytes of ring buffer space
+	 * are pending, so producers get space back sooner; 0 means flush
+	 * only when the batch is full or the ring is empty
+	 */
+	size_t commit_bytes;
+	size_t :0;
+};
+#define ring_buffer_batch_opts__last_field commit_bytes
+
+/**
+ * @brief **ring_buffer__consume_batch()** consumes available data from all
+ * ringbuffers of the manager without event polling, handing samples to
+ * *batch_cb* in arrays instead of one at a time.
+ *
+ * Unlike **ring_buffer__consume()**, the consumer position is released back
+ * to the producer once per batch rather than once per sample, and the
+ * per-ring sample callbacks given to **ring_buffer__new()** and
+ * **ring_buffer__add()** are not called. Samples point directly into the
+ * ringbuffer and are only valid until *batch_cb* returns.
+ *
+ * If *batch_cb* returns a negative value, the samples of that batch are
+ * still considered consumed and the error is returned.
+ *
+ * @param rb A ringbuffer manager object.
+ * @param batch_cb Callback receiving each batch of samples.
+ * @param ctx User context passed to *batch_cb*.
+ * @param opts Optional batching parameters, can be NULL.
+ * @return The number of samples consumed (or INT_MAX, whichever is less) on
+ * success; a negative error code otherwise.
+ */
+LIBBPF_API int ring_buffer__consume_batch(struct ring_buffer *rb,
+					  ring_buffer_batch_fn batch_cb, void *ctx,
+					  const struct ring_buffer_batch_opts *opts);
+
+struct ring_buffer_workers_opts {
+	size_t sz; /* size of this struct, for forward/backward compatibility */
+	/* number of consumer threads; rings are spread over them round-robin
+	 * in the order they were added. 0 means one thread per ring.
+	 */
+	int worker_cnt;
+	/* worker i is pinned to cpus[i % cpu_cnt]; NULL leaves them unpinned */
+	const int *cpus;
+	size_t cpu_cnt;
+	size_t :0;
+};
+#define ring_buffer_workers_opts__last_field cpu_cnt
+
+/**
+ * @brief **ring_buffer__start_workers()** starts a pool of consumer threads,
+ * each draining its own subset of the manager's ringbuffers independently.
+ *
+ * Each worker sleeps in its own epoll instance and invokes the sample
+ * callbacks of its rings from its own thread, so callbacks of different rings
+ * can run concurrently. With one ring per CPU, pinning each worker next to
+ * its producers keeps the callbacks and their allocations NUMA-local.
+ *
+ * While the workers run, **ring_buffer__poll()**, **ring_buffer__consume()**,
+ * **ring_buffer__consume_batch()** and **ring_buffer__add()** fail with
+ * -EBUSY. A worker whose callback returns an error stops; the error is
+ * reported by **ring_buffer__stop_workers()**.
+ *
+ * @param rb A ringbuffer manager object.
+ * @param opts Optional pool parameters, can be NULL.
+ * @return 0 on success; a negative error code otherwise.
+ */
+LIBBPF_API int ring_buffer__start_workers(struct ring_buffer *rb,
+					  const struct ring_buffer_workers_opts *opts);
+
+/**
+ * @brief **ring_buffer__stop_workers()** stops and joins the threads started
+ * by **ring_buffer__start_workers()**. **ring_buffer__free()** does this
+ * implicitly.
+ *
+ * @param rb A ringbuffer manager object.
+ * @return 0 if all workers ran without error (or none were running); the
+ * first error hit by a worker otherwise.
+ */
+LIBBPF_API int ring_buffer__stop_workers(struct ring_buffer *rb);
+
 /**
  * @brief **ring_buffer__ring()** returns the ringbuffer object inside a given
  * ringbuffer manager representing a single BPF_MAP_TYPE_RINGBUF map instance.
@@ -1461,6 +1763,44 @@ LIBBPF_API void user_ring_buffer__submit(struct user_ring_buffer *rb, void *samp
  */
 LIBBPF_API void user_ring_buffer__discard(struct user_ring_buffer *rb, void *sample);
 
+/**
+ * @brief **user_ring_buffer__reserve_batch()** reserves *cnt* consecutive
+ * samples in the user ring buffer at once.
+ * @param rb A pointer to a user ring buffer.
+ * @param sizes The size of each sample, in bytes.
+ * @param samples Filled with a pointer to each 8-byte aligned reserved sample.
+ * @param cnt Number of samples to reserve.
+ * @return 0 on success; a negative error code otherwise, in which case no
+ * sample is reserved.
+ *
+ * Space for all samples is claimed with a single update of the producer
+ * position. Like **user_ring_buffer__reserve()**, this function is *not*
+ * thread safe, and fails with -E2BIG if the samples cannot fit into the ring
+ * buffer at all, or with -ENOSPC if there is currently not enough room.
+ *
+ * After initializing the samples, callers must invoke
+ * **user_ring_buffer__submit_batch()** to post them to the kernel. Individual
+ * samples of a batch may be passed to **user_ring_buffer__discard()** before
+ * that.
+ */
+LIBBPF_API int user_ring_buffer__reserve_batch(struct user_ring_buffer *rb,
+					       const __u32 *sizes, void **samples,
+					       __u32 cnt);
+
+/**
+ * @brief **user_ring_buffer__submit_batch()** submits all samples reserved
+ * by one **user_ring_buffer__reserve_batch()** call.
+ * @param rb The user ring buffer.
+ * @param samples The samples, as returned by
+ * **user_ring_buffer__reserve_batch()**.
+ * @param cnt Number of samples in the batch.
+ *
+ * The kernel sees the whole batch at once: only the header of the first
+ * sample is published with a release barrier.
+ */
+LIBBPF_API void user_ring_buffer__submit_batch(struct user_ring_buffer *rb,
+					       void **samples, __u32 cnt);
+
 /**
  * @brief **user_ring_buffer__free()** frees a ring buffer that was previously
  * created with **user_ring_buffer__new()**.
@@ -1494,6 +1834,12 @@ struct perf_buffer_opts {
  * @param ctx user-provided extra context passed into *sample_cb* and *lost_cb*
  * @return a new instance of struct perf_buffer on success, NULL on error with
  * *errno* containing an error code
+ *
+ * If *map_fd* refers to a BPF_MAP_TYPE_RINGBUF map (a perf buffer map declared
+ * with `__uint(map_extra, N)` that libbpf upgraded at load time), records
+ * are consumed from that single ring buffer instead: *sample_cb* gets CPU 0,
+ * *lost_cb* is never called, no per-CPU buffers are mapped and
+ * **perf_buffer__buffer()** returns -EOPNOTSUPP.
  */
 LIBBPF_API struct perf_buffer *
 perf_buffer__new(int map_fd, size_t page_cnt,
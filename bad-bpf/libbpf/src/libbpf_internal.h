@@ -374,6 +374,8 @@ enum kern_feature_id {
 	FEAT_UPROBE_MULTI_LINK,
 	/* Kernel supports arg:ctx tag (__arg_ctx) for global subprogs natively */
 	FEAT_ARG_CTX_TAG,
+	/* v5.8: BPF_MAP_TYPE_RINGBUF support */
+	FEAT_RINGBUF,
 	__FEAT_CNT,
 };
 
@@ -405,6 +407,20 @@ int btf_load_into_kernel(struct btf *btf,
 			 int token_fd);
 
 struct btf *btf_get_from_fd(int btf_fd, struct btf *base_btf);
+
+enum btf_raw_data_src {
+	BTF_RAW_DATA_COPY,	/* private heap copy */
+	BTF_RAW_DATA_MMAP,	/* read-only mapping of a raw BTF file */
+	BTF_RAW_DATA_VIEW,	/* caller's writable memory, outliving the BTF */
+};
+
+/*
+ * Like btf__new() and btf_ext__new(), but parse data in place instead of
+ * copying it. data must stay valid until the object is freed, and may be
+ * modified (e.g., byte-swapped or fixed up before load).
+ */
+struct btf *btf_new_view(void *data, __u32 size);
+struct btf_ext *btf_ext_new_view(void *data, __u32 size);
 void btf_get_kernel_prefix_kind(enum bpf_attach_type attach_type,
 				const char **prefix, int *kind);
 
@@ -483,6 +499,8 @@ struct btf_ext {
 	struct btf_ext_info line_info;
 	struct btf_ext_info core_relo_info;
 	__u32 data_size;
+	/* data is borrowed, see btf_ext_new_view() */
+	bool data_is_view;
 };
 
 struct btf_ext_info_sec {
@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: (LGPL-2.1 OR BSD-2-Clause)
+/*
+ * Iterate over all elements of a BPF map using batch lookups.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <linux/bpf.h>
+#include <linux/kernel.h>
+
+#include "libbpf.h"
+#include "libbpf_internal.h"
+#include "bpf.h"
+
+#define MAP_DUMP_DEF_BATCH	64
+#define MAP_DUMP_MAX_BATCH	4096
+
+struct bpf_map_dump {
+	int map_fd;
+	__u32 key_size;
+	__u32 value_size;
+	/* per-CPU maps: value slots per element, their padded size and the
+	 * size of all of them as the kernel returns them
+	 */
+	int nr_cpus;
+	__u32 value_stride;
+	__u32 raw_value_size;
+	bool use_batch;
+	bool done;
+
+	/* current batch: cnt elements, next one to return at pos */
+	__u32 batch_size;
+	__u32 cnt;
+	__u32 pos;
+	void *keys;
+	void *values;
+	/* opaque batch tokens, at least a key or a u64 wide */
+	void *in_batch;
+	void *out_batch;
+	bool started;
+
+	/* unpacked value of the element last returned */
+	void *value;
+};
+
+static bool map_dump_is_percpu(__u32 type)
+{
+	switch (type) {
+	case BPF_MAP_TYPE_PERCPU_HASH:
+	case BPF_MAP_TYPE_PERCPU_ARRAY:
+	case BPF_MAP_TYPE_LRU_PERCPU_HASH:
+	case BPF_MAP_TYPE_PERCPU_CGROUP_STORAGE:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static int map_dump_resize(struct bpf_map_dump *d, __u32 batch_size)
+{
+	void *tmp;
+
+	tmp = libbpf_reallocarray(d->keys, batch_size, d->key_size);
+	if (!tmp)
+		return -ENOMEM;
+	d->keys = tmp;
+	tmp = libbpf_reallocarray(d->values, batch_size, d->raw_value_size);
+	if (!tmp)
+		return -ENOMEM;
+	d->values = tmp;
+	d->batch_size = batch_size;
+	return 0;
+}
+
+void bpf_map_dump__free(struct bpf_map_dump *d)
+{
+	if (!d)
+		return;
+
+	free(d->keys);
+	free(d->values);
+	free(d->in_batch);
+	free(d->out_batch);
+	free(d->value);
+	free(d);
+}
+
+struct bpf_map_dump *bpf_map_dump__new(int map_fd, const struct bpf_map_dump_opts *opts)
+{
+	struct bpf_map_info info;
+	__u32 info_len = sizeof(info), batch_size;
+	size_t token_size;
+	struct bpf_map_dump *d;
+	int err;
+
+	if (!OPTS_VALID(opts, bpf_map_dump_opts) || map_fd < 0)
+		return libbpf_err_ptr(-EINVAL);
+
+	memset(&info, 0, sizeof(info));
+	err = bpf_map_get_info_by_fd(map_fd, &info, &info_len);
+	if (err) {
+		err = -errno;
+		pr_warn("map dump: failed to get info for map FD %d: %d\n", map_fd, err);
+		return libbpf_err_ptr(err);
+	}
+
+	d = calloc(1, sizeof(*d));
+	if (!d)
+		return libbpf_err_ptr(-ENOMEM);
+
+	d->map_fd = map_fd;
+	d->key_size = info.key_size;
+	d->value_size = info.value_size;
+	d->nr_cpus = 1;
+	d->value_stride = info.value_size;
+	if (map_dump_is_percpu(info.type)) {
+		d->nr_cpus = libbpf_num_possible_cpus();
+		if (d->nr_cpus < 0) {
+			err = d->nr_cpus;
+			goto err_out;
+		}
+		d->value_stride = roundup(info.value_size, 8);
+	}
+	d->raw_value_size = d->value_stride * d->nr_cpus;
+	d->use_batch = true;
+
+	batch_size = OPTS_GET(opts, batch_size, 0) ?: MAP_DUMP_DEF_BATCH;
+	if (info.max_entries && batch_size > info.max_entries)
+		batch_size = info.max_entries;
+	err = map_dump_resize(d, batch_size);
+	if (err)
+		goto err_out;
+
+	token_size = max(d->key_size, (__u32)sizeof(__u64));
+	d->in_batch = calloc(1, token_size);
+	d->out_batch = calloc(1, token_size);
+	d->value = calloc(d->nr_cpus, d->value_size);
+	if (!d->in_batch || !d->out_batch || !d->value) {
+		err = -ENOMEM;
+		goto err_out;
+	}
+
+	return d;
+
+err_out:
+	bpf_map_dump__free(d);
+	return libbpf_err_ptr(err);
+}
+
+static int map_dump_fill_batch(struct bpf_map_dump *d)
+{
+	__u32 cnt;
+	void *tmp;
+	int err;
+
+	for (;;) {
+		cnt = d->batch_size;
+		err = bpf_map_lookup_batch(d->map_fd, d->started ? d->in_batch : NULL,
+					   d->out_batch, d->keys, d->values, &cnt, NULL);
+		err = err ? -errno : 0;
+		if (err == -ENOSPC && cnt == 0) {
+			/* a hash bucket holds more elements than fit in a batch */
+			err = map_dump_resize(d, d->batch_size * 2);
+			if (err)
+				return err;
+			continue;
+		}
+		break;
+	}
+
+	if (err && err != -ENOENT) {
+		/* kernels or map types without batch ops */
+		if (!d->started && (err == -EINVAL || err == -524 /* -ENOTSUPP */ ||
+				    err == -EOPNOTSUPP)) {
+			d->use_batch = false;
+			return 0;
+		}
+		return err;
+	}
+
+	d->started = true;
+	d->cnt = cnt;
+	d->pos = 0;
+	if (err == -ENOENT) {
+		d->done = true;
+		return 0;
+	}
+
+	tmp = d->in_batch;
+	d->in_batch = d->out_batch;
+	d->out_batch = tmp;
+
+	/* few syscalls for big maps: grow while batches come back full */
+	if (cnt == d->batch_size && d->batch_size < MAP_DUMP_MAX_BATCH)
+		return map_dump_resize(d, d->batch_size * 2);
+	return 0;
+}
+
+/* Old kernels: one get_next_key and one lookup per element. */
+static int map_dump_fill_elem(struct bpf_map_dump *d)
+{
+	int err;
+
+	for (;;) {
+		err = bpf_map_get_next_key(d->map_fd, d->started ? d->keys : NULL, d->keys);
+		if (err) {
+			err = -errno;
+			if (err == -ENOENT)
+				d->done = true;
+			return err;
+		}
+		d->started = true;
+
+		err = bpf_map_lookup_elem(d->map_fd, d->keys, d->values);
+		if (!err)
+			break;
+		/* deleted since get_next_key, skip it */
+		if (errno != ENOENT)
+			return -errno;
+	}
+
+	d->cnt = 1;
+	d->pos = 0;
+	return 0;
+}
+
+int bpf_map_dump__next(struct bpf_map_dump *d, const void **key, const void **value)
+{
+	const void *raw;
+	int err, i;
+
+	if (!d || !key)
+		return libbpf_err(-EINVAL);
+
+	while (d->pos >= d->cnt) {
+		if (d->done)
+			return libbpf_err(-ENOENT);
+		if (d->use_batch) {
+			err = map_dump_fill_batch(d);
+			if (err)
+				return libbpf_err(err);
+		}
+		/* not an else, batch lookup may have just been found missing */
+		if (!d->use_batch) {
+			err = map_dump_fill_elem(d);
+			if (err)
+				return libbpf_err(err);
+		}
+	}
+
+	*key = d->keys + (size_t)d->pos * d->key_size;
+	raw = d->values + (size_t)d->pos * d->raw_value_size;
+	d->pos++;
+
+	if (!value)
+		return 0;
+	if (d->value_stride == d->value_size) {
+		*value = raw;
+		return 0;
+	}
+
+	/* per-CPU values come padded to 8 bytes each, pack them tightly */
+	for (i = 0; i < d->nr_cpus; i++)
+		memcpy(d->value + (size_t)i * d->value_size,
+		       raw + (size_t)i * d->value_stride, d->value_size);
+	*value = d->value;
+	return 0;
+}
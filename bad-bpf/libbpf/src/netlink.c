@@ -283,48 +283,47 @@ static int libbpf_netlink_resolve_genl_family_id(const char *name,
 					parse_genl_family_id, NULL, id);
 }
 
-static int __bpf_set_link_xdp_fd_replace(int ifindex, int fd, int old_fd,
-					 __u32 flags)
+static int xdp_set_link_req(struct libbpf_nla_req *req, int ifindex, int fd,
+			    int old_fd, __u32 flags)
 {
 	struct nlattr *nla;
 	int ret;
-	struct libbpf_nla_req req;
 
-	memset(&req, 0, sizeof(req));
-	req.nh.nlmsg_len      = NLMSG_LENGTH(sizeof(struct ifinfomsg));
-	req.nh.nlmsg_flags    = NLM_F_REQUEST | NLM_F_ACK;
-	req.nh.nlmsg_type     = RTM_SETLINK;
-	req.ifinfo.ifi_family = AF_UNSPEC;
-	req.ifinfo.ifi_index  = ifindex;
+	memset(req, 0, sizeof(*req));
+	req->nh.nlmsg_len      = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+	req->nh.nlmsg_flags    = NLM_F_REQUEST | NLM_F_ACK;
+	req->nh.nlmsg_type     = RTM_SETLINK;
+	req->ifinfo.ifi_family = AF_UNSPEC;
+	req->ifinfo.ifi_index  = ifindex;
 
-	nla = nlattr_begin_nested(&req, IFLA_XDP);
+	nla = nlattr_begin_nested(req, IFLA_XDP);
 	if (!nla)
 		return -EMSGSIZE;
-	ret = nlattr_add(&req, IFLA_XDP_FD, &fd, sizeof(fd));
+	ret = nlattr_add(req, IFLA_XDP_FD, &fd, sizeof(fd));
 	if (ret < 0)
 		return ret;
 	if (flags) {
-		ret = nlattr_add(&req, IFLA_XDP_FLAGS, &flags, sizeof(flags));
+		ret = nlattr_add(req, IFLA_XDP_FLAGS, &flags, sizeof(flags));
 		if (ret < 0)
 			return ret;
 	}
 	if (flags & XDP_FLAGS_REPLACE) {
-		ret = nlattr_add(&req, IFLA_XDP_EXPECTED_FD, &old_fd,
+		ret = nlattr_add(req, IFLA_XDP_EXPECTED_FD, &old_fd,
 				 sizeof(old_fd));
 		if (ret < 0)
 			return ret;
 	}
-	nlattr_end_nested(&req, nla);
-
-	return libbpf_netlink_send_recv(&req, NETLINK_ROUTE, NULL, NULL, NULL);
+	nlattr_end_nested(req, nla);
+	return 0;
 }
 
-int bpf_xdp_attach(int ifindex, int prog_fd, __u32 flags, const struct bpf_xdp_attach_opts *opts)
+static int xdp_attach_req(struct libbpf_nla_req *req, int ifindex, int prog_fd,
+			  __u32 flags, const struct bpf_xdp_attach_opts *opts)
 {
-	int old_prog_fd, err;
+	int old_prog_fd;
 
 	if (!OPTS_VALID(opts, bpf_xdp_attach_opts))
-		return libbpf_err(-EINVAL);
+		return -EINVAL;
 
 	old_prog_fd = OPTS_GET(opts, old_prog_fd, 0);
 	if (old_prog_fd)
@@ -332,7 +331,19 @@ int bpf_xdp_attach(int ifindex, int prog_fd, __u32 flags, const struct bpf_xdp_a
 	else
 		old_prog_fd = -1;
 
-	err = __bpf_set_link_xdp_fd_replace(ifindex, prog_fd, old_prog_fd, flags);
+	return xdp_set_link_req(req, ifindex, prog_fd, old_prog_fd, flags);
+}
+
+int bpf_xdp_attach(int ifindex, int prog_fd, __u32 flags, const struct bpf_xdp_attach_opts *opts)
+{
+	struct libbpf_nla_req req;
+	int err;
+
+	err = xdp_attach_req(&req, ifindex, prog_fd, flags, opts);
+	if (err)
+		return libbpf_err(err);
+
+	err = libbpf_netlink_send_recv(&req, NETLINK_ROUTE, NULL, NULL, NULL);
 	return libbpf_err(err);
 }
 
@@ -579,24 +590,32 @@ static int tc_get_tcm_parent(enum bpf_tc_attach_point attach_point,
 	return 0;
 }
 
-static int tc_qdisc_modify(struct bpf_tc_hook *hook, int cmd, int flags)
+static int tc_qdisc_req(struct libbpf_nla_req *req, struct bpf_tc_hook *hook,
+			int cmd, int flags)
 {
 	qdisc_config_t config;
 	int ret;
-	struct libbpf_nla_req req;
 
 	ret = attach_point_to_config(hook, &config);
 	if (ret < 0)
 		return ret;
 
-	memset(&req, 0, sizeof(req));
-	req.nh.nlmsg_len   = NLMSG_LENGTH(sizeof(struct tcmsg));
-	req.nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | flags;
-	req.nh.nlmsg_type  = cmd;
-	req.tc.tcm_family  = AF_UNSPEC;
-	req.tc.tcm_ifindex = OPTS_GET(hook, ifindex, 0);
+	memset(req, 0, sizeof(*req));
+	req->nh.nlmsg_len   = NLMSG_LENGTH(sizeof(struct tcmsg));
+	req->nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | flags;
+	req->nh.nlmsg_type  = cmd;
+	req->tc.tcm_family  = AF_UNSPEC;
+	req->tc.tcm_ifindex = OPTS_GET(hook, ifindex, 0);
 
-	ret = config(&req);
+	return config(req);
+}
+
+static int tc_qdisc_modify(struct bpf_tc_hook *hook, int cmd, int flags)
+{
+	struct libbpf_nla_req req;
+	int ret;
+
+	ret = tc_qdisc_req(&req, hook, cmd, flags);
 	if (ret < 0)
 		return ret;
 
@@ -715,18 +734,17 @@ static int tc_add_fd_and_name(struct libbpf_nla_req *req, int fd)
 	return nlattr_add(req, TCA_BPF_NAME, name, len + 1);
 }
 
-int bpf_tc_attach(const struct bpf_tc_hook *hook, struct bpf_tc_opts *opts)
+static int tc_attach_req(struct libbpf_nla_req *req, const struct bpf_tc_hook *hook,
+			 struct bpf_tc_opts *opts)
 {
 	__u32 protocol, bpf_flags, handle, priority, parent, prog_id, flags;
 	int ret, ifindex, attach_point, prog_fd;
-	struct bpf_cb_ctx info = {};
-	struct libbpf_nla_req req;
 	struct nlattr *nla;
 
 	if (!hook || !opts ||
 	    !OPTS_VALID(hook, bpf_tc_hook) ||
 	    !OPTS_VALID(opts, bpf_tc_opts))
-		return libbpf_err(-EINVAL);
+		return -EINVAL;
 
 	ifindex      = OPTS_GET(hook, ifindex, 0);
 	parent       = OPTS_GET(hook, parent, 0);
@@ -739,44 +757,56 @@ int bpf_tc_attach(const struct bpf_tc_hook *hook, struct bpf_tc_opts *opts)
 	flags        = OPTS_GET(opts, flags, 0);
 
 	if (ifindex <= 0 || !prog_fd || prog_id)
-		return libbpf_err(-EINVAL);
+		return -EINVAL;
 	if (priority > UINT16_MAX)
-		return libbpf_err(-EINVAL);
+		return -EINVAL;
 	if (flags & ~BPF_TC_F_REPLACE)
-		return libbpf_err(-EINVAL);
+		return -EINVAL;
 
 	flags = (flags & BPF_TC_F_REPLACE) ? NLM_F_REPLACE : NLM_F_EXCL;
 	protocol = ETH_P_ALL;
 
-	memset(&req, 0, sizeof(req));
-	req.nh.nlmsg_len   = NLMSG_LENGTH(sizeof(struct tcmsg));
-	req.nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE |
-			     NLM_F_ECHO | flags;
-	req.nh.nlmsg_type  = RTM_NEWTFILTER;
-	req.tc.tcm_family  = AF_UNSPEC;
-	req.tc.tcm_ifindex = ifindex;
-	req.tc.tcm_handle  = handle;
-	req.tc.tcm_info    = TC_H_MAKE(priority << 16, htons(protocol));
+	memset(req, 0, sizeof(*req));
+	req->nh.nlmsg_len   = NLMSG_LENGTH(sizeof(struct tcmsg));
+	req->nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE |
+			      NLM_F_ECHO | flags;
+	req->nh.nlmsg_type  = RTM_NEWTFILTER;
+	req->tc.tcm_family  = AF_UNSPEC;
+	req->tc.tcm_ifindex = ifindex;
+	req->tc.tcm_handle  = handle;
+	req->tc.tcm_info    = TC_H_MAKE(priority << 16, htons(protocol));
 
 	ret = tc_get_tcm_parent(attach_point, &parent);
 	if (ret < 0)
-		return libbpf_err(ret);
-	req.tc.tcm_parent = parent;
+		return ret;
+	req->tc.tcm_parent = parent;
 
-	ret = nlattr_add(&req, TCA_KIND, "bpf", sizeof("bpf"));
+	ret = nlattr_add(req, TCA_KIND, "bpf", sizeof("bpf"));
 	if (ret < 0)
-		return libbpf_err(ret);
-	nla = nlattr_begin_nested(&req, TCA_OPTIONS);
+		return ret;
+	nla = nlattr_begin_nested(req, TCA_OPTIONS);
 	if (!nla)
-		return libbpf_err(-EMSGSIZE);
-	ret = tc_add_fd_and_name(&req, prog_fd);
+		return -EMSGSIZE;
+	ret = tc_add_fd_and_name(req, prog_fd);
 	if (ret < 0)
-		return libbpf_err(ret);
+		return ret;
 	bpf_flags = TCA_BPF_FLAG_ACT_DIRECT;
-	ret = nlattr_add(&req, TCA_BPF_FLAGS, &bpf_flags, sizeof(bpf_flags));
+	ret = nlattr_add(req, TCA_BPF_FLAGS, &bpf_flags, sizeof(bpf_flags));
+	if (ret < 0)
+		return ret;
+	nlattr_end_nested(req, nla);
+	return 0;
+}
+
+int bpf_tc_attach(const struct bpf_tc_hook *hook, struct bpf_tc_opts *opts)
+{
+	struct bpf_cb_ctx info = {};
+	struct libbpf_nla_req req;
+	int ret;
+
+	ret = tc_attach_req(&req, hook, opts);
 	if (ret < 0)
 		return libbpf_err(ret);
-	nlattr_end_nested(&req, nla);
 
 	info.opts = opts;
 
@@ -920,3 +950,259 @@ int bpf_tc_query(const struct bpf_tc_hook *hook, struct bpf_tc_opts *opts)
 		return libbpf_err(-ENOENT);
 	return ret;
 }
+
+struct nl_batch_req {
+	struct libbpf_nla_req req;
+	/* echoed TC filter, for bpf_netlink_batch__tc_attach() */
+	struct bpf_cb_ctx tc_info;
+	bool tc_attach;
+	bool done;
+	int err;
+	int *res;
+};
+
+struct bpf_netlink_batch {
+	struct nl_batch_req *reqs;
+	size_t req_cnt;
+	size_t req_cap;
+};
+
+/* Requests sent with one sendmsg(); their replies must fit into the socket
+ * receive buffer, as the kernel processes the whole lot before we read any.
+ */
+#define NL_BATCH_WINDOW 64
+
+struct bpf_netlink_batch *bpf_netlink_batch__new(void)
+{
+	struct bpf_netlink_batch *batch;
+
+	batch = calloc(1, sizeof(*batch));
+	if (!batch)
+		return errno = ENOMEM, NULL;
+	return batch;
+}
+
+void bpf_netlink_batch__free(struct bpf_netlink_batch *batch)
+{
+	if (!batch)
+		return;
+	free(batch->reqs);
+	free(batch);
+}
+
+static struct nl_batch_req *nl_batch_add(struct bpf_netlink_batch *batch, int *res)
+{
+	struct nl_batch_req *r;
+
+	r = libbpf_add_mem((void **)&batch->reqs, &batch->req_cap, sizeof(*batch->reqs),
+			   batch->req_cnt, SIZE_MAX, 1);
+	if (!r)
+		return NULL;
+	memset(r, 0, sizeof(*r));
+	r->res = res;
+	return r;
+}
+
+int bpf_netlink_batch__tc_hook_create(struct bpf_netlink_batch *batch,
+				      struct bpf_tc_hook *hook, int *res)
+{
+	struct nl_batch_req *r;
+	int ret;
+
+	if (!batch || !hook || !OPTS_VALID(hook, bpf_tc_hook) ||
+	    OPTS_GET(hook, ifindex, 0) <= 0)
+		return libbpf_err(-EINVAL);
+
+	r = nl_batch_add(batch, res);
+	if (!r)
+		return libbpf_err(-ENOMEM);
+	ret = tc_qdisc_req(&r->req, hook, RTM_NEWQDISC, NLM_F_CREATE | NLM_F_EXCL);
+	if (ret < 0)
+		return libbpf_err(ret);
+	batch->req_cnt++;
+	return 0;
+}
+
+int bpf_netlink_batch__tc_attach(struct bpf_netlink_batch *batch,
+				 const struct bpf_tc_hook *hook,
+				 struct bpf_tc_opts *opts, int *res)
+{
+	struct nl_batch_req *r;
+	int ret;
+
+	if (!batch)
+		return libbpf_err(-EINVAL);
+
+	r = nl_batch_add(batch, res);
+	if (!r)
+		return libbpf_err(-ENOMEM);
+	ret = tc_attach_req(&r->req, hook, opts);
+	if (ret < 0)
+		return libbpf_err(ret);
+	r->tc_attach = true;
+	r->tc_info.opts = opts;
+	batch->req_cnt++;
+	return 0;
+}
+
+int bpf_netlink_batch__xdp_attach(struct bpf_netlink_batch *batch, int ifindex,
+				  int prog_fd, __u32 flags,
+				  const struct bpf_xdp_attach_opts *opts, int *res)
+{
+	struct nl_batch_req *r;
+	int ret;
+
+	if (!batch)
+		return libbpf_err(-EINVAL);
+
+	r = nl_batch_add(batch, res);
+	if (!r)
+		return libbpf_err(-ENOMEM);
+	ret = xdp_attach_req(&r->req, ifindex, prog_fd, flags, opts);
+	if (ret < 0)
+		return libbpf_err(ret);
+	batch->req_cnt++;
+	return 0;
+}
+
+/* Collects replies to reqs[0..cnt), sent with sequence numbers seq + i */
+static int nl_batch_recv(int sock, __u32 nl_pid, struct nl_batch_req *reqs,
+			 int cnt, __u32 seq)
+{
+	struct iovec iov = {};
+	struct msghdr mhdr = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
+	struct nl_batch_req *r;
+	struct nlmsgerr *err;
+	struct nlmsghdr *nh;
+	int len, ret, pending = cnt;
+	__u32 idx;
+
+	ret = alloc_iov(&iov, 4096);
+	if (ret)
+		return ret;
+
+	while (pending) {
+		len = netlink_recvmsg(sock, &mhdr, MSG_PEEK | MSG_TRUNC);
+		if (len < 0) {
+			ret = len;
+			goto done;
+		}
+		if (len > iov.iov_len) {
+			ret = alloc_iov(&iov, len);
+			if (ret)
+				goto done;
+		}
+		len = netlink_recvmsg(sock, &mhdr, 0);
+		if (len < 0) {
+			ret = len;
+			goto done;
+		}
+		if (len == 0) {
+			ret = -EPIPE;
+			goto done;
+		}
+
+		for (nh = (struct nlmsghdr *)iov.iov_base; NLMSG_OK(nh, len);
+		     nh = NLMSG_NEXT(nh, len)) {
+			if (nh->nlmsg_pid != nl_pid) {
+				ret = -LIBBPF_ERRNO__WRNGPID;
+				goto done;
+			}
+			idx = nh->nlmsg_seq - seq;
+			if (idx >= cnt || reqs[idx].done) {
+				ret = -LIBBPF_ERRNO__INVSEQ;
+				goto done;
+			}
+			r = &reqs[idx];
+
+			if (nh->nlmsg_type == NLMSG_ERROR) {
+				/* every request is acked, successful or not */
+				err = (struct nlmsgerr *)NLMSG_DATA(nh);
+				if (err->error) {
+					r->err = err->error;
+					libbpf_nla_dump_errormsg(nh);
+				}
+				r->done = true;
+				pending--;
+			} else if (r->tc_attach) {
+				ret = get_tc_info(nh, NULL, &r->tc_info);
+				if (ret < 0 && !r->err)
+					r->err = ret;
+			}
+		}
+	}
+	ret = 0;
+done:
+	free(iov.iov_base);
+	return ret;
+}
+
+int bpf_netlink_batch__submit(struct bpf_netlink_batch *batch)
+{
+	struct nl_batch_req *r;
+	int sock, one = 1, ret = 0;
+	size_t i, j, n, len;
+	__u32 nl_pid, seq;
+	char *buf = NULL;
+
+	if (!batch)
+		return libbpf_err(-EINVAL);
+	if (!batch->req_cnt)
+		return 0;
+
+	sock = libbpf_netlink_open(&nl_pid, NETLINK_ROUTE);
+	if (sock < 0) {
+		ret = sock;
+		goto out;
+	}
+	/* keep acks small, without a copy of each request */
+	setsockopt(sock, SOL_NETLINK, NETLINK_CAP_ACK, &one, sizeof(one));
+
+	buf = malloc(NL_BATCH_WINDOW * sizeof(struct libbpf_nla_req));
+	if (!buf) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	seq = time(NULL);
+	for (i = 0; i < batch->req_cnt; i += n) {
+		n = min(batch->req_cnt - i, (size_t)NL_BATCH_WINDOW);
+		for (j = 0, len = 0; j < n; j++) {
+			r = &batch->reqs[i + j];
+			r->req.nh.nlmsg_pid = 0;
+			r->req.nh.nlmsg_seq = seq + i + j;
+			memcpy(buf + len, &r->req, r->req.nh.nlmsg_len);
+			len += NLMSG_ALIGN(r->req.nh.nlmsg_len);
+		}
+
+		if (send(sock, buf, len, 0) < 0) {
+			ret = -errno;
+			goto out;
+		}
+		ret = nl_batch_recv(sock, nl_pid, &batch->reqs[i], n, seq + i);
+		if (ret)
+			goto out;
+	}
+
+out:
+	for (i = 0; i < batch->req_cnt; i++) {
+		r = &batch->reqs[i];
+		/* requests without a reply share the failure of the batch */
+		if (!r->done)
+			r->err = ret ?: -EIO;
+		else if (!r->err && r->tc_attach && !r->tc_info.processed)
+			r->err = -ENOENT;
+		if (r->res)
+			*r->res = r->err;
+		if (!ret)
+			ret = r->err;
+	}
+	batch->req_cnt = 0;
+	free(buf);
+	if (sock >= 0)
+		libbpf_netlink_close(sock);
+	return libbpf_err(ret);
+}
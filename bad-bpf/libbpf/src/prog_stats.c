@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: (LGPL-2.1 OR BSD-2-Clause)
+/*
+ * BPF program run-time statistics sampler.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <linux/bpf.h>
+
+#include "libbpf.h"
+#include "libbpf_internal.h"
+#include "bpf.h"
+
+struct prog_sampler_ent {
+	struct bpf_prog_sample sample;
+	/* kernel counters and time at the previous sample */
+	__u64 prev_run_time_ns;
+	__u64 prev_run_cnt;
+	__u64 prev_recursion_misses;
+	__u64 prev_ts;
+};
+
+struct bpf_prog_sampler {
+	struct prog_sampler_ent *progs;
+	int prog_cnt;
+	/* keeps BPF_STATS_RUN_TIME enabled while the sampler exists */
+	int stats_fd;
+};
+
+static __u64 prog_sampler_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int prog_sampler_read(int prog_fd, struct bpf_prog_info *info)
+{
+	__u32 info_len = sizeof(*info);
+
+	memset(info, 0, sizeof(*info));
+	return bpf_prog_get_info_by_fd(prog_fd, info, &info_len);
+}
+
+void bpf_prog_sampler__free(struct bpf_prog_sampler *s)
+{
+	int i;
+
+	if (!s)
+		return;
+
+	for (i = 0; i < s->prog_cnt; i++) {
+		close(s->progs[i].sample.prog_fd);
+		free((char *)s->progs[i].sample.name);
+	}
+	free(s->progs);
+	if (s->stats_fd >= 0)
+		close(s->stats_fd);
+	free(s);
+}
+
+struct bpf_prog_sampler *bpf_prog_sampler__new(const struct bpf_object *obj,
+					       const struct bpf_prog_sampler_opts *opts)
+{
+	struct bpf_prog_sampler *s;
+	struct bpf_program *prog;
+	int err;
+
+	if (!OPTS_VALID(opts, bpf_prog_sampler_opts))
+		return libbpf_err_ptr(-EINVAL);
+
+	s = calloc(1, sizeof(*s));
+	if (!s)
+		return libbpf_err_ptr(-ENOMEM);
+
+	s->stats_fd = bpf_enable_stats(BPF_STATS_RUN_TIME);
+	if (s->stats_fd < 0) {
+		err = -errno;
+		pr_warn("prog sampler: failed to enable BPF run-time stats: %d\n", err);
+		goto err_out;
+	}
+
+	if (!obj)
+		return s;
+
+	bpf_object__for_each_program(prog, obj) {
+		if (bpf_program__fd(prog) < 0)
+			continue;
+		err = bpf_prog_sampler__add_prog(s, bpf_program__fd(prog), bpf_program__name(prog));
+		if (err)
+			goto err_out;
+	}
+
+	return s;
+
+err_out:
+	bpf_prog_sampler__free(s);
+	return libbpf_err_ptr(err);
+}
+
+int bpf_prog_sampler__add_prog(struct bpf_prog_sampler *s, int prog_fd, const char *name)
+{
+	struct prog_sampler_ent *ent;
+	struct bpf_prog_info info;
+	int fd, err;
+	void *tmp;
+
+	if (!s || prog_fd < 0)
+		return libbpf_err(-EINVAL);
+
+	err = prog_sampler_read(prog_fd, &info);
+	if (err) {
+		err = -errno;
+		pr_warn("prog sampler: failed to get info for prog FD %d: %d\n", prog_fd, err);
+		return libbpf_err(err);
+	}
+
+	tmp = libbpf_reallocarray(s->progs, s->prog_cnt + 1, sizeof(*s->progs));
+	if (!tmp)
+		return libbpf_err(-ENOMEM);
+	s->progs = tmp;
+
+	/* own a reference, so the program outlives its loader's fd */
+	fd = fcntl(prog_fd, F_DUPFD_CLOEXEC, 0);
+	if (fd < 0)
+		return libbpf_err(-errno);
+
+	ent = &s->progs[s->prog_cnt];
+	memset(ent, 0, sizeof(*ent));
+	ent->sample.name = strdup(name ?: info.name);
+	if (!ent->sample.name) {
+		close(fd);
+		return libbpf_err(-ENOMEM);
+	}
+	ent->sample.prog_fd = fd;
+
+	/* totals count from here on */
+	ent->prev_run_time_ns = info.run_time_ns;
+	ent->prev_run_cnt = info.run_cnt;
+	ent->prev_recursion_misses = info.recursion_misses;
+	ent->prev_ts = prog_sampler_now_ns();
+
+	s->prog_cnt++;
+	return 0;
+}
+
+static int prog_sampler_hist_slot(__u64 ns)
+{
+	int slot = 0;
+
+	while (ns > 1 && slot < BPF_PROG_SAMPLE_HIST_SLOTS - 1) {
+		ns >>= 1;
+		slot++;
+	}
+	return slot;
+}
+
+int bpf_prog_sampler__sample(struct bpf_prog_sampler *s)
+{
+	struct bpf_prog_info info;
+	int i, err, ret = 0;
+	__u64 now;
+
+	if (!s)
+		return libbpf_err(-EINVAL);
+
+	now = prog_sampler_now_ns();
+	for (i = 0; i < s->prog_cnt; i++) {
+		struct prog_sampler_ent *ent = &s->progs[i];
+		struct bpf_prog_sample *smp = &ent->sample;
+		__u64 d_time, d_cnt;
+
+		err = prog_sampler_read(smp->prog_fd, &info);
+		if (err) {
+			if (!ret)
+				ret = -errno;
+			continue;
+		}
+
+		d_time = info.run_time_ns - ent->prev_run_time_ns;
+		d_cnt = info.run_cnt - ent->prev_run_cnt;
+
+		smp->interval_ns = now - ent->prev_ts;
+		smp->interval_run_time_ns = d_time;
+		smp->interval_run_cnt = d_cnt;
+		smp->run_time_ns += d_time;
+		smp->run_cnt += d_cnt;
+		smp->recursion_misses += info.recursion_misses - ent->prev_recursion_misses;
+		/* only the interval's average cost is known, not each run's */
+		if (d_cnt)
+			smp->hist[prog_sampler_hist_slot(d_time / d_cnt)] += d_cnt;
+
+		ent->prev_run_time_ns = info.run_time_ns;
+		ent->prev_run_cnt = info.run_cnt;
+		ent->prev_recursion_misses = info.recursion_misses;
+		ent->prev_ts = now;
+	}
+
+	return libbpf_err(ret);
+}
+
+int bpf_prog_sampler__prog_cnt(const struct bpf_prog_sampler *s)
+{
+	return s ? s->prog_cnt : 0;
+}
+
+const struct bpf_prog_sample *bpf_prog_sampler__prog(const struct bpf_prog_sampler *s, int idx)
+{
+	if (!s || idx < 0 || idx >= s->prog_cnt)
+		return libbpf_err_ptr(-EINVAL);
+
+	return &s->progs[idx].sample;
+}
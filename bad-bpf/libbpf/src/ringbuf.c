@@ -11,11 +11,14 @@
 #include <stdio.h>
 #include <errno.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
 #include <linux/err.h>
 #include <linux/bpf.h>
 #include <asm/barrier.h>
 #include <sys/mman.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <time.h>
 
 #include "libbpf.h"
@@ -32,12 +35,36 @@ struct ring {
 	int map_fd;
 };
 
+/* Consumer thread started by ring_buffer__start_workers(), draining its own
+ * subset of the manager's rings.
+ */
+struct ringbuf_worker {
+	struct ring **rings;
+	struct epoll_event *events;
+	int ring_cnt;
+	int epoll_fd;
+	int cpu;	/* CPU the thread is pinned to, or -1 */
+	int err;	/* first error hit by the thread */
+	bool started;
+	pthread_t thread;
+};
+
 struct ring_buffer {
 	struct epoll_event *events;
 	struct ring **rings;
 	size_t page_size;
 	int epoll_fd;
 	int ring_cnt;
+	/* busy-poll budget requested by the user and its adaptive value */
+	__u32 busy_poll_us;
+	__u32 spin_us;
+	/* scratch array for ring_buffer__consume_batch() */
+	struct ring_buffer_sample *batch;
+	size_t batch_cap;
+	/* consumer threads, see ring_buffer__start_workers() */
+	struct ringbuf_worker *workers;
+	int worker_cnt;
+	int stop_fd;	/* eventfd telling the workers to exit */
 };
 
 struct user_ring_buffer {
@@ -83,6 +110,9 @@ int ring_buffer__add(struct ring_buffer *rb, int map_fd,
 	void *tmp;
 	int err;
 
+	if (rb->workers)
+		return libbpf_err(-EBUSY);
+
 	memset(&info, 0, sizeof(info));
 
 	err = bpf_map_get_info_by_fd(map_fd, &info, &len);
@@ -176,11 +206,13 @@ void ring_buffer__free(struct ring_buffer *rb)
 	if (!rb)
 		return;
 
+	ring_buffer__stop_workers(rb);
 	for (i = 0; i < rb->ring_cnt; ++i)
 		ringbuf_free_ring(rb, rb->rings[i]);
 	if (rb->epoll_fd >= 0)
 		close(rb->epoll_fd);
 
+	free(rb->batch);
 	free(rb->events);
 	free(rb->rings);
 	free(rb);
@@ -201,6 +233,8 @@ ring_buffer__new(int map_fd, ring_buffer_sample_fn sample_cb, void *ctx,
 		return errno = ENOMEM, NULL;
 
 	rb->page_size = getpagesize();
+	rb->busy_poll_us = OPTS_GET(opts, busy_poll_us, 0);
+	rb->spin_us = rb->busy_poll_us;
 
 	rb->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
 	if (rb->epoll_fd < 0) {
@@ -274,6 +308,119 @@ done:
 	return cnt;
 }
 
+struct ringbuf_batch {
+	ring_buffer_batch_fn cb;
+	void *ctx;
+	struct ring_buffer_sample *samples;
+	size_t cap;
+	size_t commit_bytes;
+};
+
+/* Hand the collected samples to the callback, then give their space (and
+ * that of any discarded records in between) back to the producer with a
+ * single release store.
+ */
+static int ringbuf_flush_batch(struct ring *r, const struct ringbuf_batch *b,
+			       size_t cnt, unsigned long cons_pos)
+{
+	int err = 0;
+
+	if (cnt)
+		err = b->cb(b->ctx, b->samples, cnt);
+	smp_store_release(r->consumer_pos, cons_pos);
+	return err < 0 ? err : 0;
+}
+
+static int64_t ringbuf_process_ring_batch(struct ring *r, const struct ringbuf_batch *b)
+{
+	int *len_ptr, len, err;
+	/* 64-bit to avoid overflow in case of extreme application behavior */
+	int64_t cnt = 0;
+	unsigned long cons_pos, prod_pos, commit_pos;
+	bool got_new_data;
+	size_t n = 0;
+
+	cons_pos = commit_pos = smp_load_acquire(r->consumer_pos);
+	do {
+		got_new_data = false;
+		prod_pos = smp_load_acquire(r->producer_pos);
+		while (cons_pos < prod_pos) {
+			len_ptr = r->data + (cons_pos & r->mask);
+			len = smp_load_acquire(len_ptr);
+
+			/* sample not committed yet, bail out for now */
+			if (len & BPF_RINGBUF_BUSY_BIT)
+				goto done;
+
+			got_new_data = true;
+			cons_pos += roundup_len(len);
+
+			if ((len & BPF_RINGBUF_DISCARD_BIT) == 0) {
+				b->samples[n].data = (void *)len_ptr + BPF_RINGBUF_HDR_SZ;
+				b->samples[n].size = len;
+				n++;
+			}
+
+			if (n < b->cap &&
+			    (!b->commit_bytes || cons_pos - commit_pos < b->commit_bytes))
+				continue;
+
+			err = ringbuf_flush_batch(r, b, n, cons_pos);
+			if (err)
+				return err;
+			cnt += n;
+			n = 0;
+			commit_pos = cons_pos;
+		}
+	} while (got_new_data);
+done:
+	if (cons_pos != commit_pos) {
+		err = ringbuf_flush_batch(r, b, n, cons_pos);
+		if (err)
+			return err;
+		cnt += n;
+	}
+	return cnt;
+}
+
+int ring_buffer__consume_batch(struct ring_buffer *rb, ring_buffer_batch_fn batch_cb,
+			       void *ctx, const struct ring_buffer_batch_opts *opts)
+{
+	struct ringbuf_batch b = {};
+	int64_t err, res = 0;
+	void *tmp;
+	int i;
+
+	if (!OPTS_VALID(opts, ring_buffer_batch_opts) || !batch_cb)
+		return libbpf_err(-EINVAL);
+	if (rb->workers)
+		return libbpf_err(-EBUSY);
+
+	b.cb = batch_cb;
+	b.ctx = ctx;
+	b.cap = OPTS_GET(opts, batch_size, 0) ?: 64;
+	b.commit_bytes = OPTS_GET(opts, commit_bytes, 0);
+
+	if (b.cap > rb->batch_cap) {
+		tmp = libbpf_reallocarray(rb->batch, b.cap, sizeof(*rb->batch));
+		if (!tmp)
+			return libbpf_err(-ENOMEM);
+		rb->batch = tmp;
+		rb->batch_cap = b.cap;
+	}
+	b.samples = rb->batch;
+
+	for (i = 0; i < rb->ring_cnt; i++) {
+		err = ringbuf_process_ring_batch(rb->rings[i], &b);
+		if (err < 0)
+			return libbpf_err(err);
+		res += err;
+	}
+	if (res > INT_MAX)
+		return INT_MAX;
+	return res;
+}
+
 /* Consume available ring buffer(s) data without event polling.
  * Returns number of records consumed across all registered ring buffers (or
  * INT_MAX, whichever is less), or negative number if any of the callbacks
@@ -284,6 +431,9 @@ int ring_buffer__consume(struct ring_buffer *rb)
 	int64_t err, res = 0;
 	int i;
 
+	if (rb->workers)
+		return libbpf_err(-EBUSY);
+
 	for (i = 0; i < rb->ring_cnt; i++) {
 		struct ring *ring = rb->rings[i];
 
@@ -297,6 +447,96 @@ int ring_buffer__consume(struct ring_buffer *rb)
 	return res;
 }
 
+static __u64 ns_elapsed_timespec(const struct timespec *start, const struct timespec *end)
+{
+	__u64 start_ns, end_ns, ns_per_s = 1000000000;
+
+	start_ns = (__u64)start->tv_sec * ns_per_s + start->tv_nsec;
+	end_ns = (__u64)end->tv_sec * ns_per_s + end->tv_nsec;
+
+	return end_ns - start_ns;
+}
+
+static inline void ringbuf_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	asm volatile("pause" ::: "memory");
+#elif defined(__aarch64__)
+	asm volatile("yield" ::: "memory");
+#else
+	asm volatile("" ::: "memory");
+#endif
+}
+
+static bool ringbuf_has_data(const struct ring_buffer *rb)
+{
+	int i;
+
+	for (i = 0; i < rb->ring_cnt; i++) {
+		struct ring *r = rb->rings[i];
+
+		if (smp_load_acquire(r->producer_pos) != smp_load_acquire(r->consumer_pos))
+			return true;
+	}
+	return false;
+}
+
+/* Spin on the producer positions of all rings for up to rb->spin_us, but
+ * no longer than timeout_ms if that is positive, and consume whatever shows
+ * up. Returns the number of records consumed, 0 if the budget ran out first
+ * (with the time spent in *spent_ns), or a negative error from a callback.
+ */
+static int64_t ringbuf_busy_poll(struct ring_buffer *rb, int timeout_ms, __u64 *spent_ns)
+{
+	__u64 budget_ns = (__u64)rb->spin_us * 1000, elapsed = 0;
+	struct timespec start, now;
+	bool capped = false;
+	int64_t err, res;
+	unsigned int iter;
+	int i;
+
+	if (timeout_ms > 0 && (__u64)timeout_ms * 1000000 < budget_ns) {
+		budget_ns = (__u64)timeout_ms * 1000000;
+		capped = true;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iter = 1; ; iter++) {
+		if (ringbuf_has_data(rb)) {
+			res = 0;
+			for (i = 0; i < rb->ring_cnt; i++) {
+				err = ringbuf_process_ring(rb->rings[i]);
+				if (err < 0)
+					return err;
+				res += err;
+			}
+			/* only uncommitted or discarded records, keep spinning */
+			if (res) {
+				/* spinning paid off, grow the budget back */
+				rb->spin_us = min(rb->spin_us * 2, rb->busy_poll_us);
+				return res;
+			}
+		}
+		ringbuf_cpu_relax();
+
+		/* vDSO clock reads are cheap, but not free */
+		if (iter % 64)
+			continue;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		elapsed = ns_elapsed_timespec(&start, &now);
+		if (elapsed >= budget_ns)
+			break;
+	}
+
+	*spent_ns = elapsed;
+	/* nothing arrived, spin less next time; a short timeout says nothing
+	 * about whether the full budget would have paid off
+	 */
+	if (!capped)
+		rb->spin_us = max(rb->spin_us / 2, rb->busy_poll_us / 16 ?: 1);
+	return 0;
+}
+
 /* Poll for available data and consume records, if any are available.
  * Returns number of records consumed (or INT_MAX, whichever is less), or
  * negative number, if any of the registered callbacks returned error.
@@ -305,6 +545,25 @@ int ring_buffer__poll(struct ring_buffer *rb, int timeout_ms)
 {
 	int i, cnt;
 	int64_t err, res = 0;
+	__u64 spent_ns = 0;
+
+	if (rb->workers)
+		return libbpf_err(-EBUSY);
+
+	/* a zero timeout asks for a non-blocking check, don't spin then */
+	if (rb->busy_poll_us && timeout_ms != 0) {
+		res = ringbuf_busy_poll(rb, timeout_ms, &spent_ns);
+		if (res < 0)
+			return libbpf_err(res);
+		if (res)
+			return res > INT_MAX ? INT_MAX : res;
+		/* sleep for whatever is left of the timeout */
+		if (timeout_ms > 0) {
+			timeout_ms -= spent_ns / 1000000;
+			if (timeout_ms < 0)
+				timeout_ms = 0;
+		}
+	}
 
 	cnt = epoll_wait(rb->epoll_fd, rb->events, rb->ring_cnt, timeout_ms);
 	if (cnt < 0)
@@ -324,6 +583,194 @@ int ring_buffer__poll(struct ring_buffer *rb, int timeout_ms)
 	return res;
 }
 
+static void *ringbuf_worker_fn(void *arg)
+{
+	struct ringbuf_worker *w = arg;
+	int64_t err;
+	int i, cnt;
+
+	for (;;) {
+		cnt = epoll_wait(w->epoll_fd, w->events, w->ring_cnt + 1, -1);
+		if (cnt < 0) {
+			if (errno == EINTR)
+				continue;
+			w->err = -errno;
+			return NULL;
+		}
+
+		for (i = 0; i < cnt; i++) {
+			int ring_id = w->events[i].data.fd;
+
+			/* stop_fd became readable, ring_buffer__stop_workers() */
+			if (ring_id < 0)
+				return NULL;
+
+			err = ringbuf_process_ring(w->rings[ring_id]);
+			if (err < 0) {
+				w->err = err;
+				return NULL;
+			}
+		}
+	}
+}
+
+static void ringbuf_free_worker(struct ringbuf_worker *w)
+{
+	if (w->epoll_fd >= 0)
+		close(w->epoll_fd);
+	free(w->events);
+	free(w->rings);
+}
+
+static int ringbuf_start_worker(struct ring_buffer *rb, struct ringbuf_worker *w)
+{
+	struct epoll_event e = {};
+	pthread_attr_t attr;
+	cpu_set_t cpus;
+	int i, err;
+
+	w->events = calloc(w->ring_cnt + 1, sizeof(*w->events));
+	if (!w->events)
+		return -ENOMEM;
+
+	w->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (w->epoll_fd < 0)
+		return -errno;
+
+	/* a ring's map fd can be in several epoll sets; only this worker
+	 * consumes it while the pool runs
+	 */
+	for (i = 0; i < w->ring_cnt; i++) {
+		e.events = EPOLLIN;
+		e.data.fd = i;
+		if (epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->rings[i]->map_fd, &e) < 0)
+			return -errno;
+	}
+	e.events = EPOLLIN;
+	e.data.fd = -1;
+	if (epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, rb->stop_fd, &e) < 0)
+		return -errno;
+
+	err = pthread_attr_init(&attr);
+	if (err)
+		return -err;
+	/* pin before the thread runs, so everything it allocates (including
+	 * whatever the sample callbacks allocate) is local to its NUMA node
+	 */
+	if (w->cpu >= 0) {
+		CPU_ZERO(&cpus);
+		CPU_SET(w->cpu, &cpus);
+		err = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+	}
+	if (!err)
+		err = pthread_create(&w->thread, &attr, ringbuf_worker_fn, w);
+	pthread_attr_destroy(&attr);
+	if (err)
+		return -err;
+
+	w->started = true;
+	return 0;
+}
+
+int ring_buffer__start_workers(struct ring_buffer *rb,
+			       const struct ring_buffer_workers_opts *opts)
+{
+	const int *cpus;
+	size_t cpu_cnt;
+	int i, n, err;
+
+	if (!OPTS_VALID(opts, ring_buffer_workers_opts))
+		return libbpf_err(-EINVAL);
+	if (rb->workers)
+		return libbpf_err(-EBUSY);
+
+	n = OPTS_GET(opts, worker_cnt, 0);
+	cpus = OPTS_GET(opts, cpus, NULL);
+	cpu_cnt = OPTS_GET(opts, cpu_cnt, 0);
+	if (n < 0 || (cpus && !cpu_cnt) || !rb->ring_cnt)
+		return libbpf_err(-EINVAL);
+	if (!n || n > rb->ring_cnt)
+		n = rb->ring_cnt;
+
+	rb->stop_fd = eventfd(0, EFD_CLOEXEC);
+	if (rb->stop_fd < 0)
+		return libbpf_err(-errno);
+
+	rb->workers = calloc(n, sizeof(*rb->workers));
+	if (!rb->workers) {
+		err = -ENOMEM;
+		goto err_out;
+	}
+	rb->worker_cnt = n;
+
+	for (i = 0; i < n; i++) {
+		rb->workers[i].epoll_fd = -1;
+		rb->workers[i].cpu = cpus ? cpus[i % cpu_cnt] : -1;
+	}
+
+	/* spread rings round-robin: ring i goes to worker i % n */
+	for (i = 0; i < rb->ring_cnt; i++) {
+		struct ringbuf_worker *w = &rb->workers[i % n];
+		void *tmp;
+
+		tmp = libbpf_reallocarray(w->rings, w->ring_cnt + 1, sizeof(*w->rings));
+		if (!tmp) {
+			err = -ENOMEM;
+			goto err_out;
+		}
+		w->rings = tmp;
+		w->rings[w->ring_cnt++] = rb->rings[i];
+	}
+
+	for (i = 0; i < n; i++) {
+		err = ringbuf_start_worker(rb, &rb->workers[i]);
+		if (err) {
+			pr_warn("ringbuf: failed to start consumer thread %d: %d\n", i, err);
+			goto err_out;
+		}
+	}
+	return 0;
+
+err_out:
+	if (rb->workers) {
+		ring_buffer__stop_workers(rb);
+	} else {
+		close(rb->stop_fd);
+		rb->stop_fd = -1;
+	}
+	return libbpf_err(err);
+}
+
+int ring_buffer__stop_workers(struct ring_buffer *rb)
+{
+	__u64 one = 1;
+	int i, err = 0;
+
+	if (!rb->workers)
+		return 0;
+
+	/* eventfd stays readable, so this wakes up every worker */
+	if (write(rb->stop_fd, &one, sizeof(one)) != sizeof(one))
+		pr_warn("ringbuf: failed to signal consumer threads: %d\n", -errno);
+
+	for (i = 0; i < rb->worker_cnt; i++) {
+		struct ringbuf_worker *w = &rb->workers[i];
+
+		if (w->started)
+			pthread_join(w->thread, NULL);
+		if (!err)
+			err = w->err;
+		ringbuf_free_worker(w);
+	}
+
+	free(rb->workers);
+	rb->workers = NULL;
+	rb->worker_cnt = 0;
+	close(rb->stop_fd);
+	rb->stop_fd = -1;
+	return libbpf_err(err);
+}
+
 /* Get an fd that can be used to sleep until data is available in the ring(s) */
 int ring_buffer__epoll_fd(const struct ring_buffer *rb)
 {
@@ -509,14 +956,20 @@ err_out:
 	return errno = -err, NULL;
 }
 
+static struct ringbuf_hdr *user_ringbuf_hdr(struct user_ring_buffer *rb, void *sample)
+{
+	uintptr_t hdr_offset;
+
+	hdr_offset = rb->mask + 1 + (sample - rb->data) - BPF_RINGBUF_HDR_SZ;
+	return rb->data + (hdr_offset & rb->mask);
+}
+
 static void user_ringbuf_commit(struct user_ring_buffer *rb, void *sample, bool discard)
 {
 	__u32 new_len;
 	struct ringbuf_hdr *hdr;
-	uintptr_t hdr_offset;
 
-	hdr_offset = rb->mask + 1 + (sample - rb->data) - BPF_RINGBUF_HDR_SZ;
-	hdr = rb->data + (hdr_offset & rb->mask);
+	hdr = user_ringbuf_hdr(rb, sample);
 
 	new_len = hdr->len & ~BPF_RINGBUF_BUSY_BIT;
 	if (discard)
@@ -579,14 +1032,75 @@ void *user_ring_buffer__reserve(struct user_ring_buffer *rb, __u32 size)
 	return (void *)rb->data + ((prod_pos + BPF_RINGBUF_HDR_SZ) & rb->mask);
 }
 
-static __u64 ns_elapsed_timespec(const struct timespec *start, const struct timespec *end)
+int user_ring_buffer__reserve_batch(struct user_ring_buffer *rb, const __u32 *sizes,
+				    void **samples, __u32 cnt)
 {
-	__u64 start_ns, end_ns, ns_per_s = 1000000000;
+	/* 64-bit to avoid overflow in case of extreme application behavior */
+	__u64 cons_pos, prod_pos, total_size = 0;
+	__u32 avail_size, max_size, i;
+	struct ringbuf_hdr *hdr;
 
-	start_ns = (__u64)start->tv_sec * ns_per_s + start->tv_nsec;
-	end_ns = (__u64)end->tv_sec * ns_per_s + end->tv_nsec;
+	if (!cnt)
+		return libbpf_err(-EINVAL);
 
-	return end_ns - start_ns;
+	max_size = rb->mask + 1;
+	for (i = 0; i < cnt; i++) {
+		/* The top two bits are used as special flags */
+		if (sizes[i] & (BPF_RINGBUF_BUSY_BIT | BPF_RINGBUF_DISCARD_BIT))
+			return libbpf_err(-E2BIG);
+		total_size += (sizes[i] + BPF_RINGBUF_HDR_SZ + 7) / 8 * 8;
+		if (total_size > max_size)
+			return libbpf_err(-E2BIG);
+	}
+
+	/* Synchronizes with smp_store_release() in __bpf_user_ringbuf_peek() in
+	 * the kernel.
+	 */
+	cons_pos = smp_load_acquire(rb->consumer_pos);
+	/* Synchronizes with smp_store_release() in user_ringbuf_commit() */
+	prod_pos = smp_load_acquire(rb->producer_pos);
+
+	avail_size = max_size - (prod_pos - cons_pos);
+	if (avail_size < total_size)
+		return libbpf_err(-ENOSPC);
+
+	/* All headers are written busy before the producer position moves,
+	 * so the kernel stops at the first sample until the batch is
+	 * submitted.
+	 */
+	for (i = 0; i < cnt; i++) {
+		hdr = rb->data + (prod_pos & rb->mask);
+		hdr->len = sizes[i] | BPF_RINGBUF_BUSY_BIT;
+		hdr->pad = 0;
+		samples[i] = (void *)rb->data + ((prod_pos + BPF_RINGBUF_HDR_SZ) & rb->mask);
+		prod_pos += (sizes[i] + BPF_RINGBUF_HDR_SZ + 7) / 8 * 8;
+	}
+
+	/* Synchronizes with smp_load_acquire() in __bpf_user_ringbuf_peek() in
+	 * the kernel.
+	 */
+	smp_store_release(rb->producer_pos, prod_pos);
+	return 0;
+}
+
+void user_ring_buffer__submit_batch(struct user_ring_buffer *rb, void **samples, __u32 cnt)
+{
+	struct ringbuf_hdr *hdr;
+	__u32 i;
+
+	if (!cnt)
+		return;
+
+	/* The kernel consumes samples in order and cannot look past the
+	 * first one while it is busy. Clearing the busy bit of samples
+	 * 1..cnt-1 with plain stores and then publishing sample 0 with
+	 * release semantics makes the whole batch visible at once.
+	 */
+	for (i = cnt - 1; i > 0; i--) {
+		hdr = user_ringbuf_hdr(rb, samples[i]);
+		__atomic_store_n(&hdr->len, hdr->len & ~BPF_RINGBUF_BUSY_BIT, __ATOMIC_RELAXED);
+	}
+	user_ringbuf_commit(rb, samples[0], false);
 }
 
 void *user_ring_buffer__reserve_blocking(struct user_ring_buffer *rb, __u32 size, int timeout_ms)
@@ -7,6 +7,7 @@
 #include <libelf.h>
 #include <gelf.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <linux/ptrace.h>
 #include <linux/kernel.h>
 
@@ -186,6 +187,16 @@
  * USDT attachments by taking into account USDT spec string *and* USDT cookie
  * value, which would complicated spec ID accounting significantly for little
  * gain.
+ *
+ * Attaching the same USDT to many processes running one binary (e.g., libc
+ * or a fleet of JVMs) would otherwise re-open the ELF and re-parse its USDT
+ * notes, specs, and program headers for every PID, even though none of that
+ * depends on the process. So usdt_manager keeps a per-binary cache of parsed
+ * notes, specs, and ELF segments, keyed by (device, inode, mtime) of the
+ * binary. Only the per-PID part, mapping file offsets to memory segments for
+ * shared libraries on kernels without BPF cookie, is redone on each attach.
+ * Cache entries live as long as usdt_manager and are replaced when the
+ * binary's mtime changes.
  */
 
 #define USDT_BASE_SEC ".stapsdt.base"
@@ -240,6 +251,30 @@ struct usdt_target {
 	const char *spec_str;
 };
 
+struct usdt_bin_note {
+	struct usdt_note note;
+	/* parsed lazily on first match, with zero USDT cookie */
+	struct usdt_spec spec;
+	bool spec_parsed;
+};
+
+/* USDT notes and ELF segments parsed from one binary, see usdt_manager_get_bin() */
+struct usdt_bin {
+	dev_t dev;
+	ino_t ino;
+	struct timespec mtime;
+
+	int e_type;
+	long base_addr;
+	struct elf_seg *segs;
+	size_t seg_cnt;
+
+	/* copy of USDT notes section, usdt_note strings point into it */
+	char *note_data;
+	struct usdt_bin_note *notes;
+	size_t note_cnt;
+};
+
 struct usdt_manager {
 	struct bpf_map *specs_map;
 	struct bpf_map *ip_to_spec_id_map;
@@ -251,6 +286,9 @@ struct usdt_manager {
 	bool has_bpf_cookie;
 	bool has_sema_refcnt;
 	bool has_uprobe_multi;
+
+	struct usdt_bin **bins;
+	size_t bin_cnt;
 };
 
 struct usdt_manager *usdt_manager_new(struct bpf_object *obj)
@@ -293,11 +331,27 @@ struct usdt_manager *usdt_manager_new(struct bpf_object *obj)
 	return man;
 }
 
+static void usdt_bin_free(struct usdt_bin *bin)
+{
+	if (!bin)
+		return;
+
+	free(bin->segs);
+	free(bin->note_data);
+	free(bin->notes);
+	free(bin);
+}
+
 void usdt_manager_free(struct usdt_manager *man)
 {
+	size_t i;
+
 	if (IS_ERR_OR_NULL(man))
 		return;
 
+	for (i = 0; i < man->bin_cnt; i++)
+		usdt_bin_free(man->bins[i]);
+	free(man->bins);
 	free(man->free_spec_ids);
 	free(man);
 }
@@ -575,14 +629,13 @@ static int parse_usdt_note(Elf *elf, const char *path, GElf_Nhdr *nhdr,
 
 static int parse_usdt_spec(struct usdt_spec *spec, const struct usdt_note *note, __u64 usdt_cookie);
 
-static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *path, pid_t pid,
-				const char *usdt_provider, const char *usdt_name, __u64 usdt_cookie,
-				struct usdt_target **out_targets, size_t *out_target_cnt)
+/* Parse USDT notes section, ELF program headers and .stapsdt.base of
+ * a binary into *bin*. On error, *bin* may be partially filled and has to
+ * be freed by the caller.
+ */
+static int usdt_bin_parse(Elf *elf, const char *path, struct usdt_bin *bin)
 {
-	size_t off, name_off, desc_off, seg_cnt = 0, vma_seg_cnt = 0, target_cnt = 0;
-	struct elf_seg *segs = NULL, *vma_segs = NULL;
-	struct usdt_target *targets = NULL, *target;
-	long base_addr = 0;
+	size_t off, name_off, desc_off;
 	Elf_Scn *notes_scn, *base_scn;
 	GElf_Shdr base_shdr, notes_shdr;
 	GElf_Ehdr ehdr;
@@ -590,9 +643,6 @@ static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *
 	Elf_Data *data;
 	int err;
 
-	*out_targets = NULL;
-	*out_target_cnt = 0;
-
 	err = find_elf_sec_by_name(elf, USDT_NOTE_SEC, &notes_shdr, &notes_scn);
 	if (err) {
 		pr_warn("usdt: no USDT notes section (%s) found in '%s'\n", USDT_NOTE_SEC, path);
@@ -603,34 +653,151 @@ static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *
 		pr_warn("usdt: invalid USDT notes section (%s) in '%s'\n", USDT_NOTE_SEC, path);
 		return -EINVAL;
 	}
+	bin->e_type = ehdr.e_type;
 
-	err = parse_elf_segs(elf, path, &segs, &seg_cnt);
+	err = parse_elf_segs(elf, path, &bin->segs, &bin->seg_cnt);
 	if (err) {
 		pr_warn("usdt: failed to process ELF program segments for '%s': %d\n", path, err);
-		goto err_out;
+		return err;
 	}
 
 	/* .stapsdt.base ELF section is optional, but is used for prelink
-	 * offset compensation (see a big comment further below)
+	 * offset compensation (see a big comment in collect_usdt_targets())
 	 */
 	if (find_elf_sec_by_name(elf, USDT_BASE_SEC, &base_shdr, &base_scn) == 0)
-		base_addr = base_shdr.sh_addr;
+		bin->base_addr = base_shdr.sh_addr;
 
 	data = elf_getdata(notes_scn, 0);
+	if (!data)
+		return 0;
+
+	/* keep our own copy of notes, so that ELF can be closed right away */
+	bin->note_data = malloc(data->d_size ?: 1);
+	if (!bin->note_data)
+		return -ENOMEM;
+	memcpy(bin->note_data, data->d_buf, data->d_size);
+
 	off = 0;
 	while ((off = gelf_getnote(data, off, &nhdr, &name_off, &desc_off)) > 0) {
-		long usdt_abs_ip, usdt_rel_ip, usdt_sema_off = 0;
-		struct usdt_note note;
-		struct elf_seg *seg = NULL;
+		struct usdt_bin_note *bin_note;
 		void *tmp;
 
-		err = parse_usdt_note(elf, path, &nhdr, data->d_buf, name_off, desc_off, &note);
+		tmp = libbpf_reallocarray(bin->notes, bin->note_cnt + 1, sizeof(*bin->notes));
+		if (!tmp)
+			return -ENOMEM;
+		bin->notes = tmp;
+
+		bin_note = &bin->notes[bin->note_cnt];
+		memset(bin_note, 0, sizeof(*bin_note));
+
+		err = parse_usdt_note(elf, path, &nhdr, bin->note_data, name_off, desc_off,
+				      &bin_note->note);
 		if (err)
-			goto err_out;
+			return err;
 
-		if (strcmp(note.provider, usdt_provider) != 0 || strcmp(note.name, usdt_name) != 0)
-			continue;
+		bin->note_cnt++;
+	}
+
+	return 0;
+}
+
+/* Find parsed USDT notes and segments of the binary at *path*, parsing
+ * and caching them in usdt_manager on first use. Binary is identified by
+ * device, inode, and modification time, so a rebuilt or replaced binary
+ * gets re-parsed.
+ */
+static struct usdt_bin *usdt_manager_get_bin(struct usdt_manager *man, const char *path)
+{
+	struct usdt_bin *bin = NULL;
+	struct elf_fd elf_fd;
+	struct stat st;
+	size_t i;
+	void *tmp;
+	int err;
+
+	/* if stat() fails, elf_open() below will fail and report it */
+	if (stat(path, &st) == 0) {
+		for (i = 0; i < man->bin_cnt; i++) {
+			bin = man->bins[i];
+			if (bin->dev != st.st_dev || bin->ino != st.st_ino)
+				continue;
+			if (bin->mtime.tv_sec == st.st_mtim.tv_sec &&
+			    bin->mtime.tv_nsec == st.st_mtim.tv_nsec)
+				return bin;
+
+			/* binary was modified in place, drop stale entry */
+			usdt_bin_free(bin);
+			man->bins[i] = man->bins[--man->bin_cnt];
+			break;
+		}
+	}
+
+	err = elf_open(path, &elf_fd);
+	if (err)
+		return ERR_PTR(err);
+
+	err = sanity_check_usdt_elf(elf_fd.elf, path);
+	if (err)
+		goto err_out;
+
+	bin = calloc(1, sizeof(*bin));
+	if (!bin) {
+		err = -ENOMEM;
+		goto err_out;
+	}
+
+	/* key by the file we actually parsed, not the one we stat()'ed */
+	if (fstat(elf_fd.fd, &st)) {
+		err = -errno;
+		goto err_out;
+	}
+	bin->dev = st.st_dev;
+	bin->ino = st.st_ino;
+	bin->mtime = st.st_mtim;
+
+	err = usdt_bin_parse(elf_fd.elf, path, bin);
+	if (err)
+		goto err_out;
 
+	tmp = libbpf_reallocarray(man->bins, man->bin_cnt + 1, sizeof(*man->bins));
+	if (!tmp) {
+		err = -ENOMEM;
+		goto err_out;
+	}
+	man->bins = tmp;
+	man->bins[man->bin_cnt++] = bin;
+
+	elf_close(&elf_fd);
+	return bin;
+
+err_out:
+	usdt_bin_free(bin);
+	elf_close(&elf_fd);
+	return ERR_PTR(err);
+}
+
+static int collect_usdt_targets(struct usdt_manager *man, struct usdt_bin *bin, const char *path,
+				pid_t pid, const char *usdt_provider, const char *usdt_name,
+				__u64 usdt_cookie, struct usdt_target **out_targets,
+				size_t *out_target_cnt)
+{
+	size_t vma_seg_cnt = 0, target_cnt = 0;
+	struct usdt_target *targets = NULL, *target;
+	struct elf_seg *vma_segs = NULL;
+	int i, err = 0;
+
+	*out_targets = NULL;
+	*out_target_cnt = 0;
+
+	for (i = 0; i < bin->note_cnt; i++) {
+		struct usdt_bin_note *bin_note = &bin->notes[i];
+		const struct usdt_note *note = &bin_note->note;
+		long usdt_abs_ip, usdt_rel_ip, usdt_sema_off = 0;
+		struct elf_seg *seg = NULL;
+		void *tmp;
+
+		if (strcmp(note->provider, usdt_provider) != 0 || strcmp(note->name, usdt_name) != 0)
+			continue;
 		/* We need to compensate "prelink effect". See [0] for details,
 		 * relevant parts quoted here:
 		 *
@@ -658,16 +825,16 @@ static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *
 		 *
 		 *   [0] https://sourceware.org/systemtap/wiki/UserSpaceProbeImplementation
 		 */
-		usdt_abs_ip = note.loc_addr;
-		if (base_addr)
-			usdt_abs_ip += base_addr - note.base_addr;
+		usdt_abs_ip = note->loc_addr;
+		if (bin->base_addr)
+			usdt_abs_ip += bin->base_addr - note->base_addr;
 
 		/* When attaching uprobes (which is what USDTs basically are)
 		 * kernel expects file offset to be specified, not a relative
 		 * virtual address, so we need to translate virtual address to
 		 * file offset, for both ET_EXEC and ET_DYN binaries.
 		 */
-		seg = find_elf_seg(segs, seg_cnt, usdt_abs_ip);
+		seg = find_elf_seg(bin->segs, bin->seg_cnt, usdt_abs_ip);
 		if (!seg) {
 			err = -ESRCH;
 			pr_warn("usdt: failed to find ELF program segment for '%s:%s' in '%s' at IP 0x%lx\n",
@@ -684,7 +851,7 @@ static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *
 		/* translate from virtual address to file offset */
 		usdt_rel_ip = usdt_abs_ip - seg->start + seg->offset;
 
-		if (ehdr.e_type == ET_DYN && !man->has_bpf_cookie) {
+		if (bin->e_type == ET_DYN && !man->has_bpf_cookie) {
 			/* If we don't have BPF cookie support but need to
 			 * attach to a shared library, we'll need to know and
 			 * record absolute addresses of attach points due to
@@ -726,12 +893,12 @@ static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *
 		}
 
 		pr_debug("usdt: probe for '%s:%s' in %s '%s': addr 0x%lx base 0x%lx (resolved abs_ip 0x%lx rel_ip 0x%lx) args '%s' in segment [0x%lx, 0x%lx) at offset 0x%lx\n",
-			 usdt_provider, usdt_name, ehdr.e_type == ET_EXEC ? "exec" : "lib ", path,
-			 note.loc_addr, note.base_addr, usdt_abs_ip, usdt_rel_ip, note.args,
+			 usdt_provider, usdt_name, bin->e_type == ET_EXEC ? "exec" : "lib ", path,
+			 note->loc_addr, note->base_addr, usdt_abs_ip, usdt_rel_ip, note->args,
 			 seg ? seg->start : 0, seg ? seg->end : 0, seg ? seg->offset : 0);
 
 		/* Adjust semaphore address to be a file offset */
-		if (note.sema_addr) {
+		if (note->sema_addr) {
 			if (!man->has_sema_refcnt) {
 				pr_warn("usdt: kernel doesn't support USDT semaphore refcounting for '%s:%s' in '%s'\n",
 					usdt_provider, usdt_name, path);
@@ -739,26 +906,26 @@ static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *
 				goto err_out;
 			}
 
-			seg = find_elf_seg(segs, seg_cnt, note.sema_addr);
+			seg = find_elf_seg(bin->segs, bin->seg_cnt, note->sema_addr);
 			if (!seg) {
 				err = -ESRCH;
 				pr_warn("usdt: failed to find ELF loadable segment with semaphore of '%s:%s' in '%s' at 0x%lx\n",
-					usdt_provider, usdt_name, path, note.sema_addr);
+					usdt_provider, usdt_name, path, note->sema_addr);
 				goto err_out;
 			}
 			if (seg->is_exec) {
 				err = -ESRCH;
 				pr_warn("usdt: matched ELF binary '%s' segment [0x%lx, 0x%lx] for semaphore of '%s:%s' at 0x%lx is executable\n",
 					path, seg->start, seg->end, usdt_provider, usdt_name,
-					note.sema_addr);
+					note->sema_addr);
 				goto err_out;
 			}
 
-			usdt_sema_off = note.sema_addr - seg->start + seg->offset;
+			usdt_sema_off = note->sema_addr - seg->start + seg->offset;
 
 			pr_debug("usdt: sema  for '%s:%s' in %s '%s': addr 0x%lx base 0x%lx (resolved 0x%lx) in segment [0x%lx, 0x%lx] at offset 0x%lx\n",
-				 usdt_provider, usdt_name, ehdr.e_type == ET_EXEC ? "exec" : "lib ",
-				 path, note.sema_addr, note.base_addr, usdt_sema_off,
+				 usdt_provider, usdt_name, bin->e_type == ET_EXEC ? "exec" : "lib ",
+				 path, note->sema_addr, note->base_addr, usdt_sema_off,
 				 seg->start, seg->end, seg->offset);
 		}
 
@@ -777,14 +944,19 @@ static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *
 		target->rel_ip = usdt_rel_ip;
 		target->sema_off = usdt_sema_off;
 
-		/* notes.args references strings from ELF itself, so they can
-		 * be referenced safely until elf_end() call
+		/* note->args references strings from cached USDT notes, so they
+		 * can be referenced safely while usdt_manager is alive
 		 */
-		target->spec_str = note.args;
+		target->spec_str = note->args;
 
-		err = parse_usdt_spec(&target->spec, &note, usdt_cookie);
-		if (err)
-			goto err_out;
+		if (!bin_note->spec_parsed) {
+			err = parse_usdt_spec(&bin_note->spec, note, 0);
+			if (err)
+				goto err_out;
+			bin_note->spec_parsed = true;
+		}
+		target->spec = bin_note->spec;
+		target->spec.usdt_cookie = usdt_cookie;
 
 		target_cnt++;
 	}
@@ -794,7 +966,6 @@ static int collect_usdt_targets(struct usdt_manager *man, Elf *elf, const char *
 	err = target_cnt;
 
 err_out:
-	free(segs);
 	free(vma_segs);
 	if (err < 0)
 		free(targets);
@@ -964,19 +1135,15 @@ struct bpf_link *usdt_manager_attach_usdt(struct usdt_manager *man, const struct
 	struct bpf_link_usdt *link = NULL;
 	struct usdt_target *targets = NULL;
 	__u64 *cookies = NULL;
-	struct elf_fd elf_fd;
+	struct usdt_bin *bin;
 	size_t target_cnt;
 
 	spec_map_fd = bpf_map__fd(man->specs_map);
 	ip_map_fd = bpf_map__fd(man->ip_to_spec_id_map);
 
-	err = elf_open(path, &elf_fd);
-	if (err)
-		return libbpf_err_ptr(err);
-
-	err = sanity_check_usdt_elf(elf_fd.elf, path);
-	if (err)
-		goto err_out;
+	bin = usdt_manager_get_bin(man, path);
+	if (IS_ERR(bin))
+		return libbpf_err_ptr(PTR_ERR(bin));
 
 	/* normalize PID filter */
 	if (pid < 0)
@@ -987,7 +1154,7 @@ struct bpf_link *usdt_manager_attach_usdt(struct usdt_manager *man, const struct
 	/* discover USDT in given binary, optionally limiting
 	 * activations to a given PID, if pid > 0
 	 */
-	err = collect_usdt_targets(man, elf_fd.elf, path, pid, usdt_provider, usdt_name,
+	err = collect_usdt_targets(man, bin, path, pid, usdt_provider, usdt_name,
 				   usdt_cookie, &targets, &target_cnt);
 	if (err <= 0) {
 		err = (err == 0) ? -ENOENT : err;
@@ -1111,7 +1278,6 @@ struct bpf_link *usdt_manager_attach_usdt(struct usdt_manager *man, const struct
 
 	free(targets);
 	hashmap__free(specs_hash);
-	elf_close(&elf_fd);
 	return &link->link;
 
 err_out:
@@ -1123,7 +1289,6 @@ err_out:
 		bpf_link__destroy(&link->link);
 	free(targets);
 	hashmap__free(specs_hash);
-	elf_close(&elf_fd);
 	return libbpf_err_ptr(err);
 }
 
@@ -10,10 +10,25 @@ const char fentry_msg[16] = "fentry_execve";
 const char tp_msg[16] = "tp_execve";
 const char tp_btf_exec_msg[16] = "tp_btf_exec";
 const char raw_tp_exec_msg[16] = "raw_tp_exec";
+
+// Built against bad-bpf's libbpf (make LIBBPF_SRC=...), `output` becomes a
+// BPF ring buffer of map_extra bytes on kernels that have them and
+// bpf_event_output() picks the matching helper. hello.c reads it with
+// perf_buffer either way.
+#ifdef bpf_event_output
+#define OUTPUT_RINGBUF_SIZE (256 * 1024)
+#else
+#define bpf_event_output(ctx, map, data, size) \
+   bpf_perf_event_output(ctx, map, BPF_F_CURRENT_CPU, data, size)
+#endif
+
 struct {
     __uint(type, BPF_MAP_TYPE_PERF_EVENT_ARRAY);
     __uint(key_size, sizeof(u32));
     __uint(value_size, sizeof(u32));
+#ifdef OUTPUT_RINGBUF_SIZE
+    __uint(map_extra, OUTPUT_RINGBUF_SIZE);
+#endif
 } output SEC(".maps");
 
 struct {
@@ -36,7 +51,7 @@ int BPF_KPROBE_SYSCALL(kprobe_sys_execve, const char *pathname)
    bpf_get_current_comm(&data.command, sizeof(data.command));
    bpf_probe_read_user(&data.path, sizeof(data.path), pathname);
 
-   bpf_perf_event_output(ctx, &output, BPF_F_CURRENT_CPU, &data, sizeof(data));
+   bpf_event_output(ctx, &output, &data, sizeof(data));
    return 0;
 }
 
@@ -57,7 +72,7 @@ int BPF_KPROBE(kprobe_do_execve, struct filename *filename) {
 
    bpf_printk("%s: filename->name: %s", kprobe_msg, name);
    
-   bpf_perf_event_output(ctx, &output, BPF_F_CURRENT_CPU, &data, sizeof(data));
+   bpf_event_output(ctx, &output, &data, sizeof(data));
    return 0;   
 }
 #endif
@@ -80,7 +95,7 @@ int BPF_PROG(fentry_execve, struct filename *filename) {
 
    bpf_printk("%s: filename->name: %s", fentry_msg, name);
 
-   bpf_perf_event_output(ctx, &output, BPF_F_CURRENT_CPU, &data, sizeof(data));
+   bpf_event_output(ctx, &output, &data, sizeof(data));
    return 0;   
 }
 #endif
@@ -122,7 +137,7 @@ int tp_sys_enter_execve(struct my_syscalls_enter_execve *ctx) {
    bpf_get_current_comm(&data.command, sizeof(data.command));
    bpf_probe_read_user(&data.path, sizeof(data.path), ctx->filename_ptr);  
 
-   bpf_perf_event_output(ctx, &output, BPF_F_CURRENT_CPU, &data, sizeof(data));   
+   bpf_event_output(ctx, &output, &data, sizeof(data));   
    return 0;
 }
 
@@ -143,7 +158,7 @@ int tp_btf_exec(struct trace_event_raw_sched_process_exec *ctx)
    // bpf_printk("%s %d\n", tp_btf_exec_msg, pid);
    // bpf_probe_read_kernel_str(&data.command, sizeof(data.command), ctx->pid); 
 
-   bpf_perf_event_output(ctx, &output, BPF_F_CURRENT_CPU, &data, sizeof(data));
+   bpf_event_output(ctx, &output, &data, sizeof(data));
    return 0;
 }
 
@@ -157,7 +172,7 @@ int raw_tp_exec(struct bpf_raw_tracepoint_args *ctx)
    data.pid = bpf_get_current_pid_tgid() >> 32;
    data.uid = bpf_get_current_uid_gid() & 0xFFFFFFFF;
 
-   bpf_perf_event_output(ctx, &output, BPF_F_CURRENT_CPU, &data, sizeof(data));
+   bpf_event_output(ctx, &output, &data, sizeof(data));
    return 0;
 }
 
@@ -55,6 +55,7 @@ static bool bump_memlock_rlimit(void)
  * 1. Enables strict libbpf mode (more errors, fewer silent fallbacks).
  * 2. Raises RLIMIT_MEMLOCK for older kernels.
  * 3. Installs clean shutdown signal handlers.
+ * 4. Ignores SIGPIPE.
  *
  * Returns true if everything succeeded.
  */
@@ -79,5 +80,13 @@ bool setup(void)
         return false;
     }
 
+    // A control socket client that hangs up before reading its reply must
+    // not kill the daemon (and leave its TC filters attached): writing to it
+    // fails with EPIPE instead.
+    if (signal(SIGPIPE, SIG_IGN) == SIG_ERR) {
+        perror("signal(SIGPIPE)");
+        return false;
+    }
+
     return true;
 }
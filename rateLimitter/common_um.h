@@ -4,6 +4,16 @@
 
 #include <signal.h>
 #include <stdbool.h>
+#include <bpf/libbpf.h>
+
+// Built against the libbpf bundled in this repository
+// (make LIBBPF_SRC=../bad-bpf/libbpf/src), whose extensions such as ring
+// buffer busy polling no upstream libbpf release has, whatever its version.
+#ifdef LIBBPF_HAS_RL_EXT
+#define RL_HAVE_LIBBPF_EXT 1
+#else
+#define RL_HAVE_LIBBPF_EXT 0
+#endif
 
 extern volatile sig_atomic_t exiting;
 
@@ -12,6 +22,7 @@ extern volatile sig_atomic_t exiting;
  *  - sets libbpf strict mode
  *  - bumps RLIMIT_MEMLOCK
  *  - installs SIGINT/SIGTERM handlers that flip `exiting`
+ *  - ignores SIGPIPE
  *
  * returns true on success, false on failure
  */
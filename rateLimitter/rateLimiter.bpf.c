@@ -4,31 +4,51 @@
 #include <bpf/bpf_tracing.h>
 #include <bpf/bpf_endian.h>
 
+#include "rateLimiter.h"
+
 char LICENSE[] SEC("license") = "Dual BSD/GPL";
 
 // ============================
-// Config via .rodata
+// Config via .data
 // ============================
 
-// These variables are:
-    // placed in the ELF section .rodata
-    // treated as read-only by the kernel
-    // made available to userspace through the BPF skeleton
+// The policy is placed in the ELF section .data rather than .rodata: the
+// skeleton mmap()s it, so the daemon can rewrite it (e.g. on `set-policy`
+// from the control socket) without reloading the program. Each packet takes
+// a snapshot of it on entry. A snapshot is several loads, so the daemon never
+// writes a copy that may be in use: it fills in the other one, flips
+// policy_idx with a single store, and waits for an RCU grace period before
+// the old copy may be rewritten.
+volatile struct rl_policy policies[RL_POLICY_SLOTS] = {
+    [0] = {
+        // Packets per second allowed per source IP
+        .rate_pps = 1000,
+        // Token bucket size / burst
+        .burst = 200,
+        // Tokens a CPU moves from the aggregate bucket into its local cache
+        // at once. Bigger batches mean fewer trips to the shared
+        // (spin-locked) bucket, at the cost of up to agg_batch * nr_cpus
+        // tokens sitting idle in per-CPU caches.
+        .agg_batch = 16,
+    },
+};
+volatile __u32 policy_idx;
 
-    // Packets per second allowed per source IP
-const volatile int rate_limit_pps = 1000;
-// Token bucket size / burst
-const volatile int burst = 200;
+// Counts in topn_map are halved this often, so the summary follows the
+// sources being limited right now rather than all-time offenders.
+const volatile __u64 topn_decay_ns = 1000000000ULL;
 
-// ============================
-// Event struct for ring buffer
-// ============================
+// Clock used for bucket refills (enum rl_refill_mode). With RL_REFILL_TIMER
+// or RL_REFILL_USER packets read the time from `epoch` instead of calling
+// bpf_ktime_get_ns(), so it only moves in steps of refill_quantum_ns and
+// all packets within one quantum skip the refill math entirely.
+const volatile __u32 refill_mode = RL_REFILL_KTIME;
+const volatile __u64 refill_quantum_ns = 10000000ULL;
 
-struct event {
-    __u32 src_ip;   // IPv4 saddr, network byte order
-    __u64 ts_ns;    // timestamp in ns
-    __u32 dropped;  // total dropped so far for this IP
-};
+// CLOCK_MONOTONIC time divided by refill_quantum_ns. Advanced by
+// refill_tick() or, with RL_REFILL_USER, by the daemon through the
+// mmap'ed .bss.
+__u64 epoch;
 
 // ============================
 // Maps
@@ -42,13 +62,7 @@ struct {
 } rb SEC(".maps");
 
 
-// Per-source-IP rate limiter state
-struct rate_state {
-    __u64 last_ts_ns;  // last time we updated tokens
-    __u32 tokens;      // current tokens
-    __u32 dropped;     // total dropped
-};
-
+// Per-source-IP rate limiter state (struct rate_state, see rateLimiter.h)
 struct {
     __uint(type, BPF_MAP_TYPE_HASH); // hash map 
     __uint(max_entries, 16384);
@@ -56,6 +70,271 @@ struct {
     __type(value, struct rate_state); // per-IP rate limiting state
 } rate_map SEC(".maps");
 
+// Per-/24 rate limiter state, same layout as the per-source state
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, 16384);
+    __type(key, __u32);               // IPv4 src ip & 255.255.255.0
+    __type(value, struct rate_state);
+} prefix_map SEC(".maps");
+
+// Interface-wide aggregate bucket. Shared by all CPUs, so it is protected by
+// a spin lock and only touched when a CPU's local token cache runs dry.
+struct agg_bucket {
+    struct bpf_spin_lock lock;
+    __u64 last_ts_ns;  // last time we updated tokens
+    __u64 tokens;      // current tokens
+};
+
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, 64);
+    __type(key, __u32);               // ifindex
+    __type(value, struct agg_bucket);
+} agg_map SEC(".maps");
+
+// Per-CPU cache of tokens already withdrawn from agg_map
+struct {
+    __uint(type, BPF_MAP_TYPE_PERCPU_HASH);
+    __uint(max_entries, 64);
+    __type(key, __u32);               // ifindex
+    __type(value, __u64);             // cached tokens
+} agg_cache SEC(".maps");
+
+// Packet counters for the `stats` control command
+struct {
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct rl_stats);
+} stats_map SEC(".maps");
+
+// Top-N most rate-limited sources (Space-Saving, see topn_record()), one
+// summary per CPU. The loader resizes it to the number of possible CPUs.
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct rl_topn);
+} topn_map SEC(".maps");
+
+// Timer driving `epoch` with RL_REFILL_TIMER
+struct refill_timer {
+    struct bpf_timer timer;
+};
+
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct refill_timer);
+} refill_timer_map SEC(".maps");
+
+// ============================
+// Refill clock
+// ============================
+
+#define CLOCK_MONOTONIC 1
+
+// Recomputes the epoch from the clock rather than incrementing it, so a
+// late timer never makes the limiter fall behind.
+static int refill_tick(void *map, __u32 *key, struct refill_timer *t)
+{
+    epoch = bpf_ktime_get_ns() / refill_quantum_ns;
+    bpf_timer_start(&t->timer, refill_quantum_ns, 0);
+    return 0;
+}
+
+// Started once by the daemon through BPF_PROG_TEST_RUN; the timer then
+// re-arms itself for as long as refill_timer_map exists.
+SEC("syscall")
+int arm_refill_timer(void *ctx)
+{
+    struct refill_timer *t;
+    __u32 zero = 0;
+    long err;
+
+    t = bpf_map_lookup_elem(&refill_timer_map, &zero);
+    if (!t)
+        return -1;
+
+    err = bpf_timer_init(&t->timer, &refill_timer_map, CLOCK_MONOTONIC);
+    if (err)
+        return err;
+    err = bpf_timer_set_callback(&t->timer, refill_tick);
+    if (err)
+        return err;
+
+    epoch = bpf_ktime_get_ns() / refill_quantum_ns;
+    return bpf_timer_start(&t->timer, refill_quantum_ns, 0);
+}
+
+// ============================
+// Token bucket helpers
+// ============================
+
+// Add tokens for the time elapsed since the last refill, capped to cap.
+static __always_inline void bucket_refill(struct rate_state *st, __u64 now_ns,
+                                          __u64 rate, __u64 cap)
+{
+    // Another CPU may have refilled with a newer epoch than the one this
+    // packet read: treat that as no time having passed.
+    __u64 elapsed = now_ns > st->last_ts_ns ? now_ns - st->last_ts_ns : 0;
+
+    if (rate > 0 && elapsed > 0) {
+
+        // tokens_added = elapsed_seconds * rate_limit_pps
+        // tokens_added = (elapsed_ns / 1e9) * rate(limit per second)
+        __u64 add = (elapsed * rate) / 1000000000ULL;
+
+        if (add > 0) {
+            __u64 tokens = (__u64)st->tokens + add;
+            if (tokens > cap)
+                // Cap tokens to burst size
+                tokens = cap;
+            // Update state
+            st->tokens = (__u32)tokens;
+            // Update timestamp
+            st->last_ts_ns = now_ns;
+        }
+    }
+}
+
+// Lookup the bucket for key, creating a full one on first sight.
+static __always_inline struct rate_state *
+bucket_get(void *map, __u32 *key, __u64 now_ns, __u32 cap)
+{
+    struct rate_state *st;
+    struct rate_state new_st;
+
+    st = bpf_map_lookup_elem(map, key);
+    if (st)
+        return st;
+
+    // First time we see this key: initialize with a full bucket
+    __builtin_memset(&new_st, 0, sizeof(new_st));
+    new_st.last_ts_ns = now_ns;
+    new_st.tokens = cap;
+
+    bpf_map_update_elem(map, key, &new_st, BPF_NOEXIST);
+    return bpf_map_lookup_elem(map, key);
+}
+
+// Take one token from the interface-wide aggregate bucket.
+//
+// Each CPU first drains its own cache in agg_cache; only when that is empty
+// does it grab the spin lock on agg_map and withdraw up to agg_batch tokens
+// in one go, so the shared cache line is touched once per batch instead of
+// once per packet.
+static __always_inline bool agg_take(const struct rl_policy *pol,
+                                     __u32 ifindex, __u64 now_ns)
+{
+    struct agg_bucket *b;
+    __u64 *cached;
+    __u64 zero = 0, grant, elapsed, add;
+
+    cached = bpf_map_lookup_elem(&agg_cache, &ifindex);
+    if (!cached) {
+        bpf_map_update_elem(&agg_cache, &ifindex, &zero, BPF_NOEXIST);
+        cached = bpf_map_lookup_elem(&agg_cache, &ifindex);
+        if (!cached)
+            return true;
+    }
+
+    if (*cached > 0) {
+        (*cached)--;
+        return true;
+    }
+
+    b = bpf_map_lookup_elem(&agg_map, &ifindex);
+    if (!b) {
+        struct agg_bucket new_b;
+
+        __builtin_memset(&new_b, 0, sizeof(new_b));
+        new_b.last_ts_ns = now_ns;
+        new_b.tokens = pol->agg_burst;
+        bpf_map_update_elem(&agg_map, &ifindex, &new_b, BPF_NOEXIST);
+        b = bpf_map_lookup_elem(&agg_map, &ifindex);
+        if (!b)
+            return true;
+    }
+
+    // No helper calls are allowed while holding the lock, so all inputs
+    // (now_ns) are computed beforehand.
+    bpf_spin_lock(&b->lock);
+    elapsed = now_ns > b->last_ts_ns ? now_ns - b->last_ts_ns : 0;
+    add = (elapsed * (__u64)pol->agg_rate_pps) / 1000000000ULL;
+    if (add > 0) {
+        b->tokens += add;
+        if (b->tokens > (__u64)pol->agg_burst)
+            b->tokens = pol->agg_burst;
+        b->last_ts_ns = now_ns;
+    }
+    grant = b->tokens < (__u64)pol->agg_batch ? b->tokens : (__u64)pol->agg_batch;
+    b->tokens -= grant;
+    bpf_spin_unlock(&b->lock);
+
+    if (!grant)
+        return false;
+
+    // Keep the rest of the batch for the next packets on this CPU
+    *cached = grant - 1;
+    return true;
+}
+
+// Account one drop for src_ip in the Space-Saving summary.
+//
+// If the source already owns a slot its count is bumped; otherwise it takes
+// over the slot with the smallest count, inheriting that count as its error
+// bound. With RL_TOPN_SLOTS slots, every source responsible for more than
+// 1/RL_TOPN_SLOTS of the (decayed) drops is guaranteed to be present.
+//
+// Each CPU keeps its own summary, which `top` merges: under a flood every
+// CPU is on this path, and a single shared summary would serialize them all
+// on one lock. The per-CPU lock is only ever contended by userspace reads.
+static __always_inline void topn_record(__u32 src_ip, __u64 now_ns)
+{
+    struct rl_topn *t;
+    __u32 cpu = bpf_get_smp_processor_id(), i, min = 0;
+    bool found = false, decay;
+
+    t = bpf_map_lookup_elem(&topn_map, &cpu);
+    if (!t)
+        return;
+
+    bpf_spin_lock(&t->lock);
+
+    // now_ns was read before taking the lock: never move decay_ts_ns back
+    decay = now_ns > t->decay_ts_ns && now_ns - t->decay_ts_ns >= topn_decay_ns;
+    if (decay)
+        t->decay_ts_ns = now_ns;
+
+    for (i = 0; i < RL_TOPN_SLOTS; i++) {
+        struct rl_topn_slot *slot = &t->slots[i];
+
+        if (decay) {
+            slot->count >>= 1;
+            slot->error >>= 1;
+        }
+        if (!found && slot->count && slot->src_ip == src_ip) {
+            slot->count++;
+            found = true;
+        }
+        if (slot->count < t->slots[min].count)
+            min = i;
+    }
+
+    if (!found) {
+        struct rl_topn_slot *slot = &t->slots[min & (RL_TOPN_SLOTS - 1)];
+
+        slot->error = slot->count;
+        slot->src_ip = src_ip;
+        slot->count++;
+    }
+
+    bpf_spin_unlock(&t->lock);
+}
+
 // ============================
 // TC ingress program
 // ============================
@@ -92,61 +371,78 @@ int tc_ingress(struct __sk_buff *ctx)
 
     __u32 src_ip = l3->saddr;
 
-    // current time in nanoseconds
-    __u64 now_ns = bpf_ktime_get_ns();
+    // current time in nanoseconds, quantized unless refilling on ktime
+    __u64 now_ns = refill_mode == RL_REFILL_KTIME ? bpf_ktime_get_ns()
+                                                  : epoch * refill_quantum_ns;
 
-    // These structs represent per-IP state:
-    struct rate_state *st;
-    struct rate_state new_st;
+    // Snapshot of the live policy, so a concurrent update from userspace
+    // cannot change the limits halfway through this packet
+    struct rl_policy pol = policies[policy_idx & (RL_POLICY_SLOTS - 1)];
+
+    // These structs represent per-IP and per-/24 state:
+    struct rate_state *st, *pst = NULL;
+    struct rl_stats *stats;
+    __u32 reason, zero = 0;
+
+    stats = bpf_map_lookup_elem(&stats_map, &zero);
+    if (stats)
+        stats->packets++;
 
     // Lookup per-IP state
-    st = bpf_map_lookup_elem(&rate_map, &src_ip);
-    if (!st) {
-        // First time we see this IP: initialize
-        __builtin_memset(&new_st, 0, sizeof(new_st));
-        new_st.last_ts_ns = now_ns;
-        if (burst > 0)
-            new_st.tokens = burst - 1; // consume 1 token for this packet
-        new_st.dropped = 0;
-
-        bpf_map_update_elem(&rate_map, &src_ip, &new_st, BPF_ANY);
+    st = bucket_get(&rate_map, &src_ip, now_ns, pol.burst);
+    if (!st)
         return TC_ACT_OK;
-    }
 
     // Refill tokens based on elapsed time
-    __u64 elapsed = now_ns - st->last_ts_ns;
+    bucket_refill(st, now_ns, pol.rate_pps, pol.burst);
 
-    if (rate_limit_pps > 0 && elapsed > 0) {
-        
-        // tokens_added = elapsed_seconds * rate_limit_pps
-        // tokens_added = (elapsed_ns / 1e9) * rate(limit per second)
-        __u64 add = (elapsed * (__u64)rate_limit_pps) / 1000000000ULL;
+    // Level 1: per-source bucket
+    if (st->tokens == 0) {
+        reason = RL_DROP_SOURCE;
+        goto drop;
+    }
 
-        if (add > 0) {
-            __u64 tokens = (__u64)st->tokens + add;
-            if (tokens > (__u64)burst)
-                // Cap tokens to burst size 
-                tokens = burst;
-            // Update state
-            st->tokens = (__u32)tokens;
-            // Update timestamp
-            st->last_ts_ns = now_ns;
+    // Level 2a: per-/24 bucket
+    if (pol.prefix_rate_pps > 0) {
+        __u32 prefix = src_ip & bpf_htonl(0xffffff00);
+
+        pst = bucket_get(&prefix_map, &prefix, now_ns, pol.prefix_burst);
+        if (pst) {
+            bucket_refill(pst, now_ns, pol.prefix_rate_pps, pol.prefix_burst);
+            if (pst->tokens == 0) {
+                reason = RL_DROP_PREFIX;
+                goto drop;
+            }
         }
     }
 
-    // If we have tokens, consume one and allow packet
-    if (st->tokens > 0) {
-        st->tokens--;
-        return TC_ACT_OK;
+    // Level 2b: interface-wide aggregate bucket. Checked last because its
+    // tokens cannot be handed back once taken from the per-CPU cache.
+    if (pol.agg_rate_pps > 0 && !agg_take(&pol, ctx->ifindex, now_ns)) {
+        reason = RL_DROP_AGGREGATE;
+        goto drop;
     }
 
+    // Every level had a token: consume them and allow packet
+    st->tokens--;
+    if (pst)
+        pst->tokens--;
+    if (stats)
+        stats->passed++;
+    return TC_ACT_OK;
+
+drop:
     // No tokens: drop and emit event
     st->dropped++;
+    if (stats && reason < RL_DROP_MAX)
+        stats->dropped[reason]++;
+    topn_record(src_ip, now_ns);
 
     // Reserve space in ring buffer for event
     struct event *e = bpf_ringbuf_reserve(&rb, sizeof(*e), 0);
     if (e) {
         e->src_ip = src_ip;
+        e->reason = reason;
         e->ts_ns = now_ns;
         e->dropped = st->dropped;
         // Submit event to ring buffer
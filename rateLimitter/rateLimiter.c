@@ -1,71 +1,155 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include <argp.h>
+#include <limits.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <time.h>
 #include <arpa/inet.h>
 #include <net/if.h>
 
+#include <bpf/bpf.h>
 #include <bpf/libbpf.h>
 
+#include "rateLimiter.h"     // struct event, enum rl_drop_reason
+#ifdef RL_LIGHT_SKEL
+#include "rateLimiter.lskel.h"   // light skeleton: `make light`
+#else
 #include "rateLimiter.skel.h"
+#endif
 #include "common_um.h"   // setup(), exiting
-
-
-// structure definition used for passing event data from the eBPF program to the userspace program (to inform the user about events such as "a packet was dropped for IP X) through a ring buffer.
-struct event {
-    //32-bit unsigned integer. Holds the source IPv4 address of the packet. 
-    __u32 src_ip;    
-    // 64-bit unsigned integer.Represents a timestamp in nanoseconds. Usually the time when the packet was rate-limited.
-    __u64 ts_ns;
-
-    // 32-bit unsigned integer. Maintains the count of packets dropped so far for the given source IP. 
-    __u32 dropped;
-};
-
-
-// global configuration object that holds all runtime parameters for the program.
+#include "rl_config.h"   // struct rl_config, config file parser
+#include "rl_ctl.h"      // UNIX control socket
+#include "rl_xdp.h"      // offload-friendly XDP variant
+
+// The light skeleton is loaded by a loader program generated at build time
+// (bpftool gen skeleton -L), so there are no libbpf objects behind it, only
+// the fds the loader returns.
+#ifdef RL_LIGHT_SKEL
+#define RL_PROG_FD(skel, prog) ((skel)->progs.prog.prog_fd)
+#define RL_MAP_FD(skel, map) ((skel)->maps.map.map_fd)
+#else
+#define RL_PROG_FD(skel, prog) bpf_program__fd((skel)->progs.prog)
+#define RL_MAP_FD(skel, map) bpf_map__fd((skel)->maps.map)
+#endif
+
+
+// Command-line options. Everything here is optional: a value of 0 (or an
+// empty string) means "not given", in which case the config file (-c) or the
+// built-in default applies.
 static struct env {
 
+    // Path of the declarative config file.
+    const char *config_path;
+
     // Packets-per-second allowed per source IP.
     int rate;           
     
     // Token bucket size (how many packets can pass in a burst).
     int burst;  
+
+    // Interface-wide aggregate rate and burst shared by all sources (0 = off).
+    int agg_rate;
+    int agg_burst;
+
+    // Rate and burst shared by all sources of the same /24 (0 = off).
+    int prefix_rate;
+    int prefix_burst;
     
     // Whether to print verbose logs. (whether the program should print extra debug or informational messages. (Attached TC program on ens160 (ifindex 5)))
     bool verbose;
 
     // the network interface name where the rate-limiting eBPF program should attach  
     char ifname[IFNAMSIZ];   
-} env = {
-    .rate = 1000,
-    .burst = 200,
-    .verbose = false,
-    .ifname = "ens160",
-};
+
+    // How to attach: tc, xdp or xdp-offload.
+    const char *mode;
+
+    // Path of the UNIX control socket.
+    char ctl_path[sizeof(((struct rl_config *)0)->ctl_path)];
+} env;
+
+// Effective configuration: defaults < config file < command line.
+static struct rl_config cfg;
+
+// TC hooks we attached to, so they can be detached again on exit.
+static struct tc_attachment {
+    struct bpf_tc_hook hook;
+    struct bpf_tc_opts opts;
+} attached[RL_MAX_IFACES];
+static int attached_cnt;
+
+// Interfaces running the XDP variant, each with its own maps.
+static struct rl_xdp *xdps[RL_MAX_IFACES];
+static int xdp_cnt;
+
+// True when the daemon has to advance the TC program's refill epoch itself
+// (RL_REFILL_USER, or RL_REFILL_TIMER without kernel timer support).
+static bool refill_by_user;
+
+#if RL_HAVE_LIBBPF_EXT
+// Run time of the attached programs (prog_stats), sampled once a second.
+static struct bpf_prog_sampler *prog_sampler;
+#endif
 
 const char *argp_program_version = "rateLimiter 1.0";
 const char *argp_program_bug_address = "<path@tofile.dev>";
 const char argp_program_doc[] =
 "TC ingress rate limiter (per-source IPv4)\n"
 "\n"
-"USAGE: ./rateLimiter [-i IFACE] [-r RATE_PPS] [-b BURST]\n";
+"USAGE: ./rateLimiter [-c CONFIG] [-s SOCKET] [-i IFACE] [-r RATE_PPS] [-b BURST]\n"
+"                     [-a AGG_PPS [-A AGG_BURST]] [-p PREFIX_PPS [-P PREFIX_BURST]]\n"
+"\n"
+"Command-line options override the config file. With a control socket,\n"
+"`echo stats | socat - UNIX-CONNECT:SOCKET` queries the running limiter\n"
+"(commands: stats, top [N], set-policy KEY=VAL..., flush-source IP, dump).\n";
 
 static const struct argp_option opts[] = {
+    { "config", 'c', "FILE",  0, "Read interfaces, policy and map sizes from FILE" },
+    { "socket", 's', "PATH",  0, "Serve control commands on UNIX socket PATH" },
     { "iface",  'i', "IFACE", 0, "Interface to attach TC ingress program to (default: ens160)" },
+    { "mode",   'm', "MODE",  0, "Attach mode: tc (default), xdp or xdp-offload" },
     { "rate",   'r', "PPS",   0, "Allowed packets per second per source IP (default 1000)" },
     { "burst",  'b', "COUNT", 0, "Token bucket size / burst (default 200)" },
+    { "agg-rate",     'a', "PPS",   0, "Aggregate packets per second for the whole interface (default off)" },
+    { "agg-burst",    'A', "COUNT", 0, "Aggregate bucket size (default: same as --agg-rate)" },
+    { "prefix-rate",  'p', "PPS",   0, "Allowed packets per second per source /24 (default off)" },
+    { "prefix-burst", 'P', "COUNT", 0, "Per-/24 bucket size (default: same as --prefix-rate)" },
     { "verbose",'v', 0,       0, "Verbose logging" },
     {},
 };
 
+// Parses a strictly positive integer option value, bailing out with usage on error.
+static int parse_positive(const char *what, const char *arg, struct argp_state *state)
+{
+    long val;
+
+    errno = 0;
+    val = strtol(arg, NULL, 10);
+    if (errno || val <= 0 || val > INT_MAX) {
+        fprintf(stderr, "Invalid %s: %s\n", what, arg);
+        argp_usage(state);
+    }
+    return (int)val;
+}
+
 static error_t parse_arg(int key, char *arg, struct argp_state *state)
 {
     long val;
 
     switch (key) {
+    case 'c':
+        env.config_path = arg;
+        break;
+    case 's':
+        if (strlen(arg) >= sizeof(env.ctl_path)) {
+            fprintf(stderr, "Socket path too long: %s\n", arg);
+            argp_usage(state);
+        }
+        strcpy(env.ctl_path, arg);
+        break;
     case 'i':
         if (strlen(arg) >= sizeof(env.ifname)) {
             fprintf(stderr, "Interface name too long: %s\n", arg);
@@ -92,6 +176,25 @@ static error_t parse_arg(int key, char *arg, struct argp_state *state)
         }
         env.burst = (int)val;
         break;
+    case 'a':
+        env.agg_rate = parse_positive("aggregate rate", arg, state);
+        break;
+    case 'A':
+        env.agg_burst = parse_positive("aggregate burst", arg, state);
+        break;
+    case 'p':
+        env.prefix_rate = parse_positive("prefix rate", arg, state);
+        break;
+    case 'P':
+        env.prefix_burst = parse_positive("prefix burst", arg, state);
+        break;
+    case 'm':
+        if (strcmp(arg, "tc") && strcmp(arg, "xdp") && strcmp(arg, "xdp-offload")) {
+            fprintf(stderr, "Invalid mode: %s\n", arg);
+            argp_usage(state);
+        }
+        env.mode = arg;
+        break;
     case 'v':
         env.verbose = true;
         break;
@@ -120,6 +223,17 @@ static const struct argp argp = {
 };
 
 
+// Human readable name of the hierarchy level that dropped a packet.
+static const char *drop_reason_str(__u32 reason)
+{
+    switch (reason) {
+    case RL_DROP_SOURCE:    return "source limit";
+    case RL_DROP_PREFIX:    return "/24 limit";
+    case RL_DROP_AGGREGATE: return "aggregate limit";
+    default:                return "unknown";
+    }
+}
+
 //This function handles events coming from the eBPF program through the ring buffer.
 // Each time the eBPF program reports a rate-limited packet, this function is called.
 static int handle_event(void *ctx, void *data, size_t data_sz)
@@ -148,12 +262,13 @@ Whenever the ring buffer receives an event, libbpf calls this function.
     if (!ip)
         ip = "<invalid>";
 
-    printf("Rate-limited packet from %s, total dropped for this IP: %u\n",
-           ip, e->dropped);
+    printf("Rate-limited packet from %s (%s), total dropped for this IP: %u\n",
+           ip, drop_reason_str(e->reason), e->dropped);
     return 0;
 }
 
 
+#if !RL_HAVE_LIBBPF_EXT
 // Explicit TC attach using libbpf
 
 //  skel → the loaded eBPF skeleton containing all programs and maps
@@ -169,7 +284,7 @@ static int attach_tc(struct rateLimiter_bpf *skel, const char *ifname)
 
     // will store the numeric index of the network interface
     // will store error codes from libbpf functions
-    int ifindex, err = 0;
+    int ifindex, err;
 
     // Get the interface index from the interface name
     ifindex = if_nametoindex(ifname);
@@ -183,6 +298,8 @@ static int attach_tc(struct rateLimiter_bpf *skel, const char *ifname)
     hook.ifindex = ifindex;
     hook.attach_point = BPF_TC_INGRESS;
 
+    // Make sure the clsact qdisc exists; it may already be there (-EEXIST).
+    err = bpf_tc_hook_create(&hook);
     if (err && err != -EEXIST) {
         fprintf(stderr, "bpf_tc_hook_create failed: %d\n", err);
         return err;
@@ -190,7 +307,7 @@ static int attach_tc(struct rateLimiter_bpf *skel, const char *ifname)
 
     opts.sz = sizeof(opts);
     // Set the file descriptor of the eBPF program to attach [This is the specific BPF program I want you to attach to TC]
-    opts.prog_fd = bpf_program__fd(skel->progs.tc_ingress);
+    opts.prog_fd = RL_PROG_FD(skel, tc_ingress);
 
 
     // libbpf userspace API function.f
@@ -200,49 +317,496 @@ static int attach_tc(struct rateLimiter_bpf *skel, const char *ifname)
         return err;
     }
 
-    if (env.verbose)
+    // Remember handle/priority filled in by the kernel for detach_all()
+    attached[attached_cnt].hook = hook;
+    attached[attached_cnt].opts = opts;
+    attached_cnt++;
+
+    if (cfg.verbose)
         printf("Attached TC program on %s (ifindex %d)\n", ifname, ifindex);
 
     return 0;
 }
 
+// Attaches the TC program to every interface configured for TC.
+static int attach_tc_all(struct rateLimiter_bpf *skel)
+{
+    int i, err;
+
+    for (i = 0; i < cfg.iface_cnt; i++) {
+        if (cfg.ifaces[i].mode != RL_MODE_TC)
+            continue;
+        err = attach_tc(skel, cfg.ifaces[i].name);
+        if (err)
+            return err;
+    }
+    return 0;
+}
+#else
+// Attaches the TC program to every TC interface with one netlink batch
+// instead of two round trips per interface. Requests are staged in the free
+// slots of attached[], where the kernel fills in handle and priority on
+// submit; the ones that succeeded are then packed to the front.
+static int attach_tc_all(struct rateLimiter_bpf *skel)
+{
+    int hook_res[RL_MAX_IFACES], attach_res[RL_MAX_IFACES];
+    const char *names[RL_MAX_IFACES];
+    struct bpf_netlink_batch *batch;
+    int prog_fd = RL_PROG_FD(skel, tc_ingress);
+    int i, n = 0, base = attached_cnt, ifindex, err;
+
+    batch = bpf_netlink_batch__new();
+    if (!batch) {
+        fprintf(stderr, "bpf_netlink_batch__new failed: %s\n", strerror(errno));
+        return -1;
+    }
 
-int main(int argc, char **argv)
+    for (i = 0; i < cfg.iface_cnt; i++) {
+        struct tc_attachment *a = &attached[base + n];
+
+        if (cfg.ifaces[i].mode != RL_MODE_TC)
+            continue;
+
+        ifindex = if_nametoindex(cfg.ifaces[i].name);
+        if (!ifindex) {
+            fprintf(stderr, "if_nametoindex(%s) failed: %s\n",
+                    cfg.ifaces[i].name, strerror(errno));
+            err = -1;
+            goto out;
+        }
+
+        memset(a, 0, sizeof(*a));
+        a->hook.sz = sizeof(a->hook);
+        a->hook.ifindex = ifindex;
+        a->hook.attach_point = BPF_TC_INGRESS;
+        a->opts.sz = sizeof(a->opts);
+        a->opts.prog_fd = prog_fd;
+        names[n] = cfg.ifaces[i].name;
+
+        err = bpf_netlink_batch__tc_hook_create(batch, &a->hook, &hook_res[n]);
+        if (!err)
+            err = bpf_netlink_batch__tc_attach(batch, &a->hook, &a->opts,
+                                               &attach_res[n]);
+        if (err) {
+            fprintf(stderr, "Failed to queue TC attach on %s: %d\n",
+                    names[n], err);
+            goto out;
+        }
+        n++;
+    }
+    if (!n) {
+        err = 0;
+        goto out;
+    }
+
+    // The overall result is the first failed request, which may just be
+    // -EEXIST from a clsact qdisc that was already there. Anything else is
+    // reported below with the interface it belongs to.
+    err = bpf_netlink_batch__submit(batch);
+    if (err == -EEXIST)
+        err = 0;
+    else if (err)
+        fprintf(stderr, "bpf_netlink_batch__submit failed: %d\n", err);
+    for (i = 0; i < n; i++) {
+        if (!attach_res[i]) {
+            // attached_cnt <= base + i, so this only ever moves slots down
+            if (attached_cnt != base + i)
+                attached[attached_cnt] = attached[base + i];
+            attached_cnt++;
+            if (cfg.verbose)
+                printf("Attached TC program on %s (ifindex %d)\n", names[i],
+                       attached[attached_cnt - 1].hook.ifindex);
+            continue;
+        }
+        if (hook_res[i] && hook_res[i] != -EEXIST)
+            fprintf(stderr, "bpf_tc_hook_create on %s failed: %d\n",
+                    names[i], hook_res[i]);
+        else
+            fprintf(stderr, "bpf_tc_attach on %s failed: %d\n",
+                    names[i], attach_res[i]);
+        if (!err)
+            err = attach_res[i];
+    }
+out:
+    bpf_netlink_batch__free(batch);
+    return err;
+}
+#endif
+
+// Removes every filter attach_tc() installed. The clsact qdisc itself is left
+// in place since other filters may be using it.
+static void detach_all(void)
 {
-    // This declares a pointer to a ring_buffer object.
-    struct ring_buffer *rb = NULL;
+    int i;
 
-    /* This declares a pointer to our BPF skeleton.
-    It represents:
-        our compiled BPF program
-        all maps
-        all global variables (.rodata)
-        all program handles
-    */
-    struct rateLimiter_bpf *skel;
+    for (i = 0; i < attached_cnt; i++) {
+        struct tc_attachment *a = &attached[i];
+
+        // bpf_tc_detach() only wants handle and priority
+        a->opts.prog_fd = 0;
+        a->opts.prog_id = 0;
+        a->opts.flags = 0;
+        bpf_tc_detach(&a->hook, &a->opts);
+    }
+    attached_cnt = 0;
+}
+
+// Attaches the XDP variant to one interface.
+static int attach_xdp(const struct rl_iface *iface)
+{
+    struct rl_xdp_opts opts = {
+        .quantum_ms = cfg.quantum_ms,
+        .map_size = cfg.rate_map_size,
+        .core_cache_dir = cfg.core_cache_dir[0] ? cfg.core_cache_dir : NULL,
+        .verbose = cfg.verbose,
+    };
+    struct rl_xdp *x;
+
+    x = rl_xdp_attach(iface->name, iface->mode == RL_MODE_XDP_OFFLOAD,
+                      &cfg.policy, &opts);
+    if (!x)
+        return -1;
+    xdps[xdp_cnt++] = x;
+    return 0;
+}
+
+static void detach_xdp_all(void)
+{
+    while (xdp_cnt > 0)
+        rl_xdp_detach(xdps[--xdp_cnt]);
+}
+
+// Advances the epoch counter of the XDP variant. It cannot read the clock
+// itself (bpf_ktime_get_ns() is not offloadable), so time only moves when we
+// publish it here.
+static void tick_xdp(const struct timespec *start)
+{
+    static __u64 last_epoch;
+    struct timespec now;
+    __u64 elapsed_ms, epoch;
+    int i;
+
+    if (!xdp_cnt)
+        return;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    elapsed_ms = (now.tv_sec - start->tv_sec) * 1000ULL +
+                 (now.tv_nsec - start->tv_nsec) / 1000000;
+    epoch = elapsed_ms / cfg.quantum_ms;
+    if (epoch == last_epoch)
+        return;
+
+    for (i = 0; i < xdp_cnt; i++)
+        rl_xdp_tick(xdps[i], epoch);
+    last_epoch = epoch;
+}
+
+// Publishes the current epoch to the TC program for the user refill engine.
+static void tick_refill(struct rateLimiter_bpf *skel)
+{
+    struct timespec now;
+    __u64 now_ns;
+
+    if (!refill_by_user)
+        return;
+
+    // Same clock as bpf_ktime_get_ns(), so timer and user epochs agree.
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    now_ns = now.tv_sec * 1000000000ULL + now.tv_nsec;
+    skel->bss->epoch = now_ns / skel->rodata->refill_quantum_ns;
+}
+
+// Starts the bpf_timer behind the timer refill engine. Falls back to the
+// user engine on kernels that cannot run it.
+static void arm_refill_timer(struct rateLimiter_bpf *skel)
+{
+    LIBBPF_OPTS(bpf_test_run_opts, topts);
     int err;
 
-    err = argp_parse(&argp, argc, argv, 0, NULL, NULL);
+    err = bpf_prog_test_run_opts(RL_PROG_FD(skel, arm_refill_timer), &topts);
+    if (!err)
+        err = (int)topts.retval;
+    if (err) {
+        fprintf(stderr, "Failed to arm refill timer (%d), ticking from userspace\n", err);
+        refill_by_user = true;
+    }
+}
+
+// Control socket hooks: keep the XDP instances in sync with `set-policy`
+// and report their counters, and program run times, in `stats`.
+static void xdp_policy_changed(const struct rl_policy *policy, void *ctx)
+{
+    int i;
+
+    (void)ctx;
+    for (i = 0; i < xdp_cnt; i++)
+        rl_xdp_set_policy(xdps[i], policy);
+}
+
+#if RL_HAVE_LIBBPF_EXT
+// Upper bound (ns) of the q-quantile of a program's histogram. The kernel
+// only reports totals, so the histogram holds per-interval averages, weighted
+// by runs: this is not a percentile of single runs.
+static unsigned long long prog_hist_quantile(const struct bpf_prog_sample *p, double q)
+{
+    __u64 seen = 0;
+    int i;
+
+    for (i = 0; i < BPF_PROG_SAMPLE_HIST_SLOTS; i++) {
+        seen += p->hist[i];
+        if (seen && seen >= q * p->run_cnt)
+            break;
+    }
+    return 2ULL << (i < BPF_PROG_SAMPLE_HIST_SLOTS ? i : BPF_PROG_SAMPLE_HIST_SLOTS - 1);
+}
+
+static void print_prog_stats(FILE *out)
+{
+    const struct bpf_prog_sample *p;
+    int i;
+
+    for (i = 0; i < bpf_prog_sampler__prog_cnt(prog_sampler); i++) {
+        p = bpf_prog_sampler__prog(prog_sampler, i);
+        // overhead is over the last sampling interval, in % of one CPU
+        fprintf(out, "prog %s runs=%llu avg_ns=%llu interval_avg_p50_ns<%llu "
+                "interval_avg_p99_ns<%llu overhead=%.3f%%\n",
+                p->name, (unsigned long long)p->run_cnt,
+                p->run_cnt ? (unsigned long long)(p->run_time_ns / p->run_cnt) : 0ULL,
+                p->run_cnt ? prog_hist_quantile(p, 0.5) : 0ULL,
+                p->run_cnt ? prog_hist_quantile(p, 0.99) : 0ULL,
+                p->interval_ns ? 100.0 * p->interval_run_time_ns / p->interval_ns : 0.0);
+    }
+}
+
+// Starts sampling the run time of every program attached so far.
+static int start_prog_stats(struct rateLimiter_bpf *skel)
+{
+    char name[64];
+    int i, err = 0;
+
+    prog_sampler = bpf_prog_sampler__new(NULL, NULL);
+    if (!prog_sampler)
+        return -errno;
+
+    if (attached_cnt)
+        err = bpf_prog_sampler__add_prog(prog_sampler, RL_PROG_FD(skel, tc_ingress),
+                                         "tc_ingress");
+    for (i = 0; !err && i < xdp_cnt; i++) {
+        snprintf(name, sizeof(name), "xdp_ingress@%s", rl_xdp_ifname(xdps[i]));
+        err = bpf_prog_sampler__add_prog(prog_sampler, rl_xdp_prog_fd(xdps[i]), name);
+    }
+    if (err) {
+        bpf_prog_sampler__free(prog_sampler);
+        prog_sampler = NULL;
+    }
+    return err;
+}
+
+static void sample_prog_stats(void)
+{
+    static struct timespec last;
+    struct timespec now;
+
+    if (!prog_sampler)
+        return;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec == last.tv_sec)
+        return;
+    last = now;
+    bpf_prog_sampler__sample(prog_sampler);
+}
+#endif
+
+static void print_extra_stats(FILE *out, void *ctx)
+{
+    struct rl_stats st;
+    int i;
+
+    (void)ctx;
+    for (i = 0; i < xdp_cnt; i++) {
+        if (rl_xdp_read_stats(xdps[i], &st))
+            continue;
+        fprintf(out, "xdp %s mode=%s packets=%llu passed=%llu dropped=%llu\n",
+                rl_xdp_ifname(xdps[i]), rl_xdp_offloaded(xdps[i]) ? "offload" : "native",
+                (unsigned long long)st.packets, (unsigned long long)st.passed,
+                (unsigned long long)st.dropped[RL_DROP_SOURCE]);
+    }
+#if RL_HAVE_LIBBPF_EXT
+    if (prog_sampler)
+        print_prog_stats(out);
+#endif
+}
+
+// Merges command-line overrides into cfg.
+static int apply_cli(struct rl_config *c)
+{
+    int err;
+
+    if (env.ifname[0]) {
+        c->iface_cnt = 0;
+        err = rl_config_add_iface(c, env.ifname, env.mode);
+        if (err)
+            return err;
+    } else if (env.mode) {
+        // -m without -i switches every configured interface
+        for (int i = 0; i < c->iface_cnt; i++) {
+            err = rl_config_add_iface(c, c->ifaces[i].name, env.mode);
+            if (err)
+                return err;
+        }
+    }
+    if (env.ctl_path[0])
+        strcpy(c->ctl_path, env.ctl_path);
+    if (env.verbose)
+        c->verbose = true;
+
+    if (env.rate)
+        c->policy.rate_pps = env.rate;
+    if (env.burst)
+        c->policy.burst = env.burst;
+    if (env.prefix_rate)
+        c->policy.prefix_rate_pps = env.prefix_rate;
+    if (env.prefix_burst)
+        c->policy.prefix_burst = env.prefix_burst;
+    if (env.agg_rate)
+        c->policy.agg_rate_pps = env.agg_rate;
+    if (env.agg_burst)
+        c->policy.agg_burst = env.agg_burst;
+    return 0;
+}
+
+#ifdef RL_LIGHT_SKEL
+// Ring buffer size has to be a power-of-2 multiple of the page size; libbpf
+// rounds it up for full skeletons, the loader program can't.
+static __u32 ringbuf_size_adjust(__u32 sz)
+{
+    __u32 page = (__u32)sysconf(_SC_PAGE_SIZE), n = page;
+
+    while (n < sz && n <= UINT_MAX / 2)
+        n <<= 1;
+    return n;
+}
+
+// Applies map sizes from the config; must run between open and load. The
+// loader program uses any non-zero max_entries instead of the built-in one.
+static int size_maps(struct rateLimiter_bpf *skel)
+{
+    int ncpus = libbpf_num_possible_cpus();
+
+    if (ncpus < 0) {
+        fprintf(stderr, "Failed to get number of CPUs: %d\n", ncpus);
+        return ncpus;
+    }
+    // topn_map holds one summary per CPU
+    skel->maps.topn_map.max_entries = ncpus;
+    if (cfg.rate_map_size)
+        skel->maps.rate_map.max_entries = cfg.rate_map_size;
+    if (cfg.prefix_map_size)
+        skel->maps.prefix_map.max_entries = cfg.prefix_map_size;
+    if (cfg.ringbuf_size)
+        skel->maps.rb.max_entries = ringbuf_size_adjust(cfg.ringbuf_size);
+    return 0;
+}
+#else
+// Applies map sizes from the config; must run between open and load.
+static int size_maps(struct rateLimiter_bpf *skel)
+{
+    int ncpus = libbpf_num_possible_cpus(), err;
+
+    if (ncpus < 0) {
+        fprintf(stderr, "Failed to get number of CPUs: %d\n", ncpus);
+        return ncpus;
+    }
+    // topn_map holds one summary per CPU
+    err = bpf_map__set_max_entries(skel->maps.topn_map, ncpus);
+    if (!err && cfg.rate_map_size)
+        err = bpf_map__set_max_entries(skel->maps.rate_map, cfg.rate_map_size);
+    if (!err && cfg.prefix_map_size)
+        err = bpf_map__set_max_entries(skel->maps.prefix_map, cfg.prefix_map_size);
+    if (!err && cfg.ringbuf_size)
+        err = bpf_map__set_max_entries(skel->maps.rb, cfg.ringbuf_size);
     if (err)
-        return err;
+        fprintf(stderr, "Failed to size maps: %d\n", err);
+    return err;
+}
+#endif
 
-    if (!setup())
-        return 1;  
+#if RL_HAVE_LIBBPF_EXT
+// Whether anything we load still parses kernel BTF in userspace: the full
+// TC skeleton always does, the light one only needs it for XDP instances.
+static bool need_kernel_btf(void)
+{
+#ifdef RL_LIGHT_SKEL
+    int i;
+
+    for (i = 0; i < cfg.iface_cnt; i++)
+        if (cfg.ifaces[i].mode != RL_MODE_TC)
+            return true;
+    return false;
+#else
+    return true;
+#endif
+}
+#endif
+
+// Opens the TC skeleton, applies the configuration with the given refill
+// engine and loads it. On error *skelp is left for the caller to destroy.
+static int open_and_load(struct rateLimiter_bpf **skelp, enum rl_refill_mode refill_mode)
+{
+    struct rateLimiter_bpf *skel;
+#ifndef RL_LIGHT_SKEL
+    LIBBPF_OPTS(bpf_object_open_opts, open_opts);
+#endif
+    int err;
 
-    
-    // During build time, libbpf (or bpftool) generates a C file from our .bpf.c program.
-    // It produces a structure called: struct rateLimiter_bpf
     // Allocates memory for struct rateLimiter_bpf, Prepares all maps, programs, and sections in memory.
+#ifdef RL_LIGHT_SKEL
+    // The kernel resolves CO-RE relocations for the loader, nothing to cache
+    if (cfg.core_cache_dir[0])
+        fprintf(stderr, "core_cache_dir has no effect with the light skeleton, ignoring it\n");
     skel = rateLimiter_bpf__open();
+#else
+#if RL_HAVE_LIBBPF_EXT
+    if (cfg.core_cache_dir[0])
+        open_opts.core_cache_dir = cfg.core_cache_dir;
+    // verify the TC classifier and the refill program side by side
+    open_opts.prog_load_threads = 2;
+#else
+    if (cfg.core_cache_dir[0])
+        fprintf(stderr, "core_cache_dir needs the bundled libbpf (LIBBPF_SRC), ignoring it\n");
+#endif
+    skel = rateLimiter_bpf__open_opts(&open_opts);
+#endif
     if (!skel) {
+        err = -errno;
         fprintf(stderr, "Failed to open BPF skeleton: %s\n", strerror(errno));
-        return 1;
+        *skelp = NULL;
+        return err;
     }
+    *skelp = skel;
+
+    // initial policy goes into .data; it stays writable after load
+    skel->data->policies[0] = cfg.policy;
+    skel->data->policy_idx = 0;
+
+    if (cfg.top_decay_ms)
+        skel->rodata->topn_decay_ns = cfg.top_decay_ms * 1000000ULL;
+
+    skel->rodata->refill_mode = refill_mode;
+    skel->rodata->refill_quantum_ns = cfg.quantum_ms * 1000000ULL;
+    refill_by_user = refill_mode == RL_REFILL_USER;
+    // Timers need a 5.15+ kernel: only ask for them when they are used. The
+    // light skeleton loads every program, so it needs timer support anyway.
+#ifndef RL_LIGHT_SKEL
+    if (refill_mode != RL_REFILL_TIMER) {
+        bpf_program__set_autoload(skel->progs.arm_refill_timer, false);
+        bpf_map__set_autocreate(skel->maps.refill_timer_map, false);
+    }
+#endif
 
-    // pass config into .rodata
-    skel->rodata->rate_limit_pps = env.rate;
-    skel->rodata->burst = env.burst;
-
+    err = size_maps(skel);
+    if (err)
+        return err;
 
     /*
         Loads the BPF bytecode into the kernel
@@ -252,30 +816,180 @@ int main(int argc, char **argv)
         Returns 0 on success or a negative error code
     */
     err = rateLimiter_bpf__load(skel);
-    if (err) {
+    if (err)
         fprintf(stderr, "Failed to load and verify BPF skeleton: %d\n", err);
-        goto cleanup;
+    return err;
+}
+
+
+int main(int argc, char **argv)
+{
+    // This declares a pointer to a ring_buffer object.
+    struct ring_buffer *rb = NULL;
+
+    /* This declares a pointer to our BPF skeleton.
+    It represents:
+        our compiled BPF program
+        all maps
+        all global variables (.rodata)
+        all program handles
+    */
+    struct rateLimiter_bpf *skel = NULL;
+    LIBBPF_OPTS(ring_buffer_opts, rb_opts);
+    struct rl_ctl *ctl = NULL;
+    struct timespec start, launch;
+#if RL_HAVE_LIBBPF_EXT
+    bool btf_warm = false;
+#endif
+    int err, i, poll_ms;
+
+    clock_gettime(CLOCK_MONOTONIC, &launch);
+    err = argp_parse(&argp, argc, argv, 0, NULL, NULL);
+    if (err)
+        return err;
+
+    // defaults, then the config file, then command-line overrides
+    rl_config_init(&cfg);
+    if (env.config_path && rl_config_load(&cfg, env.config_path))
+        return 1;
+    if (apply_cli(&cfg)) {
+        fprintf(stderr, "Invalid interface: %s\n", env.ifname);
+        return 1;
+    }
+    rl_policy_finalize(&cfg.policy);
+
+    if (!setup())
+        return 1;  
+
+#if RL_HAVE_LIBBPF_EXT
+    // The TC skeleton and every per-interface XDP skeleton share one parsed
+    // copy of kernel BTF; keep it around for the loads below.
+    if (need_kernel_btf()) {
+        btf_warm = libbpf_vmlinux_btf_prewarm() == 0;
+        if (!btf_warm)
+            fprintf(stderr, "Failed to pre-load kernel BTF, loading it per object\n");
+    }
+#endif
+
+
+    // During build time, libbpf (or bpftool) generates a C file from our .bpf.c program.
+    // It produces a structure called: struct rateLimiter_bpf
+    // Loads the BPF bytecode into the kernel, verifies it with the eBPF
+    // verifier and creates all maps, see open_and_load().
+    err = open_and_load(&skel, cfg.refill_mode);
+#ifndef RL_LIGHT_SKEL
+    // Kernels without bpf_timer reject the timer program or its map, and
+    // the object can't be loaded twice: start over without them.
+    if (err && cfg.refill_mode == RL_REFILL_TIMER) {
+        fprintf(stderr, "Failed to load with the timer refill engine, retrying with user refill\n");
+        rateLimiter_bpf__destroy(skel);
+        err = open_and_load(&skel, RL_REFILL_USER);
     }
+#endif
+    if (err)
+        goto cleanup;
+
+    // Start the refill clock before any packet can see epoch 0
+    if (cfg.refill_mode == RL_REFILL_TIMER && !refill_by_user)
+        arm_refill_timer(skel);
+    tick_refill(skel);
 
     // *** explicit TC attach instead of auto-attach ***
-    err = attach_tc(skel, env.ifname);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    err = attach_tc_all(skel);
     if (err)
         goto cleanup;
+    for (i = 0; i < cfg.iface_cnt; i++) {
+        if (cfg.ifaces[i].mode == RL_MODE_TC)
+            continue;
+        err = attach_xdp(&cfg.ifaces[i]);
+        if (err)
+            goto cleanup;
+    }
+
+#if RL_HAVE_LIBBPF_EXT
+    if (cfg.prog_stats) {
+        int stats_err = start_prog_stats(skel);
+
+        if (stats_err)
+            fprintf(stderr, "Failed to enable BPF program stats: %s\n", strerror(-stats_err));
+    }
+#else
+    if (cfg.prog_stats)
+        fprintf(stderr, "prog_stats needs the bundled libbpf (LIBBPF_SRC), ignoring it\n");
+#endif
 
     // Create a ring buffer to receive events from the kernel 
-    rb = ring_buffer__new(bpf_map__fd(skel->maps.rb), handle_event, NULL, NULL);
+#if RL_HAVE_LIBBPF_EXT
+    rb_opts.busy_poll_us = cfg.busy_poll_us;
+#else
+    if (cfg.busy_poll_us)
+        fprintf(stderr, "busy_poll_us needs the bundled libbpf (LIBBPF_SRC), ignoring it\n");
+#endif
+    rb = ring_buffer__new(RL_MAP_FD(skel, rb), handle_event, NULL, &rb_opts);
     if (!rb) {
         fprintf(stderr, "Failed to create ring buffer\n");
         err = -1;
         goto cleanup;
     }
 
-    printf("Rate limiter started on %s: %d pps per source IP, burst %d\n",
-           env.ifname, env.rate, env.burst);
+    // Optional control socket, answered from the maps between ring buffer polls
+    if (cfg.ctl_path[0]) {
+        struct rl_ctl_maps maps = {
+            .rate_map_fd = RL_MAP_FD(skel, rate_map),
+            .stats_map_fd = RL_MAP_FD(skel, stats_map),
+            .topn_map_fd = RL_MAP_FD(skel, topn_map),
+            .policy_changed = xdp_policy_changed,
+            .print_stats = print_extra_stats,
+            .policies = skel->data->policies,
+            .policy_idx = &skel->data->policy_idx,
+        };
+
+        ctl = rl_ctl_open(cfg.ctl_path, &maps);
+        if (!ctl) {
+            fprintf(stderr, "Failed to open control socket %s: %s\n",
+                    cfg.ctl_path, strerror(errno));
+            err = -1;
+            goto cleanup;
+        }
+    }
+
+    for (i = 0; i < cfg.iface_cnt; i++)
+        printf("Rate limiter started on %s (%s): %u pps per source IP, burst %u\n",
+               cfg.ifaces[i].name, rl_mode_str(cfg.ifaces[i].mode),
+               cfg.policy.rate_pps, cfg.policy.burst);
+    if (cfg.policy.prefix_rate_pps)
+        printf("  per-/24 limit: %u pps, burst %u\n",
+               cfg.policy.prefix_rate_pps, cfg.policy.prefix_burst);
+    if (cfg.policy.agg_rate_pps)
+        printf("  aggregate limit: %u pps, burst %u\n",
+               cfg.policy.agg_rate_pps, cfg.policy.agg_burst);
+    if (cfg.refill_mode != RL_REFILL_KTIME)
+        printf("  refill engine: %s, %ums quantum\n",
+               refill_by_user ? "user" : rl_refill_str(cfg.refill_mode), cfg.quantum_ms);
+    if (ctl)
+        printf("Control socket: %s\n", cfg.ctl_path);
+    if (cfg.verbose) {
+        struct timespec now;
+
+        // open, load and attach; compares the full and light skeleton builds
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        printf("Startup took %.1f ms\n", (now.tv_sec - launch.tv_sec) * 1e3 +
+               (now.tv_nsec - launch.tv_nsec) / 1e6);
+    }
     printf("Press Ctrl-C to exit.\n");
 
+    // The XDP clock and the user refill engine only advance when we wake up,
+    // so wake at least once a quantum.
+    poll_ms = (xdp_cnt || refill_by_user) && cfg.quantum_ms < 100 ? (int)cfg.quantum_ms : 100;
+
     while (!exiting) {
-        err = ring_buffer__poll(rb, 100);
+        tick_xdp(&start);
+        tick_refill(skel);
+#if RL_HAVE_LIBBPF_EXT
+        sample_prog_stats();
+#endif
+        err = ring_buffer__poll(rb, poll_ms);
         if (err == -EINTR) {
             err = 0;
             break;
@@ -284,9 +998,21 @@ int main(int argc, char **argv)
             fprintf(stderr, "Error polling ring buffer: %d\n", err);
             break;
         }
+        rl_ctl_process(ctl);
     }
 
 cleanup:
+    rl_ctl_close(ctl);
+    ring_buffer__free(rb);
+#if RL_HAVE_LIBBPF_EXT
+    bpf_prog_sampler__free(prog_sampler);
+#endif
+    detach_all();
+    detach_xdp_all();
     rateLimiter_bpf__destroy(skel);
+#if RL_HAVE_LIBBPF_EXT
+    if (btf_warm)
+        libbpf_vmlinux_btf_release();
+#endif
     return -err;
 }
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// rateLimiter.h
+//
+// Types shared between the eBPF program (rateLimiter.bpf.c) and the
+// userspace loader (rateLimiter.c). Only fixed-size __uXX types are used so
+// the layout is identical on both sides.
+#ifndef __RATELIMITER_H
+#define __RATELIMITER_H
+
+// Which level of the token bucket hierarchy dropped the packet.
+enum rl_drop_reason {
+    RL_DROP_SOURCE    = 0, // per-source-IP bucket empty
+    RL_DROP_PREFIX    = 1, // per-/24 bucket empty
+    RL_DROP_AGGREGATE = 2, // interface-wide aggregate bucket empty
+    RL_DROP_MAX,
+};
+
+// Where the eBPF program gets the time used to refill token buckets.
+enum rl_refill_mode {
+    RL_REFILL_KTIME = 0, // bpf_ktime_get_ns() on every packet
+    RL_REFILL_TIMER = 1, // epoch counter advanced by a bpf_timer
+    RL_REFILL_USER  = 2, // epoch counter advanced by the daemon
+};
+
+// Limits applied by the eBPF program. Lives in .data so the daemon can
+// change it while the program is running (see `set-policy`). A prefix or
+// aggregate rate of 0 disables that level; the per-source rate can't be 0.
+struct rl_policy {
+    __u32 rate_pps;         // packets per second per source IP
+    __u32 burst;            // per-source bucket size
+    __u32 prefix_rate_pps;  // packets per second per source /24
+    __u32 prefix_burst;     // per-/24 bucket size
+    __u32 agg_rate_pps;     // packets per second for the whole interface
+    __u32 agg_burst;        // aggregate bucket size
+    __u32 agg_batch;        // tokens a CPU moves into its local cache at once
+};
+
+// Copies of the policy in .data. The daemon fills in one that isn't in use,
+// switches policy_idx over to it and waits out packets still reading the
+// old one (see publish_policy()).
+#define RL_POLICY_SLOTS 2
+
+// Per-source (and per-/24) token bucket state, value of rate_map/prefix_map.
+struct rate_state {
+    __u64 last_ts_ns;  // last time we updated tokens
+    __u32 tokens;      // current tokens
+    __u32 dropped;     // total dropped
+};
+
+// Packet counters, one slot per CPU in stats_map.
+struct rl_stats {
+    __u64 packets;                // IPv4 packets inspected
+    __u64 passed;                 // packets allowed through
+    __u64 dropped[RL_DROP_MAX];   // packets dropped, by reason
+};
+
+// The XDP variant counts tokens in 1/RL_XDP_TOKEN_SCALE of a packet, so a
+// rate that isn't a whole number of packets per epoch still adds up exactly.
+#define RL_XDP_TOKEN_SCALE 1000
+
+// Configuration of the offload-friendly XDP variant (rateLimiter_xdp.bpf.c),
+// single entry of xdp_cfg_map. Time is counted in epochs advanced by
+// userspace, and rates are pre-scaled to tokens per epoch so the datapath
+// never divides. Token amounts are scaled by RL_XDP_TOKEN_SCALE.
+struct rl_xdp_cfg {
+    __u64 max_tokens;        // per-source bucket size (burst)
+    __u32 tokens_per_epoch;  // rate_pps * quantum, at least 1
+    __u32 refill_epochs;     // epochs it takes to fill an empty bucket
+};
+
+// Per-source state of the XDP variant, value of xdp_rate_map.
+struct rl_xdp_state {
+    __u64 last_epoch;  // epoch of the last refill
+    __u64 tokens;      // current tokens, scaled by RL_XDP_TOKEN_SCALE
+    __u32 dropped;     // total dropped
+};
+
+// Number of heavy-hitter slots kept in topn_map (power of two).
+#define RL_TOPN_SLOTS 32
+
+// One tracked offender. count over-estimates the real number of drops by at
+// most error (Space-Saving guarantee).
+struct rl_topn_slot {
+    __u32 src_ip;   // IPv4 saddr, network byte order
+    __u32 count;    // estimated drops (decayed)
+    __u32 error;    // maximum over-estimation of count
+    __u32 pad;
+};
+
+// Space-Saving summary of the most rate-limited sources, maintained by the
+// eBPF program on the drop path, one per CPU (topn_map is indexed by CPU).
+// Userspace reads each with BPF_F_LOCK to get a consistent snapshot and
+// merges them.
+struct rl_topn {
+    struct bpf_spin_lock lock;
+    __u32 pad;
+    __u64 decay_ts_ns;  // last time all counts were halved
+    struct rl_topn_slot slots[RL_TOPN_SLOTS];
+};
+
+// Event sent from the eBPF program to userspace through the ring buffer
+// every time a packet is dropped.
+struct event {
+    __u32 src_ip;   // IPv4 saddr, network byte order
+    __u32 reason;   // enum rl_drop_reason
+    __u64 ts_ns;    // timestamp in ns
+    __u32 dropped;  // total dropped so far for this IP
+};
+
+#endif /* __RATELIMITER_H */
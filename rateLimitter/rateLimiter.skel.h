@@ -1,869 +0,0 @@
-/* SPDX-License-Identifier: (LGPL-2.1 OR BSD-2-Clause) */
-
-/* THIS FILE IS AUTOGENERATED BY BPFTOOL! */
-#ifndef __RATELIMITER_BPF_SKEL_H__
-#define __RATELIMITER_BPF_SKEL_H__
-
-#include <errno.h>
-#include <stdlib.h>
-#include <bpf/libbpf.h>
-
-#define BPF_SKEL_SUPPORTS_MAP_AUTO_ATTACH 1
-
-struct rateLimiter_bpf {
-	struct bpf_object_skeleton *skeleton;
-	struct bpf_object *obj;
-	struct {
-		struct bpf_map *rate_map;
-		struct bpf_map *rb;
-		struct bpf_map *rodata;
-	} maps;
-	struct {
-		struct bpf_program *tc_ingress;
-	} progs;
-	struct {
-		struct bpf_link *tc_ingress;
-	} links;
-	struct rateLimiter_bpf__rodata {
-		int rate_limit_pps;
-		int burst;
-	} *rodata;
-
-#ifdef __cplusplus
-	static inline struct rateLimiter_bpf *open(const struct bpf_object_open_opts *opts = nullptr);
-	static inline struct rateLimiter_bpf *open_and_load();
-	static inline int load(struct rateLimiter_bpf *skel);
-	static inline int attach(struct rateLimiter_bpf *skel);
-	static inline void detach(struct rateLimiter_bpf *skel);
-	static inline void destroy(struct rateLimiter_bpf *skel);
-	static inline const void *elf_bytes(size_t *sz);
-#endif /* __cplusplus */
-};
-
-static void
-rateLimiter_bpf__destroy(struct rateLimiter_bpf *obj)
-{
-	if (!obj)
-		return;
-	if (obj->skeleton)
-		bpf_object__destroy_skeleton(obj->skeleton);
-	free(obj);
-}
-
-static inline int
-rateLimiter_bpf__create_skeleton(struct rateLimiter_bpf *obj);
-
-static inline struct rateLimiter_bpf *
-rateLimiter_bpf__open_opts(const struct bpf_object_open_opts *opts)
-{
-	struct rateLimiter_bpf *obj;
-	int err;
-
-	obj = (struct rateLimiter_bpf *)calloc(1, sizeof(*obj));
-	if (!obj) {
-		errno = ENOMEM;
-		return NULL;
-	}
-
-	err = rateLimiter_bpf__create_skeleton(obj);
-	if (err)
-		goto err_out;
-
-	err = bpf_object__open_skeleton(obj->skeleton, opts);
-	if (err)
-		goto err_out;
-
-	return obj;
-err_out:
-	rateLimiter_bpf__destroy(obj);
-	errno = -err;
-	return NULL;
-}
-
-static inline struct rateLimiter_bpf *
-rateLimiter_bpf__open(void)
-{
-	return rateLimiter_bpf__open_opts(NULL);
-}
-
-static inline int
-rateLimiter_bpf__load(struct rateLimiter_bpf *obj)
-{
-	return bpf_object__load_skeleton(obj->skeleton);
-}
-
-static inline struct rateLimiter_bpf *
-rateLimiter_bpf__open_and_load(void)
-{
-	struct rateLimiter_bpf *obj;
-	int err;
-
-	obj = rateLimiter_bpf__open();
-	if (!obj)
-		return NULL;
-	err = rateLimiter_bpf__load(obj);
-	if (err) {
-		rateLimiter_bpf__destroy(obj);
-		errno = -err;
-		return NULL;
-	}
-	return obj;
-}
-
-static inline int
-rateLimiter_bpf__attach(struct rateLimiter_bpf *obj)
-{
-	return bpf_object__attach_skeleton(obj->skeleton);
-}
-
-static inline void
-rateLimiter_bpf__detach(struct rateLimiter_bpf *obj)
-{
-	bpf_object__detach_skeleton(obj->skeleton);
-}
-
-static inline const void *rateLimiter_bpf__elf_bytes(size_t *sz);
-
-static inline int
-rateLimiter_bpf__create_skeleton(struct rateLimiter_bpf *obj)
-{
-	struct bpf_object_skeleton *s;
-	struct bpf_map_skeleton *map __attribute__((unused));
-	int err;
-
-	s = (struct bpf_object_skeleton *)calloc(1, sizeof(*s));
-	if (!s)	{
-		err = -ENOMEM;
-		goto err;
-	}
-
-	s->sz = sizeof(*s);
-	s->name = "rateLimiter_bpf";
-	s->obj = &obj->obj;
-
-	/* maps */
-	s->map_cnt = 3;
-	s->map_skel_sz = 24;
-	s->maps = (struct bpf_map_skeleton *)calloc(s->map_cnt,
-			sizeof(*s->maps) > 24 ? sizeof(*s->maps) : 24);
-	if (!s->maps) {
-		err = -ENOMEM;
-		goto err;
-	}
-
-	map = (struct bpf_map_skeleton *)((char *)s->maps + 0 * s->map_skel_sz);
-	map->name = "rate_map";
-	map->map = &obj->maps.rate_map;
-
-	map = (struct bpf_map_skeleton *)((char *)s->maps + 1 * s->map_skel_sz);
-	map->name = "rb";
-	map->map = &obj->maps.rb;
-
-	map = (struct bpf_map_skeleton *)((char *)s->maps + 2 * s->map_skel_sz);
-	map->name = "rateLimi.rodata";
-	map->map = &obj->maps.rodata;
-	map->mmaped = (void **)&obj->rodata;
-
-	/* programs */
-	s->prog_cnt = 1;
-	s->prog_skel_sz = sizeof(*s->progs);
-	s->progs = (struct bpf_prog_skeleton *)calloc(s->prog_cnt, s->prog_skel_sz);
-	if (!s->progs) {
-		err = -ENOMEM;
-		goto err;
-	}
-
-	s->progs[0].name = "tc_ingress";
-	s->progs[0].prog = &obj->progs.tc_ingress;
-	s->progs[0].link = &obj->links.tc_ingress;
-
-	s->data = rateLimiter_bpf__elf_bytes(&s->data_sz);
-
-	obj->skeleton = s;
-	return 0;
-err:
-	bpf_object__destroy_skeleton(s);
-	return err;
-}
-
-static inline const void *rateLimiter_bpf__elf_bytes(size_t *sz)
-{
-	static const char data[] __attribute__((__aligned__(8))) = "\
-\x7f\x45\x4c\x46\x02\x01\x01\0\0\0\0\0\0\0\0\0\x01\0\xf7\0\x01\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\x80\x3a\0\0\0\0\0\0\0\0\0\0\x40\0\0\0\0\0\x40\0\x1d\0\
-\x01\0\xb7\0\0\0\0\0\0\0\x61\x12\x10\0\0\0\0\0\x55\x02\x62\0\x08\0\0\0\x61\x12\
-\x4c\0\0\0\0\0\x61\x13\x50\0\0\0\0\0\xbf\x21\0\0\0\0\0\0\x07\x01\0\0\x0e\0\0\0\
-\x2d\x31\x5d\0\0\0\0\0\x07\x02\0\0\x22\0\0\0\x2d\x32\x5b\0\0\0\0\0\x61\x11\x0c\
-\0\0\0\0\0\x63\x1a\xfc\xff\0\0\0\0\x85\0\0\0\x05\0\0\0\xbf\x06\0\0\0\0\0\0\xbf\
-\xa2\0\0\0\0\0\0\x07\x02\0\0\xfc\xff\xff\xff\x18\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\x85\0\0\0\x01\0\0\0\x55\0\x18\0\0\0\0\0\x7b\x6a\xe8\xff\0\0\0\0\xb7\x01\0\0\
-\0\0\0\0\x7b\x1a\xf0\xff\0\0\0\0\x18\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x61\x23\0\
-\0\0\0\0\0\x67\x03\0\0\x20\0\0\0\xc7\x03\0\0\x20\0\0\0\xb7\x04\0\0\x01\0\0\0\
-\x6d\x34\x03\0\0\0\0\0\x61\x22\0\0\0\0\0\0\x07\x02\0\0\xff\xff\xff\xff\x63\x2a\
-\xf0\xff\0\0\0\0\x63\x1a\xf4\xff\0\0\0\0\xbf\xa2\0\0\0\0\0\0\x07\x02\0\0\xfc\
-\xff\xff\xff\xbf\xa3\0\0\0\0\0\0\x07\x03\0\0\xe8\xff\xff\xff\x18\x01\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\xb7\x04\0\0\0\0\0\0\x85\0\0\0\x02\0\0\0\xb7\0\0\0\0\0\0\0\
-\x05\0\x39\0\0\0\0\0\x79\x02\0\0\0\0\0\0\x18\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\x61\x11\0\0\0\0\0\0\x67\x01\0\0\x20\0\0\0\xc7\x01\0\0\x20\0\0\0\xb7\x03\0\0\
-\x01\0\0\0\x6d\x13\x17\0\0\0\0\0\x1d\x26\x16\0\0\0\0\0\xbf\x61\0\0\0\0\0\0\x1f\
-\x21\0\0\0\0\0\0\x18\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x61\x22\0\0\0\0\0\0\x67\
-\x02\0\0\x20\0\0\0\xc7\x02\0\0\x20\0\0\0\x2f\x21\0\0\0\0\0\0\xb7\x02\0\0\0\xca\
-\x9a\x3b\x2d\x12\x0c\0\0\0\0\0\x61\x02\x08\0\0\0\0\0\x37\x01\0\0\0\xca\x9a\x3b\
-\x0f\x21\0\0\0\0\0\0\x18\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x61\x23\0\0\0\0\0\0\
-\x67\x03\0\0\x20\0\0\0\xc7\x03\0\0\x20\0\0\0\x3d\x13\x01\0\0\0\0\0\x61\x21\0\0\
-\0\0\0\0\x7b\x60\0\0\0\0\0\0\x63\x10\x08\0\0\0\0\0\x61\x01\x08\0\0\0\0\0\x15\
-\x01\x04\0\0\0\0\0\x07\x01\0\0\xff\xff\xff\xff\x63\x10\x08\0\0\0\0\0\xb7\0\0\0\
-\0\0\0\0\x05\0\x14\0\0\0\0\0\x61\x01\x0c\0\0\0\0\0\x07\x01\0\0\x01\0\0\0\xbf\
-\x07\0\0\0\0\0\0\x63\x10\x0c\0\0\0\0\0\x18\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xb7\
-\x02\0\0\x18\0\0\0\xb7\x03\0\0\0\0\0\0\x85\0\0\0\x83\0\0\0\xbf\x01\0\0\0\0\0\0\
-\xb7\0\0\0\x02\0\0\0\x15\x01\x08\0\0\0\0\0\x61\xa2\xfc\xff\0\0\0\0\x7b\x61\x08\
-\0\0\0\0\0\x63\x21\0\0\0\0\0\0\x61\x72\x0c\0\0\0\0\0\x63\x21\x10\0\0\0\0\0\xb7\
-\x02\0\0\0\0\0\0\x85\0\0\0\x84\0\0\0\xb7\0\0\0\x02\0\0\0\x95\0\0\0\0\0\0\0\x44\
-\x75\x61\x6c\x20\x42\x53\x44\x2f\x47\x50\x4c\0\0\0\0\xe8\x03\0\0\xc8\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\xcf\0\0\0\x05\0\x08\0\x0a\0\0\0\x28\0\0\0\x2e\0\0\0\x72\0\0\0\
-\x78\0\0\0\x7e\0\0\0\x85\0\0\0\x9b\0\0\0\xaf\0\0\0\xb7\0\0\0\xbf\0\0\0\x04\0\
-\x30\x01\x51\0\x04\0\xa0\x01\x02\x7a\0\x04\xa0\x01\xb8\x01\x08\x30\x9f\x93\x08\
-\x7a\x08\x93\x08\x04\xb8\x01\x88\x02\x08\x7a\0\x93\x08\x7a\x08\x93\x08\x04\x88\
-\x02\x90\x02\x04\x7a\0\x93\x08\x04\x90\x02\xe0\x02\x08\x7a\0\x93\x0c\x7a\x0c\
-\x93\x04\x04\xe0\x02\xa8\x06\x02\x7a\0\0\x04\x28\x48\x01\x52\0\x04\x28\x48\x01\
-\x52\0\x04\x70\xa8\x06\x01\x56\0\x04\x98\x01\xd0\x02\x01\x50\x04\xe0\x02\x80\
-\x05\x01\x50\x04\x88\x05\xd0\x05\x01\x50\0\x04\xe8\x02\xb8\x03\x06\x76\0\x72\0\
-\x1c\x9f\x04\xb8\x03\xe8\x03\x01\x51\0\x04\x88\x04\x90\x04\x01\x51\0\x04\x90\
-\x04\xd8\x04\x01\x51\0\x04\xd8\x05\xa0\x06\x01\x51\0\x01\x11\x01\x25\x25\x13\
-\x05\x03\x25\x72\x17\x10\x17\x1b\x25\x11\x1b\x12\x06\x73\x17\x74\x17\x8c\x01\
-\x17\0\0\x02\x34\0\x03\x25\x49\x13\x3f\x19\x3a\x0b\x3b\x0b\x02\x18\0\0\x03\x01\
-\x01\x49\x13\0\0\x04\x21\0\x49\x13\x37\x0b\0\0\x05\x24\0\x03\x25\x3e\x0b\x0b\
-\x0b\0\0\x06\x24\0\x03\x25\x0b\x0b\x3e\x0b\0\0\x07\x26\0\x49\x13\0\0\x08\x35\0\
-\x49\x13\0\0\x09\x13\x01\x0b\x0b\x3a\x0b\x3b\x0b\0\0\x0a\x0d\0\x03\x25\x49\x13\
-\x3a\x0b\x3b\x0b\x38\x0b\0\0\x0b\x0f\0\x49\x13\0\0\x0c\x21\0\x49\x13\x37\x06\0\
-\0\x0d\x21\0\x49\x13\x37\x05\0\0\x0e\x16\0\x49\x13\x03\x25\x3a\x0b\x3b\x05\0\0\
-\x0f\x13\x01\x03\x25\x0b\x0b\x3a\x0b\x3b\x0b\0\0\x10\x34\0\x03\x25\x49\x13\x3a\
-\x0b\x3b\x0b\x1c\x0f\0\0\x11\x15\0\x49\x13\x27\x19\0\0\x12\x15\x01\x49\x13\x27\
-\x19\0\0\x13\x05\0\x49\x13\0\0\x14\x0f\0\0\0\x15\x26\0\0\0\x16\x34\0\x03\x25\
-\x49\x13\x3a\x0b\x3b\x05\x1c\x0f\0\0\x17\x15\x01\x27\x19\0\0\x18\x04\x01\x49\
-\x13\x0b\x0b\x3a\x0b\x3b\x05\0\0\x19\x28\0\x03\x25\x1c\x0f\0\0\x1a\x13\x01\x03\
-\x25\x0b\x0b\x3a\x0b\x3b\x05\0\0\x1b\x0d\0\x03\x25\x49\x13\x3a\x0b\x3b\x05\x0d\
-\x0b\x6b\x0b\0\0\x1c\x0d\0\x03\x25\x49\x13\x3a\x0b\x3b\x05\x38\x0b\0\0\x1d\x0d\
-\0\x49\x13\x3a\x0b\x3b\x05\x38\x0b\0\0\x1e\x17\x01\x0b\x0b\x3a\x0b\x3b\x05\0\0\
-\x1f\x13\x01\x0b\x0b\x3a\x0b\x3b\x05\0\0\x20\x2e\x01\x11\x1b\x12\x06\x40\x18\
-\x7a\x19\x03\x25\x3a\x0b\x3b\x0b\x27\x19\x49\x13\x3f\x19\0\0\x21\x05\0\x02\x22\
-\x03\x25\x3a\x0b\x3b\x0b\x49\x13\0\0\x22\x34\0\x02\x18\x03\x25\x3a\x0b\x3b\x0b\
-\x49\x13\0\0\x23\x34\0\x02\x22\x03\x25\x3a\x0b\x3b\x0b\x49\x13\0\0\x24\x34\0\
-\x03\x25\x3a\x0b\x3b\x0b\x49\x13\0\0\x25\x0b\x01\x11\x1b\x12\x06\0\0\x26\x0b\
-\x01\x55\x23\0\0\0\xf7\x06\0\0\x05\0\x01\x08\0\0\0\0\x01\0\x1d\0\x01\x08\0\0\0\
-\0\0\0\0\x02\x05\x30\x03\0\0\x08\0\0\0\x0c\0\0\0\x0c\0\0\0\x02\x03\x36\0\0\0\0\
-\x07\x02\xa1\0\x03\x42\0\0\0\x04\x46\0\0\0\x0d\0\x05\x04\x06\x01\x06\x05\x08\
-\x07\x02\x06\x55\0\0\0\0\x13\x02\xa1\x01\x07\x5a\0\0\0\x08\x5f\0\0\0\x05\x07\
-\x05\x04\x02\x08\x55\0\0\0\0\x15\x02\xa1\x02\x02\x09\x79\0\0\0\0\x2a\x02\xa1\
-\x03\x09\x10\0\x26\x0a\x0a\x90\0\0\0\0\x28\0\x0a\x0b\xa1\0\0\0\0\x29\x08\0\x0b\
-\x95\0\0\0\x03\x5f\0\0\0\x04\x46\0\0\0\x1b\0\x0b\xa6\0\0\0\x03\x5f\0\0\0\x0c\
-\x46\0\0\0\0\0\x04\0\0\x02\x0c\xc0\0\0\0\0\x39\x02\xa1\x04\x09\x20\0\x34\x0a\
-\x0a\xe9\0\0\0\0\x35\0\x0a\x0b\xfa\0\0\0\0\x36\x08\x0a\x0d\x0c\x01\0\0\0\x37\
-\x10\x0a\x10\x1e\x01\0\0\0\x38\x18\0\x0b\xee\0\0\0\x03\x5f\0\0\0\x04\x46\0\0\0\
-\x01\0\x0b\xff\0\0\0\x03\x5f\0\0\0\x0d\x46\0\0\0\0\x40\0\x0b\x11\x01\0\0\x0e\
-\x1a\x01\0\0\x0f\x01\x52\x79\x05\x0e\x07\x04\x0b\x23\x01\0\0\x0f\x16\x10\0\x2e\
-\x0a\x11\x44\x01\0\0\0\x2f\0\x0a\x14\x11\x01\0\0\0\x30\x08\x0a\x15\x11\x01\0\0\
-\0\x31\x0c\0\x0e\x4d\x01\0\0\x13\x01\xf0\x77\x05\x12\x07\x08\x10\x17\x5a\x01\0\
-\0\x02\x72\x05\x0b\x5f\x01\0\0\x11\x44\x01\0\0\x10\x18\x6d\x01\0\0\x02\x38\x01\
-\x0b\x72\x01\0\0\x12\x82\x01\0\0\x13\x82\x01\0\0\x13\x83\x01\0\0\0\x14\x0b\x88\
-\x01\0\0\x15\x10\x19\x92\x01\0\0\x02\x4e\x02\x0b\x97\x01\0\0\x12\xb1\x01\0\0\
-\x13\x82\x01\0\0\x13\x83\x01\0\0\x13\x83\x01\0\0\x13\x44\x01\0\0\0\x05\x1a\x05\
-\x08\x16\x1b\xc0\x01\0\0\x02\x68\x0c\x83\x01\x0b\xc5\x01\0\0\x12\x82\x01\0\0\
-\x13\x82\x01\0\0\x13\x44\x01\0\0\x13\x44\x01\0\0\0\x16\x1c\xe5\x01\0\0\x02\x7a\
-\x0c\x84\x01\x0b\xea\x01\0\0\x17\x13\x82\x01\0\0\x13\x44\x01\0\0\0\x18\x1a\x01\
-\0\0\x04\x01\x2e\x03\x19\x1d\0\x19\x1e\x01\x19\x1f\x02\x19\x20\x04\0\x0e\x15\
-\x02\0\0\x22\x01\xa2\x78\x05\x21\x07\x02\x0b\x1e\x02\0\0\x1a\x34\x14\x01\xb9\
-\xec\x1b\x23\xd7\x02\0\0\x01\xba\xec\x04\0\x1b\x26\xd7\x02\0\0\x01\xbb\xec\x04\
-\x04\x1c\x27\xd7\x02\0\0\x01\xbc\xec\x01\x1c\x28\xe4\x02\0\0\x01\xbd\xec\x02\
-\x1c\x2a\xe4\x02\0\0\x01\xbe\xec\x04\x1c\x2b\xe4\x02\0\0\x01\xbf\xec\x06\x1c\
-\x2c\xd7\x02\0\0\x01\xc0\xec\x08\x1c\x2d\xd7\x02\0\0\x01\xc1\xec\x09\x1c\x2e\
-\xed\x02\0\0\x01\xc2\xec\x0a\x1d\x89\x02\0\0\x01\xc3\xec\x0c\x1e\x08\x01\xc3\
-\xec\x1d\x97\x02\0\0\x01\xc4\xec\0\x1f\x08\x01\xc4\xec\x1c\x30\xf6\x02\0\0\x01\
-\xc5\xec\0\x1c\x32\xf6\x02\0\0\x01\xc6\xec\x04\0\x1c\x33\xbb\x02\0\0\x01\xcb\
-\xec\0\x1f\x08\x01\xc8\xec\x1c\x30\xf6\x02\0\0\x01\xc9\xec\0\x1c\x32\xf6\x02\0\
-\0\x01\xca\xec\x04\0\0\0\x0e\xe0\x02\0\0\x25\x01\x16\x79\x05\x24\x08\x01\x0e\
-\x0c\x02\0\0\x29\x01\xb2\x78\x0e\x0c\x02\0\0\x2f\x01\xc6\x78\x0e\x11\x01\0\0\
-\x31\x01\x72\x79\x20\x05\x30\x03\0\0\x01\x5a\x35\0\x44\x5f\0\0\0\x21\0\x37\0\
-\x44\x8e\x03\0\0\x22\x02\x91\x14\x36\0\x5d\x11\x01\0\0\x23\x01\x76\0\x64\x23\
-\x01\0\0\x23\x02\x77\0\x4c\x9e\x06\0\0\x23\x03\x46\0\x49\x82\x01\0\0\x23\x04\
-\x7c\0\x60\x44\x01\0\0\x23\x05\x7d\0\x63\x1e\x01\0\0\x23\x06\x7e\0\x75\x44\x01\
-\0\0\x23\x09\x80\0\x8f\xd4\x06\0\0\x24\x47\0\x47\x82\x01\0\0\x24\x83\0\x4f\x19\
-\x02\0\0\x25\x06\xa0\0\0\0\x23\x07\x7f\0\x7b\x44\x01\0\0\x26\0\x23\x08\x14\0\
-\x7e\x44\x01\0\0\0\0\0\x0b\x93\x03\0\0\x1a\x75\xc0\x01\x12\x86\x1c\x38\x11\x01\
-\0\0\x01\x13\x86\0\x1c\x39\x11\x01\0\0\x01\x14\x86\x04\x1c\x3a\x11\x01\0\0\x01\
-\x15\x86\x08\x1c\x3b\x11\x01\0\0\x01\x16\x86\x0c\x1c\x2d\x11\x01\0\0\x01\x17\
-\x86\x10\x1c\x3c\x11\x01\0\0\x01\x18\x86\x14\x1c\x3d\x11\x01\0\0\x01\x19\x86\
-\x18\x1c\x3e\x11\x01\0\0\x01\x1a\x86\x1c\x1c\x3f\x11\x01\0\0\x01\x1b\x86\x20\
-\x1c\x40\x11\x01\0\0\x01\x1c\x86\x24\x1c\x41\x11\x01\0\0\x01\x1d\x86\x28\x1c\
-\x42\x11\x01\0\0\x01\x1e\x86\x2c\x1c\x43\x0c\x05\0\0\x01\x1f\x86\x30\x1c\x44\
-\x11\x01\0\0\x01\x20\x86\x44\x1c\x45\x11\x01\0\0\x01\x21\x86\x48\x1c\x46\x11\
-\x01\0\0\x01\x22\x86\x4c\x1c\x47\x11\x01\0\0\x01\x23\x86\x50\x1c\x48\x11\x01\0\
-\0\x01\x24\x86\x54\x1c\x49\x11\x01\0\0\x01\x25\x86\x58\x1c\x4a\x11\x01\0\0\x01\
-\x26\x86\x5c\x1c\x4b\x11\x01\0\0\x01\x27\x86\x60\x1c\x4c\x18\x05\0\0\x01\x28\
-\x86\x64\x1c\x4d\x18\x05\0\0\x01\x29\x86\x74\x1c\x4e\x11\x01\0\0\x01\x2a\x86\
-\x84\x1c\x4f\x11\x01\0\0\x01\x2b\x86\x88\x1c\x50\x11\x01\0\0\x01\x2c\x86\x8c\
-\x1d\xa6\x04\0\0\x01\x2d\x86\x90\x1e\x08\x01\x2d\x86\x1c\x51\x24\x05\0\0\x01\
-\x2e\x86\0\0\x1c\x63\x44\x01\0\0\x01\x30\x86\x98\x1c\x64\x11\x01\0\0\x01\x31\
-\x86\xa0\x1c\x65\x11\x01\0\0\x01\x32\x86\xa4\x1d\xdd\x04\0\0\x01\x33\x86\xa8\
-\x1e\x08\x01\x33\x86\x1c\x66\xfd\x05\0\0\x01\x34\x86\0\0\x1c\x72\x11\x01\0\0\
-\x01\x36\x86\xb0\x1c\x73\xd7\x02\0\0\x01\x37\x86\xb4\x1c\x74\x44\x01\0\0\x01\
-\x38\x86\xb8\0\x03\x11\x01\0\0\x04\x46\0\0\0\x05\0\x03\x11\x01\0\0\x04\x46\0\0\
-\0\x04\0\x0b\x29\x05\0\0\x1a\x62\x38\x01\x7e\xb8\x1c\x52\x0c\x02\0\0\x01\x7f\
-\xb8\0\x1c\x53\x0c\x02\0\0\x01\x80\xb8\x02\x1c\x54\x0c\x02\0\0\x01\x81\xb8\x04\
-\x1c\x55\xd7\x02\0\0\x01\x82\xb8\x06\x1c\x56\xd7\x02\0\0\x01\x83\xb8\x07\x1c\
-\x57\xd7\x02\0\0\x01\x84\xb8\x08\x1c\x58\xd7\x02\0\0\x01\x85\xb8\x09\x1c\x59\
-\xe4\x02\0\0\x01\x86\xb8\x0a\x1c\x5a\xe4\x02\0\0\x01\x87\xb8\x0c\x1c\x5b\xe4\
-\x02\0\0\x01\x88\xb8\x0e\x1d\x9c\x05\0\0\x01\x89\xb8\x10\x1e\x20\x01\x89\xb8\
-\x1d\xaa\x05\0\0\x01\x8a\xb8\0\x1f\x08\x01\x8a\xb8\x1c\x5c\xf6\x02\0\0\x01\x8b\
-\xb8\0\x1c\x5d\xf6\x02\0\0\x01\x8c\xb8\x04\0\x1d\xcd\x05\0\0\x01\x8e\xb8\0\x1f\
-\x20\x01\x8e\xb8\x1c\x5e\x18\x05\0\0\x01\x8f\xb8\0\x1c\x5f\x18\x05\0\0\x01\x90\
-\xb8\x10\0\0\x1c\x60\x11\x01\0\0\x01\x93\xb8\x30\x1c\x61\xf6\x02\0\0\x01\x94\
-\xb8\x34\0\x0b\x02\x06\0\0\x1a\x71\x50\x01\x96\xb5\x1c\x67\x11\x01\0\0\x01\x97\
-\xb5\0\x1c\x49\x11\x01\0\0\x01\x98\xb5\x04\x1c\x0a\x11\x01\0\0\x01\x99\xb5\x08\
-\x1c\x2d\x11\x01\0\0\x01\x9a\xb5\x0c\x1c\x3a\x11\x01\0\0\x01\x9b\xb5\x10\x1c\
-\x3f\x11\x01\0\0\x01\x9c\xb5\x14\x1c\x68\x11\x01\0\0\x01\x9d\xb5\x18\x1c\x69\
-\x18\x05\0\0\x01\x9e\xb5\x1c\x1c\x6a\x11\x01\0\0\x01\x9f\xb5\x2c\x1c\x6b\xe4\
-\x02\0\0\x01\xa0\xb5\x30\x1c\x6c\x11\x01\0\0\x01\xa1\xb5\x34\x1c\x6d\x18\x05\0\
-\0\x01\xa2\xb5\x38\x1c\x6e\x11\x01\0\0\x01\xa3\xb5\x48\x1c\x6f\x95\x06\0\0\x01\
-\xa4\xb5\x4c\0\x0e\x5f\0\0\0\x70\x01\x74\x77\x0b\xa3\x06\0\0\x1a\x7b\x0e\x01\
-\xa1\xdc\x1c\x78\xc8\x06\0\0\x01\xa2\xdc\0\x1c\x79\xc8\x06\0\0\x01\xa3\xdc\x06\
-\x1c\x7a\xe4\x02\0\0\x01\xa4\xdc\x0c\0\x03\xe0\x02\0\0\x04\x46\0\0\0\x06\0\x0b\
-\xd9\x06\0\0\x0f\x82\x18\0\x1b\x0a\x36\x11\x01\0\0\0\x1c\0\x0a\x81\x44\x01\0\0\
-\0\x1d\x08\x0a\x15\x11\x01\0\0\0\x1e\x10\0\0\x17\0\0\0\x05\0\x08\0\x01\0\0\0\
-\x04\0\0\0\x04\xf8\x03\x80\x04\x04\x88\x04\xd8\x04\0\x14\x02\0\0\x05\0\0\0\0\0\
-\0\0\x27\0\0\0\x39\0\0\0\x6e\0\0\0\x76\0\0\0\x7b\0\0\0\x8f\0\0\0\x9e\0\0\0\xa2\
-\0\0\0\xa8\0\0\0\xab\0\0\0\xb0\0\0\0\xbc\0\0\0\xc5\0\0\0\xc9\0\0\0\xd6\0\0\0\
-\xdc\0\0\0\xe2\0\0\0\xed\0\0\0\0\x01\0\0\x06\x01\0\0\x0d\x01\0\0\x15\x01\0\0\
-\x20\x01\0\0\x31\x01\0\0\x45\x01\0\0\x59\x01\0\0\x5e\x01\0\0\x72\x01\0\0\x85\
-\x01\0\0\x8d\x01\0\0\x99\x01\0\0\xa3\x01\0\0\xae\x01\0\0\xbd\x01\0\0\xc3\x01\0\
-\0\xc7\x01\0\0\xd5\x01\0\0\xda\x01\0\0\xe2\x01\0\0\xe6\x01\0\0\xee\x01\0\0\xf5\
-\x01\0\0\xf8\x01\0\0\x01\x02\0\0\x05\x02\0\0\x0e\x02\0\0\x14\x02\0\0\x1c\x02\0\
-\0\x22\x02\0\0\x29\x02\0\0\x2f\x02\0\0\x35\x02\0\0\x3b\x02\0\0\x46\x02\0\0\x4d\
-\x02\0\0\x51\x02\0\0\x55\x02\0\0\x5e\x02\0\0\x63\x02\0\0\x71\x02\0\0\x7e\x02\0\
-\0\x87\x02\0\0\x92\x02\0\0\x9b\x02\0\0\xab\x02\0\0\xb3\x02\0\0\xbc\x02\0\0\xbf\
-\x02\0\0\xc4\x02\0\0\xcf\x02\0\0\xd4\x02\0\0\xdd\x02\0\0\xe5\x02\0\0\xec\x02\0\
-\0\xf7\x02\0\0\x01\x03\0\0\x0c\x03\0\0\x16\x03\0\0\x22\x03\0\0\x2d\x03\0\0\x37\
-\x03\0\0\x41\x03\0\0\x47\x03\0\0\x4d\x03\0\0\x58\x03\0\0\x60\x03\0\0\x6e\x03\0\
-\0\x77\x03\0\0\x80\x03\0\0\x88\x03\0\0\x8e\x03\0\0\x94\x03\0\0\x9d\x03\0\0\xa6\
-\x03\0\0\xaf\x03\0\0\xb8\x03\0\0\xbe\x03\0\0\xc9\x03\0\0\xd7\x03\0\0\xde\x03\0\
-\0\xe7\x03\0\0\xf0\x03\0\0\xf3\x03\0\0\0\x04\0\0\x08\x04\0\0\x10\x04\0\0\x19\
-\x04\0\0\x22\x04\0\0\x2a\x04\0\0\x32\x04\0\0\x38\x04\0\0\x49\x04\0\0\x4f\x04\0\
-\0\x58\x04\0\0\x61\x04\0\0\x6d\x04\0\0\x76\x04\0\0\x80\x04\0\0\x87\x04\0\0\x8a\
-\x04\0\0\x91\x04\0\0\x9a\x04\0\0\xa2\x04\0\0\xa9\x04\0\0\xb0\x04\0\0\xb3\x04\0\
-\0\xbb\x04\0\0\xbf\x04\0\0\xc1\x04\0\0\xc7\x04\0\0\xcd\x04\0\0\x55\x62\x75\x6e\
-\x74\x75\x20\x63\x6c\x61\x6e\x67\x20\x76\x65\x72\x73\x69\x6f\x6e\x20\x31\x38\
-\x2e\x31\x2e\x33\x20\x28\x31\x75\x62\x75\x6e\x74\x75\x31\x29\0\x72\x61\x74\x65\
-\x4c\x69\x6d\x69\x74\x65\x72\x2e\x62\x70\x66\x2e\x63\0\x2f\x68\x6f\x6d\x65\x2f\
-\x69\x69\x69\x74\x62\x2f\x44\x6f\x63\x75\x6d\x65\x6e\x74\x73\x2f\x61\x6a\x69\
-\x74\x65\x73\x68\x5f\x57\x6f\x72\x6b\x73\x70\x61\x63\x65\x2f\x72\x61\x74\x65\
-\x4c\x69\x6d\x69\x74\x74\x65\x72\0\x4c\x49\x43\x45\x4e\x53\x45\0\x63\x68\x61\
-\x72\0\x5f\x5f\x41\x52\x52\x41\x59\x5f\x53\x49\x5a\x45\x5f\x54\x59\x50\x45\x5f\
-\x5f\0\x72\x61\x74\x65\x5f\x6c\x69\x6d\x69\x74\x5f\x70\x70\x73\0\x69\x6e\x74\0\
-\x62\x75\x72\x73\x74\0\x72\x62\0\x74\x79\x70\x65\0\x6d\x61\x78\x5f\x65\x6e\x74\
-\x72\x69\x65\x73\0\x72\x61\x74\x65\x5f\x6d\x61\x70\0\x6b\x65\x79\0\x75\x6e\x73\
-\x69\x67\x6e\x65\x64\x20\x69\x6e\x74\0\x5f\x5f\x75\x33\x32\0\x76\x61\x6c\x75\
-\x65\0\x6c\x61\x73\x74\x5f\x74\x73\x5f\x6e\x73\0\x75\x6e\x73\x69\x67\x6e\x65\
-\x64\x20\x6c\x6f\x6e\x67\x20\x6c\x6f\x6e\x67\0\x5f\x5f\x75\x36\x34\0\x74\x6f\
-\x6b\x65\x6e\x73\0\x64\x72\x6f\x70\x70\x65\x64\0\x72\x61\x74\x65\x5f\x73\x74\
-\x61\x74\x65\0\x62\x70\x66\x5f\x6b\x74\x69\x6d\x65\x5f\x67\x65\x74\x5f\x6e\x73\
-\0\x62\x70\x66\x5f\x6d\x61\x70\x5f\x6c\x6f\x6f\x6b\x75\x70\x5f\x65\x6c\x65\x6d\
-\0\x62\x70\x66\x5f\x6d\x61\x70\x5f\x75\x70\x64\x61\x74\x65\x5f\x65\x6c\x65\x6d\
-\0\x6c\x6f\x6e\x67\0\x62\x70\x66\x5f\x72\x69\x6e\x67\x62\x75\x66\x5f\x72\x65\
-\x73\x65\x72\x76\x65\0\x62\x70\x66\x5f\x72\x69\x6e\x67\x62\x75\x66\x5f\x73\x75\
-\x62\x6d\x69\x74\0\x42\x50\x46\x5f\x41\x4e\x59\0\x42\x50\x46\x5f\x4e\x4f\x45\
-\x58\x49\x53\x54\0\x42\x50\x46\x5f\x45\x58\x49\x53\x54\0\x42\x50\x46\x5f\x46\
-\x5f\x4c\x4f\x43\x4b\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x73\x68\x6f\x72\x74\
-\0\x5f\x5f\x75\x31\x36\0\x69\x68\x6c\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x63\
-\x68\x61\x72\0\x5f\x5f\x75\x38\0\x76\x65\x72\x73\x69\x6f\x6e\0\x74\x6f\x73\0\
-\x74\x6f\x74\x5f\x6c\x65\x6e\0\x5f\x5f\x62\x65\x31\x36\0\x69\x64\0\x66\x72\x61\
-\x67\x5f\x6f\x66\x66\0\x74\x74\x6c\0\x70\x72\x6f\x74\x6f\x63\x6f\x6c\0\x63\x68\
-\x65\x63\x6b\0\x5f\x5f\x73\x75\x6d\x31\x36\0\x73\x61\x64\x64\x72\0\x5f\x5f\x62\
-\x65\x33\x32\0\x64\x61\x64\x64\x72\0\x61\x64\x64\x72\x73\0\x69\x70\x68\x64\x72\
-\0\x74\x63\x5f\x69\x6e\x67\x72\x65\x73\x73\0\x73\x72\x63\x5f\x69\x70\0\x63\x74\
-\x78\0\x6c\x65\x6e\0\x70\x6b\x74\x5f\x74\x79\x70\x65\0\x6d\x61\x72\x6b\0\x71\
-\x75\x65\x75\x65\x5f\x6d\x61\x70\x70\x69\x6e\x67\0\x76\x6c\x61\x6e\x5f\x70\x72\
-\x65\x73\x65\x6e\x74\0\x76\x6c\x61\x6e\x5f\x74\x63\x69\0\x76\x6c\x61\x6e\x5f\
-\x70\x72\x6f\x74\x6f\0\x70\x72\x69\x6f\x72\x69\x74\x79\0\x69\x6e\x67\x72\x65\
-\x73\x73\x5f\x69\x66\x69\x6e\x64\x65\x78\0\x69\x66\x69\x6e\x64\x65\x78\0\x74\
-\x63\x5f\x69\x6e\x64\x65\x78\0\x63\x62\0\x68\x61\x73\x68\0\x74\x63\x5f\x63\x6c\
-\x61\x73\x73\x69\x64\0\x64\x61\x74\x61\0\x64\x61\x74\x61\x5f\x65\x6e\x64\0\x6e\
-\x61\x70\x69\x5f\x69\x64\0\x66\x61\x6d\x69\x6c\x79\0\x72\x65\x6d\x6f\x74\x65\
-\x5f\x69\x70\x34\0\x6c\x6f\x63\x61\x6c\x5f\x69\x70\x34\0\x72\x65\x6d\x6f\x74\
-\x65\x5f\x69\x70\x36\0\x6c\x6f\x63\x61\x6c\x5f\x69\x70\x36\0\x72\x65\x6d\x6f\
-\x74\x65\x5f\x70\x6f\x72\x74\0\x6c\x6f\x63\x61\x6c\x5f\x70\x6f\x72\x74\0\x64\
-\x61\x74\x61\x5f\x6d\x65\x74\x61\0\x66\x6c\x6f\x77\x5f\x6b\x65\x79\x73\0\x6e\
-\x68\x6f\x66\x66\0\x74\x68\x6f\x66\x66\0\x61\x64\x64\x72\x5f\x70\x72\x6f\x74\
-\x6f\0\x69\x73\x5f\x66\x72\x61\x67\0\x69\x73\x5f\x66\x69\x72\x73\x74\x5f\x66\
-\x72\x61\x67\0\x69\x73\x5f\x65\x6e\x63\x61\x70\0\x69\x70\x5f\x70\x72\x6f\x74\
-\x6f\0\x6e\x5f\x70\x72\x6f\x74\x6f\0\x73\x70\x6f\x72\x74\0\x64\x70\x6f\x72\x74\
-\0\x69\x70\x76\x34\x5f\x73\x72\x63\0\x69\x70\x76\x34\x5f\x64\x73\x74\0\x69\x70\
-\x76\x36\x5f\x73\x72\x63\0\x69\x70\x76\x36\x5f\x64\x73\x74\0\x66\x6c\x61\x67\
-\x73\0\x66\x6c\x6f\x77\x5f\x6c\x61\x62\x65\x6c\0\x62\x70\x66\x5f\x66\x6c\x6f\
-\x77\x5f\x6b\x65\x79\x73\0\x74\x73\x74\x61\x6d\x70\0\x77\x69\x72\x65\x5f\x6c\
-\x65\x6e\0\x67\x73\x6f\x5f\x73\x65\x67\x73\0\x73\x6b\0\x62\x6f\x75\x6e\x64\x5f\
-\x64\x65\x76\x5f\x69\x66\0\x73\x72\x63\x5f\x69\x70\x34\0\x73\x72\x63\x5f\x69\
-\x70\x36\0\x73\x72\x63\x5f\x70\x6f\x72\x74\0\x64\x73\x74\x5f\x70\x6f\x72\x74\0\
-\x64\x73\x74\x5f\x69\x70\x34\0\x64\x73\x74\x5f\x69\x70\x36\0\x73\x74\x61\x74\
-\x65\0\x72\x78\x5f\x71\x75\x65\x75\x65\x5f\x6d\x61\x70\x70\x69\x6e\x67\0\x5f\
-\x5f\x73\x33\x32\0\x62\x70\x66\x5f\x73\x6f\x63\x6b\0\x67\x73\x6f\x5f\x73\x69\
-\x7a\x65\0\x74\x73\x74\x61\x6d\x70\x5f\x74\x79\x70\x65\0\x68\x77\x74\x73\x74\
-\x61\x6d\x70\0\x5f\x5f\x73\x6b\x5f\x62\x75\x66\x66\0\x6e\x65\x77\x5f\x73\x74\0\
-\x6c\x32\0\x68\x5f\x64\x65\x73\x74\0\x68\x5f\x73\x6f\x75\x72\x63\x65\0\x68\x5f\
-\x70\x72\x6f\x74\x6f\0\x65\x74\x68\x68\x64\x72\0\x6e\x6f\x77\x5f\x6e\x73\0\x73\
-\x74\0\x65\x6c\x61\x70\x73\x65\x64\0\x61\x64\x64\0\x65\0\x74\x73\x5f\x6e\x73\0\
-\x65\x76\x65\x6e\x74\0\x6c\x33\0\x3c\0\0\0\x05\0\x08\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xb8\
-\x01\0\0\0\0\0\0\0\0\0\x9f\xeb\x01\0\x18\0\0\0\0\0\0\0\x2c\x06\0\0\x2c\x06\0\0\
-\x11\x08\0\0\0\0\0\0\0\0\0\x02\x03\0\0\0\x01\0\0\0\0\0\0\x01\x04\0\0\0\x20\0\0\
-\x01\0\0\0\0\0\0\0\x03\0\0\0\0\x02\0\0\0\x04\0\0\0\x01\0\0\0\x05\0\0\0\0\0\0\
-\x01\x04\0\0\0\x20\0\0\0\0\0\0\0\0\0\0\x02\x06\0\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\
-\x02\0\0\0\x04\0\0\0\0\x40\0\0\0\0\0\0\0\0\0\x02\x08\0\0\0\x19\0\0\0\0\0\0\x08\
-\x09\0\0\0\x1f\0\0\0\0\0\0\x01\x04\0\0\0\x20\0\0\0\0\0\0\0\0\0\0\x02\x0b\0\0\0\
-\x2c\0\0\0\x03\0\0\x04\x10\0\0\0\x37\0\0\0\x0c\0\0\0\0\0\0\0\x42\0\0\0\x08\0\0\
-\0\x40\0\0\0\x49\0\0\0\x08\0\0\0\x60\0\0\0\x51\0\0\0\0\0\0\x08\x0d\0\0\0\x57\0\
-\0\0\0\0\0\x01\x08\0\0\0\x40\0\0\0\0\0\0\0\x04\0\0\x04\x20\0\0\0\x6a\0\0\0\x01\
-\0\0\0\0\0\0\0\x6f\0\0\0\x05\0\0\0\x40\0\0\0\x7b\0\0\0\x07\0\0\0\x80\0\0\0\x7f\
-\0\0\0\x0a\0\0\0\xc0\0\0\0\x85\0\0\0\0\0\0\x0e\x0e\0\0\0\x01\0\0\0\0\0\0\0\0\0\
-\0\x02\x11\0\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x02\0\0\0\x04\0\0\0\x1b\0\0\0\0\0\0\
-\0\0\0\0\x02\x13\0\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x02\0\0\0\x04\0\0\0\0\0\x04\0\
-\0\0\0\0\x02\0\0\x04\x10\0\0\0\x6a\0\0\0\x10\0\0\0\0\0\0\0\x6f\0\0\0\x12\0\0\0\
-\x40\0\0\0\x8e\0\0\0\0\0\0\x0e\x14\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x02\x17\0\0\0\
-\x91\0\0\0\x22\0\0\x04\xc0\0\0\0\x9b\0\0\0\x08\0\0\0\0\0\0\0\x9f\0\0\0\x08\0\0\
-\0\x20\0\0\0\xa8\0\0\0\x08\0\0\0\x40\0\0\0\xad\0\0\0\x08\0\0\0\x60\0\0\0\xbb\0\
-\0\0\x08\0\0\0\x80\0\0\0\xc4\0\0\0\x08\0\0\0\xa0\0\0\0\xd1\0\0\0\x08\0\0\0\xc0\
-\0\0\0\xda\0\0\0\x08\0\0\0\xe0\0\0\0\xe5\0\0\0\x08\0\0\0\0\x01\0\0\xee\0\0\0\
-\x08\0\0\0\x20\x01\0\0\xfe\0\0\0\x08\0\0\0\x40\x01\0\0\x06\x01\0\0\x08\0\0\0\
-\x60\x01\0\0\x0f\x01\0\0\x18\0\0\0\x80\x01\0\0\x12\x01\0\0\x08\0\0\0\x20\x02\0\
-\0\x17\x01\0\0\x08\0\0\0\x40\x02\0\0\x22\x01\0\0\x08\0\0\0\x60\x02\0\0\x27\x01\
-\0\0\x08\0\0\0\x80\x02\0\0\x30\x01\0\0\x08\0\0\0\xa0\x02\0\0\x38\x01\0\0\x08\0\
-\0\0\xc0\x02\0\0\x3f\x01\0\0\x08\0\0\0\xe0\x02\0\0\x4a\x01\0\0\x08\0\0\0\0\x03\
-\0\0\x54\x01\0\0\x19\0\0\0\x20\x03\0\0\x5f\x01\0\0\x19\0\0\0\xa0\x03\0\0\x69\
-\x01\0\0\x08\0\0\0\x20\x04\0\0\x75\x01\0\0\x08\0\0\0\x40\x04\0\0\x80\x01\0\0\
-\x08\0\0\0\x60\x04\0\0\0\0\0\0\x1a\0\0\0\x80\x04\0\0\x8a\x01\0\0\x0c\0\0\0\xc0\
-\x04\0\0\x91\x01\0\0\x08\0\0\0\0\x05\0\0\x9a\x01\0\0\x08\0\0\0\x20\x05\0\0\0\0\
-\0\0\x1c\0\0\0\x40\x05\0\0\xa3\x01\0\0\x08\0\0\0\x80\x05\0\0\xac\x01\0\0\x1e\0\
-\0\0\xa0\x05\0\0\xb8\x01\0\0\x0c\0\0\0\xc0\x05\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\
-\x08\0\0\0\x04\0\0\0\x05\0\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x08\0\0\0\x04\0\0\0\
-\x04\0\0\0\0\0\0\0\x01\0\0\x05\x08\0\0\0\xc1\x01\0\0\x1b\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\x02\x36\0\0\0\0\0\0\0\x01\0\0\x05\x08\0\0\0\xcb\x01\0\0\x1d\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\x02\x35\0\0\0\xce\x01\0\0\0\0\0\x08\x1f\0\0\0\xd3\x01\0\0\0\0\
-\0\x01\x01\0\0\0\x08\0\0\0\0\0\0\0\x01\0\0\x0d\x02\0\0\0\xe1\x01\0\0\x16\0\0\0\
-\xe5\x01\0\0\x01\0\0\x0c\x20\0\0\0\x1d\x03\0\0\x0a\0\0\x84\x14\0\0\0\x23\x03\0\
-\0\x1e\0\0\0\0\0\0\x04\x27\x03\0\0\x1e\0\0\0\x04\0\0\x04\x2f\x03\0\0\x1e\0\0\0\
-\x08\0\0\0\x33\x03\0\0\x23\0\0\0\x10\0\0\0\x3b\x03\0\0\x23\0\0\0\x20\0\0\0\x3e\
-\x03\0\0\x23\0\0\0\x30\0\0\0\x47\x03\0\0\x1e\0\0\0\x40\0\0\0\xbb\0\0\0\x1e\0\0\
-\0\x48\0\0\0\x4b\x03\0\0\x26\0\0\0\x50\0\0\0\0\0\0\0\x27\0\0\0\x60\0\0\0\x51\
-\x03\0\0\0\0\0\x08\x24\0\0\0\x58\x03\0\0\0\0\0\x08\x25\0\0\0\x5e\x03\0\0\0\0\0\
-\x01\x02\0\0\0\x10\0\0\0\x6d\x03\0\0\0\0\0\x08\x24\0\0\0\0\0\0\0\x02\0\0\x05\
-\x08\0\0\0\0\0\0\0\x28\0\0\0\0\0\0\0\x75\x03\0\0\x2a\0\0\0\0\0\0\0\0\0\0\0\x02\
-\0\0\x04\x08\0\0\0\x7b\x03\0\0\x29\0\0\0\0\0\0\0\x81\x03\0\0\x29\0\0\0\x20\0\0\
-\0\x87\x03\0\0\0\0\0\x08\x08\0\0\0\0\0\0\0\x02\0\0\x04\x08\0\0\0\x7b\x03\0\0\
-\x29\0\0\0\0\0\0\0\x81\x03\0\0\x29\0\0\0\x20\0\0\0\xc2\x07\0\0\0\0\0\x01\x01\0\
-\0\0\x08\0\0\x01\0\0\0\0\0\0\0\x03\0\0\0\0\x2b\0\0\0\x04\0\0\0\x0d\0\0\0\xc7\
-\x07\0\0\0\0\0\x0e\x2c\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x0a\x2f\0\0\0\0\0\0\0\0\0\
-\0\x09\x02\0\0\0\xcf\x07\0\0\0\0\0\x0e\x2e\0\0\0\x01\0\0\0\xde\x07\0\0\0\0\0\
-\x0e\x2e\0\0\0\x01\0\0\0\xe4\x07\0\0\x02\0\0\x0f\0\0\0\0\x0f\0\0\0\0\0\0\0\x20\
-\0\0\0\x15\0\0\0\0\0\0\0\x10\0\0\0\xea\x07\0\0\x02\0\0\x0f\0\0\0\0\x30\0\0\0\0\
-\0\0\0\x04\0\0\0\x31\0\0\0\0\0\0\0\x04\0\0\0\xf2\x07\0\0\x01\0\0\x0f\0\0\0\0\
-\x2d\0\0\0\0\0\0\0\x0d\0\0\0\xfa\x07\0\0\0\0\0\x07\0\0\0\0\x03\x08\0\0\0\0\0\
-\x07\0\0\0\0\0\x69\x6e\x74\0\x5f\x5f\x41\x52\x52\x41\x59\x5f\x53\x49\x5a\x45\
-\x5f\x54\x59\x50\x45\x5f\x5f\0\x5f\x5f\x75\x33\x32\0\x75\x6e\x73\x69\x67\x6e\
-\x65\x64\x20\x69\x6e\x74\0\x72\x61\x74\x65\x5f\x73\x74\x61\x74\x65\0\x6c\x61\
-\x73\x74\x5f\x74\x73\x5f\x6e\x73\0\x74\x6f\x6b\x65\x6e\x73\0\x64\x72\x6f\x70\
-\x70\x65\x64\0\x5f\x5f\x75\x36\x34\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x6c\
-\x6f\x6e\x67\x20\x6c\x6f\x6e\x67\0\x74\x79\x70\x65\0\x6d\x61\x78\x5f\x65\x6e\
-\x74\x72\x69\x65\x73\0\x6b\x65\x79\0\x76\x61\x6c\x75\x65\0\x72\x61\x74\x65\x5f\
-\x6d\x61\x70\0\x72\x62\0\x5f\x5f\x73\x6b\x5f\x62\x75\x66\x66\0\x6c\x65\x6e\0\
-\x70\x6b\x74\x5f\x74\x79\x70\x65\0\x6d\x61\x72\x6b\0\x71\x75\x65\x75\x65\x5f\
-\x6d\x61\x70\x70\x69\x6e\x67\0\x70\x72\x6f\x74\x6f\x63\x6f\x6c\0\x76\x6c\x61\
-\x6e\x5f\x70\x72\x65\x73\x65\x6e\x74\0\x76\x6c\x61\x6e\x5f\x74\x63\x69\0\x76\
-\x6c\x61\x6e\x5f\x70\x72\x6f\x74\x6f\0\x70\x72\x69\x6f\x72\x69\x74\x79\0\x69\
-\x6e\x67\x72\x65\x73\x73\x5f\x69\x66\x69\x6e\x64\x65\x78\0\x69\x66\x69\x6e\x64\
-\x65\x78\0\x74\x63\x5f\x69\x6e\x64\x65\x78\0\x63\x62\0\x68\x61\x73\x68\0\x74\
-\x63\x5f\x63\x6c\x61\x73\x73\x69\x64\0\x64\x61\x74\x61\0\x64\x61\x74\x61\x5f\
-\x65\x6e\x64\0\x6e\x61\x70\x69\x5f\x69\x64\0\x66\x61\x6d\x69\x6c\x79\0\x72\x65\
-\x6d\x6f\x74\x65\x5f\x69\x70\x34\0\x6c\x6f\x63\x61\x6c\x5f\x69\x70\x34\0\x72\
-\x65\x6d\x6f\x74\x65\x5f\x69\x70\x36\0\x6c\x6f\x63\x61\x6c\x5f\x69\x70\x36\0\
-\x72\x65\x6d\x6f\x74\x65\x5f\x70\x6f\x72\x74\0\x6c\x6f\x63\x61\x6c\x5f\x70\x6f\
-\x72\x74\0\x64\x61\x74\x61\x5f\x6d\x65\x74\x61\0\x74\x73\x74\x61\x6d\x70\0\x77\
-\x69\x72\x65\x5f\x6c\x65\x6e\0\x67\x73\x6f\x5f\x73\x65\x67\x73\0\x67\x73\x6f\
-\x5f\x73\x69\x7a\x65\0\x74\x73\x74\x61\x6d\x70\x5f\x74\x79\x70\x65\0\x68\x77\
-\x74\x73\x74\x61\x6d\x70\0\x66\x6c\x6f\x77\x5f\x6b\x65\x79\x73\0\x73\x6b\0\x5f\
-\x5f\x75\x38\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x63\x68\x61\x72\0\x63\x74\
-\x78\0\x74\x63\x5f\x69\x6e\x67\x72\x65\x73\x73\0\x74\x63\0\x2f\x68\x6f\x6d\x65\
-\x2f\x69\x69\x69\x74\x62\x2f\x44\x6f\x63\x75\x6d\x65\x6e\x74\x73\x2f\x61\x6a\
-\x69\x74\x65\x73\x68\x5f\x57\x6f\x72\x6b\x73\x70\x61\x63\x65\x2f\x72\x61\x74\
-\x65\x4c\x69\x6d\x69\x74\x74\x65\x72\x2f\x72\x61\x74\x65\x4c\x69\x6d\x69\x74\
-\x65\x72\x2e\x62\x70\x66\x2e\x63\0\x69\x6e\x74\x20\x74\x63\x5f\x69\x6e\x67\x72\
-\x65\x73\x73\x28\x73\x74\x72\x75\x63\x74\x20\x5f\x5f\x73\x6b\x5f\x62\x75\x66\
-\x66\x20\x2a\x63\x74\x78\x29\0\x30\x3a\x34\0\x20\x20\x20\x20\x69\x66\x20\x28\
-\x63\x74\x78\x2d\x3e\x70\x72\x6f\x74\x6f\x63\x6f\x6c\x20\x21\x3d\x20\x62\x70\
-\x66\x5f\x68\x74\x6f\x6e\x73\x28\x45\x54\x48\x5f\x50\x5f\x49\x50\x29\x29\0\x30\
-\x3a\x31\x35\0\x20\x20\x20\x20\x76\x6f\x69\x64\x20\x2a\x64\x61\x74\x61\x20\x3d\
-\x20\x28\x76\x6f\x69\x64\x20\x2a\x29\x28\x6c\x6f\x6e\x67\x29\x63\x74\x78\x2d\
-\x3e\x64\x61\x74\x61\x3b\0\x30\x3a\x31\x36\0\x20\x20\x20\x20\x76\x6f\x69\x64\
-\x20\x2a\x64\x61\x74\x61\x5f\x65\x6e\x64\x20\x3d\x20\x28\x76\x6f\x69\x64\x20\
-\x2a\x29\x28\x6c\x6f\x6e\x67\x29\x63\x74\x78\x2d\x3e\x64\x61\x74\x61\x5f\x65\
-\x6e\x64\x3b\0\x20\x20\x20\x20\x69\x66\x20\x28\x28\x76\x6f\x69\x64\x20\x2a\x29\
-\x28\x6c\x32\x20\x2b\x20\x31\x29\x20\x3e\x20\x64\x61\x74\x61\x5f\x65\x6e\x64\
-\x29\0\x69\x70\x68\x64\x72\0\x69\x68\x6c\0\x76\x65\x72\x73\x69\x6f\x6e\0\x74\
-\x6f\x73\0\x74\x6f\x74\x5f\x6c\x65\x6e\0\x69\x64\0\x66\x72\x61\x67\x5f\x6f\x66\
-\x66\0\x74\x74\x6c\0\x63\x68\x65\x63\x6b\0\x5f\x5f\x62\x65\x31\x36\0\x5f\x5f\
-\x75\x31\x36\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x73\x68\x6f\x72\x74\0\x5f\
-\x5f\x73\x75\x6d\x31\x36\0\x61\x64\x64\x72\x73\0\x73\x61\x64\x64\x72\0\x64\x61\
-\x64\x64\x72\0\x5f\x5f\x62\x65\x33\x32\0\x30\x3a\x39\x3a\x30\x3a\x30\0\x20\x20\
-\x20\x20\x5f\x5f\x75\x33\x32\x20\x73\x72\x63\x5f\x69\x70\x20\x3d\x20\x6c\x33\
-\x2d\x3e\x73\x61\x64\x64\x72\x3b\0\x20\x20\x20\x20\x5f\x5f\x75\x36\x34\x20\x6e\
-\x6f\x77\x5f\x6e\x73\x20\x3d\x20\x62\x70\x66\x5f\x6b\x74\x69\x6d\x65\x5f\x67\
-\x65\x74\x5f\x6e\x73\x28\x29\x3b\0\x20\x20\x20\x20\x73\x74\x20\x3d\x20\x62\x70\
-\x66\x5f\x6d\x61\x70\x5f\x6c\x6f\x6f\x6b\x75\x70\x5f\x65\x6c\x65\x6d\x28\x26\
-\x72\x61\x74\x65\x5f\x6d\x61\x70\x2c\x20\x26\x73\x72\x63\x5f\x69\x70\x29\x3b\0\
-\x20\x20\x20\x20\x69\x66\x20\x28\x21\x73\x74\x29\x20\x7b\0\x20\x20\x20\x20\x20\
-\x20\x20\x20\x6e\x65\x77\x5f\x73\x74\x2e\x6c\x61\x73\x74\x5f\x74\x73\x5f\x6e\
-\x73\x20\x3d\x20\x6e\x6f\x77\x5f\x6e\x73\x3b\0\x20\x20\x20\x20\x20\x20\x20\x20\
-\x5f\x5f\x62\x75\x69\x6c\x74\x69\x6e\x5f\x6d\x65\x6d\x73\x65\x74\x28\x26\x6e\
-\x65\x77\x5f\x73\x74\x2c\x20\x30\x2c\x20\x73\x69\x7a\x65\x6f\x66\x28\x6e\x65\
-\x77\x5f\x73\x74\x29\x29\x3b\0\x20\x20\x20\x20\x20\x20\x20\x20\x69\x66\x20\x28\
-\x62\x75\x72\x73\x74\x20\x3e\x20\x30\x29\0\x20\x20\x20\x20\x20\x20\x20\x20\x20\
-\x20\x20\x20\x6e\x65\x77\x5f\x73\x74\x2e\x74\x6f\x6b\x65\x6e\x73\x20\x3d\x20\
-\x62\x75\x72\x73\x74\x20\x2d\x20\x31\x3b\x20\x2f\x2f\x20\x63\x6f\x6e\x73\x75\
-\x6d\x65\x20\x31\x20\x74\x6f\x6b\x65\x6e\x20\x66\x6f\x72\x20\x74\x68\x69\x73\
-\x20\x70\x61\x63\x6b\x65\x74\0\x20\x20\x20\x20\x20\x20\x20\x20\x6e\x65\x77\x5f\
-\x73\x74\x2e\x64\x72\x6f\x70\x70\x65\x64\x20\x3d\x20\x30\x3b\0\x20\x20\x20\x20\
-\x20\x20\x20\x20\x62\x70\x66\x5f\x6d\x61\x70\x5f\x75\x70\x64\x61\x74\x65\x5f\
-\x65\x6c\x65\x6d\x28\x26\x72\x61\x74\x65\x5f\x6d\x61\x70\x2c\x20\x26\x73\x72\
-\x63\x5f\x69\x70\x2c\x20\x26\x6e\x65\x77\x5f\x73\x74\x2c\x20\x42\x50\x46\x5f\
-\x41\x4e\x59\x29\x3b\0\x20\x20\x20\x20\x5f\x5f\x75\x36\x34\x20\x65\x6c\x61\x70\
-\x73\x65\x64\x20\x3d\x20\x6e\x6f\x77\x5f\x6e\x73\x20\x2d\x20\x73\x74\x2d\x3e\
-\x6c\x61\x73\x74\x5f\x74\x73\x5f\x6e\x73\x3b\0\x20\x20\x20\x20\x69\x66\x20\x28\
-\x72\x61\x74\x65\x5f\x6c\x69\x6d\x69\x74\x5f\x70\x70\x73\x20\x3e\x20\x30\x20\
-\x26\x26\x20\x65\x6c\x61\x70\x73\x65\x64\x20\x3e\x20\x30\x29\x20\x7b\0\x20\x20\
-\x20\x20\x20\x20\x20\x20\x5f\x5f\x75\x36\x34\x20\x61\x64\x64\x20\x3d\x20\x28\
-\x65\x6c\x61\x70\x73\x65\x64\x20\x2a\x20\x28\x5f\x5f\x75\x36\x34\x29\x72\x61\
-\x74\x65\x5f\x6c\x69\x6d\x69\x74\x5f\x70\x70\x73\x29\x20\x2f\x20\x31\x30\x30\
-\x30\x30\x30\x30\x30\x30\x30\x55\x4c\x4c\x3b\0\x20\x20\x20\x20\x20\x20\x20\x20\
-\x69\x66\x20\x28\x61\x64\x64\x20\x3e\x20\x30\x29\x20\x7b\0\x20\x20\x20\x20\x20\
-\x20\x20\x20\x20\x20\x20\x20\x5f\x5f\x75\x36\x34\x20\x74\x6f\x6b\x65\x6e\x73\
-\x20\x3d\x20\x28\x5f\x5f\x75\x36\x34\x29\x73\x74\x2d\x3e\x74\x6f\x6b\x65\x6e\
-\x73\x20\x2b\x20\x61\x64\x64\x3b\0\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\
-\x20\x69\x66\x20\x28\x74\x6f\x6b\x65\x6e\x73\x20\x3e\x20\x28\x5f\x5f\x75\x36\
-\x34\x29\x62\x75\x72\x73\x74\x29\0\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\
-\x20\x20\x20\x20\x20\x74\x6f\x6b\x65\x6e\x73\x20\x3d\x20\x62\x75\x72\x73\x74\
-\x3b\0\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\x73\x74\x2d\x3e\x6c\x61\
-\x73\x74\x5f\x74\x73\x5f\x6e\x73\x20\x3d\x20\x6e\x6f\x77\x5f\x6e\x73\x3b\0\x20\
-\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\x73\x74\x2d\x3e\x74\x6f\x6b\x65\
-\x6e\x73\x20\x3d\x20\x28\x5f\x5f\x75\x33\x32\x29\x74\x6f\x6b\x65\x6e\x73\x3b\0\
-\x20\x20\x20\x20\x69\x66\x20\x28\x73\x74\x2d\x3e\x74\x6f\x6b\x65\x6e\x73\x20\
-\x3e\x20\x30\x29\x20\x7b\0\x20\x20\x20\x20\x20\x20\x20\x20\x73\x74\x2d\x3e\x74\
-\x6f\x6b\x65\x6e\x73\x2d\x2d\x3b\0\x20\x20\x20\x20\x73\x74\x2d\x3e\x64\x72\x6f\
-\x70\x70\x65\x64\x2b\x2b\x3b\0\x20\x20\x20\x20\x73\x74\x72\x75\x63\x74\x20\x65\
-\x76\x65\x6e\x74\x20\x2a\x65\x20\x3d\x20\x62\x70\x66\x5f\x72\x69\x6e\x67\x62\
-\x75\x66\x5f\x72\x65\x73\x65\x72\x76\x65\x28\x26\x72\x62\x2c\x20\x73\x69\x7a\
-\x65\x6f\x66\x28\x2a\x65\x29\x2c\x20\x30\x29\x3b\0\x20\x20\x20\x20\x69\x66\x20\
-\x28\x65\x29\x20\x7b\0\x20\x20\x20\x20\x20\x20\x20\x20\x65\x2d\x3e\x73\x72\x63\
-\x5f\x69\x70\x20\x3d\x20\x73\x72\x63\x5f\x69\x70\x3b\0\x20\x20\x20\x20\x20\x20\
-\x20\x20\x65\x2d\x3e\x74\x73\x5f\x6e\x73\x20\x3d\x20\x6e\x6f\x77\x5f\x6e\x73\
-\x3b\0\x20\x20\x20\x20\x20\x20\x20\x20\x65\x2d\x3e\x64\x72\x6f\x70\x70\x65\x64\
-\x20\x3d\x20\x73\x74\x2d\x3e\x64\x72\x6f\x70\x70\x65\x64\x3b\0\x20\x20\x20\x20\
-\x20\x20\x20\x20\x62\x70\x66\x5f\x72\x69\x6e\x67\x62\x75\x66\x5f\x73\x75\x62\
-\x6d\x69\x74\x28\x65\x2c\x20\x30\x29\x3b\0\x7d\0\x63\x68\x61\x72\0\x4c\x49\x43\
-\x45\x4e\x53\x45\0\x72\x61\x74\x65\x5f\x6c\x69\x6d\x69\x74\x5f\x70\x70\x73\0\
-\x62\x75\x72\x73\x74\0\x2e\x6d\x61\x70\x73\0\x2e\x72\x6f\x64\x61\x74\x61\0\x6c\
-\x69\x63\x65\x6e\x73\x65\0\x62\x70\x66\x5f\x73\x6f\x63\x6b\0\x62\x70\x66\x5f\
-\x66\x6c\x6f\x77\x5f\x6b\x65\x79\x73\0\0\0\0\x9f\xeb\x01\0\x20\0\0\0\0\0\0\0\
-\x14\0\0\0\x14\0\0\0\x4c\x03\0\0\x60\x03\0\0\x4c\0\0\0\x08\0\0\0\xf0\x01\0\0\
-\x01\0\0\0\0\0\0\0\x21\0\0\0\x10\0\0\0\xf0\x01\0\0\x34\0\0\0\0\0\0\0\xf3\x01\0\
-\0\x3a\x02\0\0\0\x10\x01\0\x08\0\0\0\xf3\x01\0\0\x64\x02\0\0\x0e\x48\x01\0\x10\
-\0\0\0\xf3\x01\0\0\x64\x02\0\0\x09\x48\x01\0\x18\0\0\0\xf3\x01\0\0\x97\x02\0\0\
-\x25\x24\x01\0\x20\0\0\0\xf3\x01\0\0\xc6\x02\0\0\x29\x1c\x01\0\x28\0\0\0\xf3\
-\x01\0\0\xf8\x02\0\0\x15\x58\x01\0\x38\0\0\0\xf3\x01\0\0\xf8\x02\0\0\x09\x58\
-\x01\0\x50\0\0\0\xf3\x01\0\0\x96\x03\0\0\x18\x74\x01\0\x58\0\0\0\xf3\x01\0\0\
-\x96\x03\0\0\x0b\x74\x01\0\x60\0\0\0\xf3\x01\0\0\xb4\x03\0\0\x14\x80\x01\0\x78\
-\0\0\0\xf3\x01\0\0\x96\x03\0\0\x18\x74\x01\0\x80\0\0\0\xf3\x01\0\0\xdb\x03\0\0\
-\x0a\x9c\x01\0\x98\0\0\0\xf3\x01\0\0\x0d\x04\0\0\x09\xa0\x01\0\xa0\0\0\0\xf3\
-\x01\0\0\x1c\x04\0\0\x1b\xac\x01\0\xb0\0\0\0\xf3\x01\0\0\x40\x04\0\0\x09\xa8\
-\x01\0\xb8\0\0\0\xf3\x01\0\0\x76\x04\0\0\x0d\xb0\x01\0\xe8\0\0\0\xf3\x01\0\0\
-\x76\x04\0\0\x0d\xb0\x01\0\xf0\0\0\0\xf3\x01\0\0\x8d\x04\0\0\x1d\xb4\x01\0\xf8\
-\0\0\0\xf3\x01\0\0\x8d\x04\0\0\x23\xb4\x01\0\0\x01\0\0\xf3\x01\0\0\x8d\x04\0\0\
-\x1b\xb4\x01\0\x08\x01\0\0\xf3\x01\0\0\xd7\x04\0\0\x18\xb8\x01\0\x30\x01\0\0\
-\xf3\x01\0\0\xf3\x04\0\0\x09\xc0\x01\0\x60\x01\0\0\xf3\x01\0\0\x36\x05\0\0\x22\
-\xd4\x01\0\x68\x01\0\0\xf3\x01\0\0\x63\x05\0\0\x09\xdc\x01\0\x98\x01\0\0\xf3\
-\x01\0\0\x63\x05\0\0\x1c\xdc\x01\0\xa8\x01\0\0\xf3\x01\0\0\x36\x05\0\0\x1c\xd4\
-\x01\0\xb8\x01\0\0\xf3\x01\0\0\x90\x05\0\0\x27\xec\x01\0\xd0\x01\0\0\xf3\x01\0\
-\0\x90\x05\0\0\x20\xec\x01\0\xe0\x01\0\0\xf3\x01\0\0\x90\x05\0\0\x1e\xec\x01\0\
-\xf0\x01\0\0\xf3\x01\0\0\xd7\x05\0\0\x0d\xf4\x01\0\xf8\x01\0\0\xf3\x01\0\0\xee\
-\x05\0\0\x27\xf8\x01\0\0\x02\0\0\xf3\x01\0\0\x90\x05\0\0\x37\xec\x01\0\x08\x02\
-\0\0\xf3\x01\0\0\xee\x05\0\0\x2e\xf8\x01\0\x10\x02\0\0\xf3\x01\0\0\x22\x06\0\0\
-\x21\xfc\x01\0\x28\x02\0\0\xf3\x01\0\0\x22\x06\0\0\x1a\xfc\x01\0\x38\x02\0\0\
-\xf3\x01\0\0\x22\x06\0\0\x11\xfc\x01\0\x40\x02\0\0\xf3\x01\0\0\x49\x06\0\0\x1a\
-\0\x02\0\x48\x02\0\0\xf3\x01\0\0\x69\x06\0\0\x1c\x08\x02\0\x50\x02\0\0\xf3\x01\
-\0\0\x8e\x06\0\0\x18\x04\x02\0\x58\x02\0\0\xf3\x01\0\0\xb6\x06\0\0\x0d\x1c\x02\
-\0\x60\x02\0\0\xf3\x01\0\0\xb6\x06\0\0\x09\x1c\x02\0\x68\x02\0\0\xf3\x01\0\0\
-\xd0\x06\0\0\x13\x20\x02\0\x88\x02\0\0\xf3\x01\0\0\xe6\x06\0\0\x10\x34\x02\0\
-\xa8\x02\0\0\xf3\x01\0\0\xf9\x06\0\0\x17\x3c\x02\0\xe0\x02\0\0\xf3\x01\0\0\x38\
-\x07\0\0\x09\x40\x02\0\xe8\x02\0\0\xf3\x01\0\0\x45\x07\0\0\x15\x44\x02\0\xf0\
-\x02\0\0\xf3\x01\0\0\x61\x07\0\0\x12\x48\x02\0\xf8\x02\0\0\xf3\x01\0\0\x45\x07\
-\0\0\x13\x44\x02\0\0\x03\0\0\xf3\x01\0\0\x7c\x07\0\0\x1a\x4c\x02\0\x08\x03\0\0\
-\xf3\x01\0\0\x7c\x07\0\0\x14\x4c\x02\0\x10\x03\0\0\xf3\x01\0\0\x9e\x07\0\0\x09\
-\x50\x02\0\x28\x03\0\0\xf3\x01\0\0\xc0\x07\0\0\x01\x64\x02\0\x10\0\0\0\xf0\x01\
-\0\0\x04\0\0\0\x08\0\0\0\x17\0\0\0\x60\x02\0\0\0\0\0\0\x18\0\0\0\x17\0\0\0\x92\
-\x02\0\0\0\0\0\0\x20\0\0\0\x17\0\0\0\xc1\x02\0\0\0\0\0\0\x50\0\0\0\x22\0\0\0\
-\x8e\x03\0\0\0\0\0\0\x0c\0\0\0\xff\xff\xff\xff\x04\0\x08\0\x08\x7c\x0b\0\x14\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x30\x03\0\0\0\0\0\0\x7f\x01\0\0\x05\0\x08\0\x69\0\
-\0\0\x08\x01\x01\xfb\x0e\x0d\0\x01\x01\x01\x01\0\0\0\x01\0\0\x01\x01\x01\x1f\
-\x03\0\0\0\0\x35\0\0\0\x37\0\0\0\x03\x01\x1f\x02\x0f\x05\x1e\x03\x48\0\0\0\0\
-\x7c\x9a\xc8\x2b\x4d\x56\x07\xef\xd3\x21\x91\x71\x16\xab\xda\x93\x5a\0\0\0\x01\
-\xe3\0\xcd\xd0\x7e\x1c\xff\xa4\xc4\xdb\xe5\xfc\x8c\x91\xbf\xc7\x64\0\0\0\x02\
-\x09\xcf\xcd\x71\x69\xc2\x4b\xec\x44\x8f\x30\x58\x2e\x8c\x6d\xb9\x04\0\0\x09\
-\x02\0\0\0\0\0\0\0\0\x03\xc4\0\x01\x05\x0e\x0a\x03\x0d\x20\x05\x09\x06\x20\x05\
-\x25\x06\x03\x77\x20\x05\x29\x1e\x05\x15\x03\x0f\x20\x05\x09\x06\x2e\x03\xaa\
-\x7f\x20\x03\xd6\0\x20\x05\x18\x06\x27\x05\x0b\x06\x20\x05\x14\x06\x23\x06\x03\
-\xa0\x7f\x2e\x05\x18\x06\x03\xdd\0\x20\x05\x0a\x03\x0a\x20\x05\x09\x3d\x05\x1b\
-\x23\x05\x09\x2d\x05\x0d\x22\x06\x66\x05\x1d\x06\x21\x05\x23\x06\x20\x05\x1b\
-\x20\x05\x18\x06\x21\x06\x03\x92\x7f\x20\x03\xee\0\x20\x05\x09\x06\x3e\x06\x03\
-\x90\x7f\x4a\x05\x22\x06\x03\xf5\0\x2e\x05\x09\x22\x05\x1c\x06\x66\x06\x2c\x05\
-\x27\x34\x05\x20\x06\x3c\x05\x1e\x2e\x03\x85\x7f\x20\x05\x0d\x06\x03\xfd\0\x20\
-\x05\x27\x21\x05\x37\x1d\x05\x2e\x23\x05\x21\x21\x05\x1a\x06\x3c\x05\x11\x2e\
-\x05\x1a\x06\x21\x05\x1c\x22\x05\x18\x1f\x05\x0d\x26\x05\x09\x06\x20\x05\x13\
-\x06\x21\x06\x03\xf8\x7e\x3c\x05\x10\x06\x03\x8d\x01\x20\x05\x17\x4c\x06\x03\
-\xf1\x7e\x66\x05\x09\x06\x03\x90\x01\x20\x05\x15\x21\x05\x12\x21\x05\x13\x1f\
-\x05\x1a\x22\x05\x14\x06\x20\x05\x09\x06\x21\x06\x03\xec\x7e\x2e\x05\x01\x06\
-\x03\x99\x01\x20\x02\x01\0\x01\x01\x2f\x68\x6f\x6d\x65\x2f\x69\x69\x69\x74\x62\
-\x2f\x44\x6f\x63\x75\x6d\x65\x6e\x74\x73\x2f\x61\x6a\x69\x74\x65\x73\x68\x5f\
-\x57\x6f\x72\x6b\x73\x70\x61\x63\x65\x2f\x72\x61\x74\x65\x4c\x69\x6d\x69\x74\
-\x74\x65\x72\0\x2e\0\x2f\x75\x73\x72\x2f\x69\x6e\x63\x6c\x75\x64\x65\x2f\x62\
-\x70\x66\0\x72\x61\x74\x65\x4c\x69\x6d\x69\x74\x65\x72\x2e\x62\x70\x66\x2e\x63\
-\0\x76\x6d\x6c\x69\x6e\x75\x78\x2e\x68\0\x62\x70\x66\x5f\x68\x65\x6c\x70\x65\
-\x72\x5f\x64\x65\x66\x73\x2e\x68\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\x01\x01\0\0\x04\0\xf1\xff\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\x03\0\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x46\x01\0\0\0\0\x03\0\x28\
-\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x3f\x01\0\0\0\0\x03\0\x60\x01\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\x4e\x01\0\0\0\0\x03\0\x08\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x5d\x01\
-\0\0\0\0\x03\0\x58\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x65\x01\0\0\0\0\x03\0\x48\
-\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x55\x01\0\0\0\0\x03\0\x88\x02\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\x03\0\x08\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\
-\x09\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\x0c\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\x03\0\x0d\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\
-\x0f\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\x10\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\x03\0\x16\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\
-\x18\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\x1a\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\x5f\0\0\0\x12\0\x03\0\0\0\0\0\0\0\0\0\x30\x03\0\0\0\0\0\0\xaa\0\0\
-\0\x11\0\x07\0\0\0\0\0\0\0\0\0\x20\0\0\0\0\0\0\0\x22\0\0\0\x11\0\x06\0\x04\0\0\
-\0\0\0\0\0\x04\0\0\0\0\0\0\0\x6a\0\0\0\x11\0\x06\0\0\0\0\0\0\0\0\0\x04\0\0\0\0\
-\0\0\0\x13\x01\0\0\x11\0\x07\0\x20\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\x37\x01\0\0\
-\x11\0\x05\0\0\0\0\0\0\0\0\0\x0d\0\0\0\0\0\0\0\x80\0\0\0\0\0\0\0\x01\0\0\0\x13\
-\0\0\0\xb8\0\0\0\0\0\0\0\x01\0\0\0\x14\0\0\0\x30\x01\0\0\0\0\0\0\x01\0\0\0\x13\
-\0\0\0\x68\x01\0\0\0\0\0\0\x01\0\0\0\x15\0\0\0\xb8\x01\0\0\0\0\0\0\x01\0\0\0\
-\x15\0\0\0\x10\x02\0\0\0\0\0\0\x01\0\0\0\x14\0\0\0\xa8\x02\0\0\0\0\0\0\x01\0\0\
-\0\x16\0\0\0\x08\0\0\0\0\0\0\0\x03\0\0\0\x0a\0\0\0\x11\0\0\0\0\0\0\0\x03\0\0\0\
-\x0c\0\0\0\x15\0\0\0\0\0\0\0\x03\0\0\0\x10\0\0\0\x1f\0\0\0\0\0\0\0\x03\0\0\0\
-\x0e\0\0\0\x23\0\0\0\0\0\0\0\x03\0\0\0\x0b\0\0\0\x27\0\0\0\0\0\0\0\x03\0\0\0\
-\x09\0\0\0\x08\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x0c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x10\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x14\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x18\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x1c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x20\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x24\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x28\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x2c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x30\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x34\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x38\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x3c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x40\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x44\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x48\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x4c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x50\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x54\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x58\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x5c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x60\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x64\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x68\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x6c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x70\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x74\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x78\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x7c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x80\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x84\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x88\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x8c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x90\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x94\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x98\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x9c\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xa0\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xa4\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xa8\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xac\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xb0\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xb4\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xb8\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xbc\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xc0\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xc4\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xc8\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xcc\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xd0\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xd4\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xd8\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xdc\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xe0\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xe4\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xe8\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xec\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xf0\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xf4\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\xf8\0\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xfc\0\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\0\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x04\x01\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x08\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x0c\x01\0\0\0\0\0\0\x03\0\0\
-\0\x0d\0\0\0\x10\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x14\x01\0\0\0\0\0\0\x03\0\
-\0\0\x0d\0\0\0\x18\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x1c\x01\0\0\0\0\0\0\x03\
-\0\0\0\x0d\0\0\0\x20\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x24\x01\0\0\0\0\0\0\
-\x03\0\0\0\x0d\0\0\0\x28\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x2c\x01\0\0\0\0\0\
-\0\x03\0\0\0\x0d\0\0\0\x30\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x34\x01\0\0\0\0\
-\0\0\x03\0\0\0\x0d\0\0\0\x38\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x3c\x01\0\0\0\
-\0\0\0\x03\0\0\0\x0d\0\0\0\x40\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x44\x01\0\0\
-\0\0\0\0\x03\0\0\0\x0d\0\0\0\x48\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x4c\x01\0\
-\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x50\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x54\x01\
-\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x58\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x5c\
-\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x60\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\
-\x64\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x68\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\
-\0\x6c\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x70\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\
-\0\0\x74\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x78\x01\0\0\0\0\0\0\x03\0\0\0\x0d\
-\0\0\0\x7c\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x80\x01\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x84\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x88\x01\0\0\0\0\0\0\x03\0\0\
-\0\x0d\0\0\0\x8c\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x90\x01\0\0\0\0\0\0\x03\0\
-\0\0\x0d\0\0\0\x94\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x98\x01\0\0\0\0\0\0\x03\
-\0\0\0\x0d\0\0\0\x9c\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xa0\x01\0\0\0\0\0\0\
-\x03\0\0\0\x0d\0\0\0\xa4\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xa8\x01\0\0\0\0\0\
-\0\x03\0\0\0\x0d\0\0\0\xac\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xb0\x01\0\0\0\0\
-\0\0\x03\0\0\0\x0d\0\0\0\xb4\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xb8\x01\0\0\0\
-\0\0\0\x03\0\0\0\x0d\0\0\0\xbc\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xc0\x01\0\0\
-\0\0\0\0\x03\0\0\0\x0d\0\0\0\xc4\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xc8\x01\0\
-\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xcc\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xd0\x01\
-\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xd4\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xd8\
-\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xdc\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\
-\xe0\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xe4\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\
-\0\xe8\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xec\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\
-\0\0\xf0\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xf4\x01\0\0\0\0\0\0\x03\0\0\0\x0d\
-\0\0\0\xf8\x01\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\xfc\x01\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\0\x02\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x04\x02\0\0\0\0\0\0\x03\0\0\0\
-\x0d\0\0\0\x08\x02\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x0c\x02\0\0\0\0\0\0\x03\0\0\
-\0\x0d\0\0\0\x10\x02\0\0\0\0\0\0\x03\0\0\0\x0d\0\0\0\x14\x02\0\0\0\0\0\0\x03\0\
-\0\0\x0d\0\0\0\x08\0\0\0\0\0\0\0\x02\0\0\0\x17\0\0\0\x10\0\0\0\0\0\0\0\x02\0\0\
-\0\x15\0\0\0\x18\0\0\0\0\0\0\0\x02\0\0\0\x14\0\0\0\x20\0\0\0\0\0\0\0\x02\0\0\0\
-\x16\0\0\0\x28\0\0\0\0\0\0\0\x02\0\0\0\x13\0\0\0\x30\0\0\0\0\0\0\0\x02\0\0\0\
-\x02\0\0\0\x38\0\0\0\0\0\0\0\x02\0\0\0\x02\0\0\0\xdc\x05\0\0\0\0\0\0\x04\0\0\0\
-\x13\0\0\0\xe8\x05\0\0\0\0\0\0\x04\0\0\0\x16\0\0\0\0\x06\0\0\0\0\0\0\x03\0\0\0\
-\x15\0\0\0\x0c\x06\0\0\0\0\0\0\x03\0\0\0\x14\0\0\0\x24\x06\0\0\0\0\0\0\x04\0\0\
-\0\x17\0\0\0\x2c\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x40\0\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\x50\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x60\0\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\x70\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x80\0\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\x90\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xa0\0\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\xb0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xc0\0\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\xd0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xe0\0\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\xf0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\0\x01\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\x10\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x20\x01\0\0\0\0\0\0\x04\0\0\
-\0\x02\0\0\0\x30\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x40\x01\0\0\0\0\0\0\x04\0\
-\0\0\x02\0\0\0\x50\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x60\x01\0\0\0\0\0\0\x04\
-\0\0\0\x02\0\0\0\x70\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x80\x01\0\0\0\0\0\0\
-\x04\0\0\0\x02\0\0\0\x90\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xa0\x01\0\0\0\0\0\
-\0\x04\0\0\0\x02\0\0\0\xb0\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xc0\x01\0\0\0\0\
-\0\0\x04\0\0\0\x02\0\0\0\xd0\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xe0\x01\0\0\0\
-\0\0\0\x04\0\0\0\x02\0\0\0\xf0\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\0\x02\0\0\0\
-\0\0\0\x04\0\0\0\x02\0\0\0\x10\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x20\x02\0\0\
-\0\0\0\0\x04\0\0\0\x02\0\0\0\x30\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x40\x02\0\
-\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x50\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x60\x02\
-\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x70\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x80\
-\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x90\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\
-\xa0\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xb0\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\
-\0\xc0\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xd0\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\
-\0\0\xe0\x02\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xf0\x02\0\0\0\0\0\0\x04\0\0\0\x02\
-\0\0\0\0\x03\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x10\x03\0\0\0\0\0\0\x04\0\0\0\x02\
-\0\0\0\x20\x03\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x30\x03\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\x40\x03\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x50\x03\0\0\0\0\0\0\x04\0\0\
-\0\x02\0\0\0\x60\x03\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x70\x03\0\0\0\0\0\0\x04\0\
-\0\0\x02\0\0\0\x8c\x03\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x9c\x03\0\0\0\0\0\0\x04\
-\0\0\0\x02\0\0\0\xac\x03\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xbc\x03\0\0\0\0\0\0\
-\x04\0\0\0\x02\0\0\0\x14\0\0\0\0\0\0\0\x03\0\0\0\x0f\0\0\0\x18\0\0\0\0\0\0\0\
-\x02\0\0\0\x02\0\0\0\x22\0\0\0\0\0\0\0\x03\0\0\0\x11\0\0\0\x26\0\0\0\0\0\0\0\
-\x03\0\0\0\x11\0\0\0\x2a\0\0\0\0\0\0\0\x03\0\0\0\x11\0\0\0\x36\0\0\0\0\0\0\0\
-\x03\0\0\0\x11\0\0\0\x4b\0\0\0\0\0\0\0\x03\0\0\0\x11\0\0\0\x60\0\0\0\0\0\0\0\
-\x03\0\0\0\x11\0\0\0\x7a\0\0\0\0\0\0\0\x02\0\0\0\x02\0\0\0\x12\x17\x15\x14\x13\
-\x16\0\x2e\x64\x65\x62\x75\x67\x5f\x61\x62\x62\x72\x65\x76\0\x2e\x74\x65\x78\
-\x74\0\x2e\x72\x65\x6c\x2e\x42\x54\x46\x2e\x65\x78\x74\0\x62\x75\x72\x73\x74\0\
-\x2e\x64\x65\x62\x75\x67\x5f\x72\x6e\x67\x6c\x69\x73\x74\x73\0\x2e\x64\x65\x62\
-\x75\x67\x5f\x6c\x6f\x63\x6c\x69\x73\x74\x73\0\x2e\x72\x65\x6c\x2e\x64\x65\x62\
-\x75\x67\x5f\x73\x74\x72\x5f\x6f\x66\x66\x73\x65\x74\x73\0\x74\x63\x5f\x69\x6e\
-\x67\x72\x65\x73\x73\0\x72\x61\x74\x65\x5f\x6c\x69\x6d\x69\x74\x5f\x70\x70\x73\
-\0\x2e\x6d\x61\x70\x73\0\x2e\x64\x65\x62\x75\x67\x5f\x73\x74\x72\0\x2e\x64\x65\
-\x62\x75\x67\x5f\x6c\x69\x6e\x65\x5f\x73\x74\x72\0\x2e\x72\x65\x6c\x2e\x64\x65\
-\x62\x75\x67\x5f\x61\x64\x64\x72\0\x72\x61\x74\x65\x5f\x6d\x61\x70\0\x2e\x72\
-\x65\x6c\x2e\x64\x65\x62\x75\x67\x5f\x69\x6e\x66\x6f\0\x2e\x6c\x6c\x76\x6d\x5f\
-\x61\x64\x64\x72\x73\x69\x67\0\x6c\x69\x63\x65\x6e\x73\x65\0\x2e\x72\x65\x6c\
-\x2e\x64\x65\x62\x75\x67\x5f\x6c\x69\x6e\x65\0\x2e\x72\x65\x6c\x2e\x64\x65\x62\
-\x75\x67\x5f\x66\x72\x61\x6d\x65\0\x2e\x72\x65\x6c\x74\x63\0\x72\x61\x74\x65\
-\x4c\x69\x6d\x69\x74\x65\x72\x2e\x62\x70\x66\x2e\x63\0\x72\x62\0\x2e\x73\x74\
-\x72\x74\x61\x62\0\x2e\x73\x79\x6d\x74\x61\x62\0\x2e\x72\x6f\x64\x61\x74\x61\0\
-\x2e\x72\x65\x6c\x2e\x42\x54\x46\0\x4c\x49\x43\x45\x4e\x53\x45\0\x4c\x42\x42\
-\x30\x5f\x37\0\x4c\x42\x42\x30\x5f\x31\x37\0\x4c\x42\x42\x30\x5f\x36\0\x4c\x42\
-\x42\x30\x5f\x31\x35\0\x4c\x42\x42\x30\x5f\x31\x33\0\x4c\x42\x42\x30\x5f\x31\
-\x32\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x16\x01\0\0\
-\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x0e\x39\0\0\0\0\0\0\x6d\x01\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x0f\0\0\0\x01\0\0\0\x06\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\x04\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xfe\0\0\0\x01\0\0\0\x06\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\x40\0\0\0\0\0\0\0\x30\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x08\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\xfa\0\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\x18\x2b\0\0\0\0\0\0\x70\0\0\0\0\0\0\0\x1c\0\0\0\x03\0\0\0\x08\0\0\0\0\0\0\0\
-\x10\0\0\0\0\0\0\0\xd1\0\0\0\x01\0\0\0\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x70\
-\x03\0\0\0\0\0\0\x0d\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\x26\x01\0\0\x01\0\0\0\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x80\x03\0\0\0\0\
-\0\0\x08\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x04\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x79\0\
-\0\0\x01\0\0\0\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x88\x03\0\0\0\0\0\0\x30\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\x08\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x38\0\0\0\x01\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xb8\x03\0\0\0\0\0\0\xd3\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\x8b\x04\0\0\0\0\0\0\xc0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xb7\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\x4b\x06\0\0\0\0\0\0\xfb\x06\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\xb3\0\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x88\x2b\0\
-\0\0\0\0\0\x60\0\0\0\0\0\0\0\x1c\0\0\0\x0a\0\0\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\
-\0\0\0\x28\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x46\x0d\0\0\0\0\0\0\
-\x1b\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x4c\0\0\0\
-\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x61\x0d\0\0\0\0\0\0\x18\x02\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x48\0\0\0\x09\0\0\0\x40\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xe8\x2b\0\0\0\0\0\0\x40\x08\0\0\0\0\0\0\x1c\0\0\
-\0\x0d\0\0\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\x7f\0\0\0\x01\0\0\0\x30\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\x79\x0f\0\0\0\0\0\0\xd0\x04\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\x01\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\x9e\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\x49\x14\0\0\0\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\x9a\0\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\x28\x34\0\0\0\0\0\0\x70\0\0\0\0\0\0\0\x1c\0\0\0\x10\0\0\0\x08\0\0\0\0\0\0\0\
-\x10\0\0\0\0\0\0\0\x32\x01\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x8c\
-\x14\0\0\0\0\0\0\x55\x0e\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x04\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\x2e\x01\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x98\x34\0\0\0\
-\0\0\0\x50\0\0\0\0\0\0\0\x1c\0\0\0\x12\0\0\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\
-\0\x19\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xe4\x22\0\0\0\0\0\0\xcc\
-\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x04\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x15\0\0\0\
-\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xe8\x34\0\0\0\0\0\0\x90\x03\0\0\0\
-\0\0\0\x1c\0\0\0\x14\0\0\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\xed\0\0\0\x01\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xb0\x26\0\0\0\0\0\0\x28\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\x08\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xe9\0\0\0\x09\0\0\0\x40\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\x78\x38\0\0\0\0\0\0\x20\0\0\0\0\0\0\0\x1c\0\0\0\x16\0\0\
-\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\xdd\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\xd8\x26\0\0\0\0\0\0\x83\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\xd9\0\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\x98\x38\0\0\0\0\0\0\x70\0\0\0\0\0\0\0\x1c\0\0\0\x18\0\0\0\x08\0\0\0\0\0\0\0\
-\x10\0\0\0\0\0\0\0\x8a\0\0\0\x01\0\0\0\x30\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x5b\
-\x28\0\0\0\0\0\0\x76\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\x01\0\0\0\
-\0\0\0\0\xc3\0\0\0\x03\x4c\xff\x6f\0\0\0\x80\0\0\0\0\0\0\0\0\0\0\0\0\x08\x39\0\
-\0\0\0\0\0\x06\0\0\0\0\0\0\0\x1c\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\x1e\x01\0\0\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xd8\x28\0\0\0\0\0\0\
-\x40\x02\0\0\0\0\0\0\x01\0\0\0\x12\0\0\0\x08\0\0\0\0\0\0\0\x18\0\0\0\0\0\0\0";
-
-	*sz = sizeof(data) - 1;
-	return (const void *)data;
-}
-
-#ifdef __cplusplus
-struct rateLimiter_bpf *rateLimiter_bpf::open(const struct bpf_object_open_opts *opts) { return rateLimiter_bpf__open_opts(opts); }
-struct rateLimiter_bpf *rateLimiter_bpf::open_and_load() { return rateLimiter_bpf__open_and_load(); }
-int rateLimiter_bpf::load(struct rateLimiter_bpf *skel) { return rateLimiter_bpf__load(skel); }
-int rateLimiter_bpf::attach(struct rateLimiter_bpf *skel) { return rateLimiter_bpf__attach(skel); }
-void rateLimiter_bpf::detach(struct rateLimiter_bpf *skel) { rateLimiter_bpf__detach(skel); }
-void rateLimiter_bpf::destroy(struct rateLimiter_bpf *skel) { rateLimiter_bpf__destroy(skel); }
-const void *rateLimiter_bpf::elf_bytes(size_t *sz) { return rateLimiter_bpf__elf_bytes(sz); }
-#endif /* __cplusplus */
-
-__attribute__((unused)) static void
-rateLimiter_bpf__assert(struct rateLimiter_bpf *s __attribute__((unused)))
-{
-#ifdef __cplusplus
-#define _Static_assert static_assert
-#endif
-	_Static_assert(sizeof(s->rodata->rate_limit_pps) == 4, "unexpected size of 'rate_limit_pps'");
-	_Static_assert(sizeof(s->rodata->burst) == 4, "unexpected size of 'burst'");
-#ifdef __cplusplus
-#undef _Static_assert
-#endif
-}
-
-#endif /* __RATELIMITER_BPF_SKEL_H__ */
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Offload-friendly XDP variant of the per-source rate limiter.
+//
+// Smart NICs that run XDP programs in hardware (XDP_FLAGS_HW_MODE) only
+// support a small subset of BPF, so this program deliberately avoids
+// everything rateLimiter.bpf.c relies on beyond that subset:
+//
+//   - no bpf_ktime_get_ns(): time is an epoch counter in xdp_clock that
+//     userspace advances every quantum
+//   - no ring buffer: drops are only counted (xdp_stats)
+//   - no global data (.rodata/.data): configuration lives in xdp_cfg_map
+//   - no spin locks, no per-CPU maps: only ARRAY and HASH maps, counters
+//     are updated with atomic adds
+//   - no division: the rate is pre-scaled to (milli-)tokens per epoch
+//
+// The same object also runs in native (driver) XDP mode when offload is not
+// available.
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_endian.h>
+
+#include "rateLimiter.h"
+
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// ============================
+// Maps
+// ============================
+
+// Configuration (struct rl_xdp_cfg), written by userspace
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct rl_xdp_cfg);
+} xdp_cfg_map SEC(".maps");
+
+// Current epoch, advanced by userspace every quantum
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, __u64);
+} xdp_clock SEC(".maps");
+
+// Per-source-IP rate limiter state
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, 16384);
+    __type(key, __u32);                  // IPv4 src ip
+    __type(value, struct rl_xdp_state);
+} xdp_rate_map SEC(".maps");
+
+// Packet counters (struct rl_stats), shared by all CPUs
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct rl_stats);
+} xdp_stats SEC(".maps");
+
+// ============================
+// XDP program
+// ============================
+
+#define ETH_P_IP    0x0800 // IPv4 ethertype
+
+SEC("xdp")
+int xdp_ingress(struct xdp_md *ctx)
+{
+    void *data_end = (void *)(long)ctx->data_end;
+    void *data = (void *)(long)ctx->data;
+    struct ethhdr *l2 = data;
+    struct iphdr *l3;
+    struct rl_xdp_cfg *cfg;
+    struct rl_xdp_state *st;
+    struct rl_stats *stats;
+    __u64 *clock, epoch, delta;
+    __u32 src_ip, zero = 0;
+
+    if ((void *)(l2 + 1) > data_end)
+        return XDP_PASS;
+
+    // Only handle IPv4
+    if (l2->h_proto != bpf_htons(ETH_P_IP))
+        return XDP_PASS;
+
+    l3 = (struct iphdr *)(l2 + 1);
+    if ((void *)(l3 + 1) > data_end)
+        return XDP_PASS;
+
+    src_ip = l3->saddr;
+
+    cfg = bpf_map_lookup_elem(&xdp_cfg_map, &zero);
+    clock = bpf_map_lookup_elem(&xdp_clock, &zero);
+    stats = bpf_map_lookup_elem(&xdp_stats, &zero);
+    if (!cfg || !clock || !stats)
+        return XDP_PASS;
+
+    __sync_fetch_and_add(&stats->packets, 1);
+    epoch = *clock;
+
+    st = bpf_map_lookup_elem(&xdp_rate_map, &src_ip);
+    if (!st) {
+        // First time we see this IP: full bucket minus this packet
+        struct rl_xdp_state new_st = {
+            .last_epoch = epoch,
+            .tokens = cfg->max_tokens >= RL_XDP_TOKEN_SCALE ?
+                      cfg->max_tokens - RL_XDP_TOKEN_SCALE : 0,
+        };
+
+        bpf_map_update_elem(&xdp_rate_map, &src_ip, &new_st, BPF_ANY);
+        __sync_fetch_and_add(&stats->passed, 1);
+        return XDP_PASS;
+    }
+
+    // Refill tokens for the epochs elapsed since the last refill. After
+    // refill_epochs the bucket is full anyway, which also keeps the
+    // multiplication below within 32x32 bits.
+    delta = epoch - st->last_epoch;
+    if (delta) {
+        if (delta >= cfg->refill_epochs) {
+            st->tokens = cfg->max_tokens;
+        } else {
+            __u64 tokens = st->tokens + (__u64)(__u32)delta * cfg->tokens_per_epoch;
+
+            st->tokens = tokens > cfg->max_tokens ? cfg->max_tokens : tokens;
+        }
+        st->last_epoch = epoch;
+    }
+
+    // If we have a whole token, consume it and allow packet
+    if (st->tokens >= RL_XDP_TOKEN_SCALE) {
+        st->tokens -= RL_XDP_TOKEN_SCALE;
+        __sync_fetch_and_add(&stats->passed, 1);
+        return XDP_PASS;
+    }
+
+    // No tokens: drop
+    st->dropped++;
+    __sync_fetch_and_add(&stats->dropped[RL_DROP_SOURCE], 1);
+    return XDP_DROP;
+}
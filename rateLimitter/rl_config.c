@@ -0,0 +1,381 @@
+// SPDX-License-Identifier: BSD-3-Clause
+#include "rl_config.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <bpf/libbpf.h>
+
+/*
+ * Config file format
+ * ------------------
+ *
+ *   # comment
+ *   [policy]
+ *   rate = 1000
+ *   burst = 200
+ *
+ *   [maps]
+ *   rate_map_size = 65536
+ *
+ *   [control]
+ *   socket = /run/rateLimiter.sock
+ *   busy_poll_us = 0
+ *   core_cache_dir = /var/cache/rateLimiter
+ *
+ *   [clock]
+ *   quantum_ms = 10
+ *   engine = ktime             # ktime, timer or user
+ *
+ *   [interface eth0]
+ *   mode = tc                  # tc, xdp or xdp-offload
+ *
+ * Every `[interface NAME]` section adds one attach point. Keys are
+ * case-sensitive, values are plain integers or strings.
+ */
+
+enum section {
+    SEC_NONE,
+    SEC_POLICY,
+    SEC_MAPS,
+    SEC_CONTROL,
+    SEC_CLOCK,
+    SEC_IFACE,
+};
+
+void rl_config_init(struct rl_config *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+
+    cfg->policy.rate_pps = 1000;
+    cfg->policy.burst = 200;
+    cfg->quantum_ms = 10;
+
+    strncpy(cfg->ifaces[0].name, "ens160", sizeof(cfg->ifaces[0].name) - 1);
+    cfg->ifaces[0].mode = RL_MODE_TC;
+    cfg->iface_cnt = 1;
+}
+
+const char *rl_mode_str(enum rl_mode mode)
+{
+    switch (mode) {
+    case RL_MODE_TC:          return "tc";
+    case RL_MODE_XDP:         return "xdp";
+    case RL_MODE_XDP_OFFLOAD: return "xdp-offload";
+    default:         return "unknown";
+    }
+}
+
+const char *rl_refill_str(enum rl_refill_mode mode)
+{
+    switch (mode) {
+    case RL_REFILL_KTIME: return "ktime";
+    case RL_REFILL_TIMER: return "timer";
+    case RL_REFILL_USER:  return "user";
+    default:              return "unknown";
+    }
+}
+
+static int parse_refill(const char *str, enum rl_refill_mode *mode)
+{
+    if (!strcmp(str, "ktime"))
+        *mode = RL_REFILL_KTIME;
+    else if (!strcmp(str, "timer"))
+        *mode = RL_REFILL_TIMER;
+    else if (!strcmp(str, "user"))
+        *mode = RL_REFILL_USER;
+    else
+        return -EINVAL;
+    return 0;
+}
+
+static int parse_mode(const char *str, enum rl_mode *mode)
+{
+    if (!strcmp(str, "tc"))
+        *mode = RL_MODE_TC;
+    else if (!strcmp(str, "xdp"))
+        *mode = RL_MODE_XDP;
+    else if (!strcmp(str, "xdp-offload"))
+        *mode = RL_MODE_XDP_OFFLOAD;
+    else
+        return -EINVAL;
+    return 0;
+}
+
+// Parses a non-negative 32-bit integer.
+static int parse_u32(const char *str, __u32 *out)
+{
+    unsigned long val;
+    char *end;
+
+    if (!*str || *str == '-')
+        return -EINVAL;
+
+    errno = 0;
+    val = strtoul(str, &end, 10);
+    if (errno || *end || val > UINT_MAX)
+        return -EINVAL;
+
+    *out = (__u32)val;
+    return 0;
+}
+
+int rl_policy_set(struct rl_policy *policy, const char *key, const char *val)
+{
+    static const struct {
+        const char *name;
+        size_t off;
+    } fields[] = {
+        { "rate",         offsetof(struct rl_policy, rate_pps) },
+        { "burst",        offsetof(struct rl_policy, burst) },
+        { "prefix_rate",  offsetof(struct rl_policy, prefix_rate_pps) },
+        { "prefix_burst", offsetof(struct rl_policy, prefix_burst) },
+        { "agg_rate",     offsetof(struct rl_policy, agg_rate_pps) },
+        { "agg_burst",    offsetof(struct rl_policy, agg_burst) },
+        { "agg_batch",    offsetof(struct rl_policy, agg_batch) },
+    };
+    size_t i;
+
+    __u32 v;
+    int err;
+
+    for (i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        if (strcmp(key, fields[i].name))
+            continue;
+        err = parse_u32(val, &v);
+        if (err)
+            return err;
+        // Unlike the other levels the per-source one can't be turned off:
+        // with no refill it would block every source once its burst is spent.
+        if (fields[i].off == offsetof(struct rl_policy, rate_pps) && !v)
+            return -EINVAL;
+        *(__u32 *)((char *)policy + fields[i].off) = v;
+        return 0;
+    }
+    return -ENOENT;
+}
+
+void rl_policy_finalize(struct rl_policy *policy)
+{
+    int ncpus;
+    __u32 batch;
+
+    // A missing burst defaults to one second worth of rate.
+    if (!policy->burst)
+        policy->burst = policy->rate_pps;
+    if (policy->prefix_rate_pps && !policy->prefix_burst)
+        policy->prefix_burst = policy->prefix_rate_pps;
+    if (policy->agg_rate_pps && !policy->agg_burst)
+        policy->agg_burst = policy->agg_rate_pps;
+
+    if (policy->agg_batch)
+        return;
+
+    // Tokens parked in per-CPU caches are bounded by batch * ncpus, so keep
+    // that under a quarter of the aggregate burst.
+    ncpus = libbpf_num_possible_cpus();
+    batch = policy->agg_burst / (4 * (ncpus > 0 ? ncpus : 1));
+    policy->agg_batch = batch < 1 ? 1 : (batch > 64 ? 64 : batch);
+}
+
+int rl_config_add_iface(struct rl_config *cfg, const char *name, const char *mode)
+{
+    struct rl_iface *iface = NULL;
+    int i;
+
+    if (!*name || strlen(name) >= IFNAMSIZ)
+        return -EINVAL;
+
+    for (i = 0; i < cfg->iface_cnt; i++) {
+        if (!strcmp(cfg->ifaces[i].name, name)) {
+            iface = &cfg->ifaces[i];
+            break;
+        }
+    }
+    if (!iface) {
+        if (cfg->iface_cnt >= RL_MAX_IFACES)
+            return -E2BIG;
+        iface = &cfg->ifaces[cfg->iface_cnt++];
+        memset(iface, 0, sizeof(*iface));
+        strcpy(iface->name, name);
+    }
+
+    iface->mode = RL_MODE_TC;
+    if (mode && parse_mode(mode, &iface->mode))
+        return -EINVAL;
+    return 0;
+}
+
+// Strips leading and trailing whitespace in place.
+static char *trim(char *s)
+{
+    char *end;
+
+    while (isspace((unsigned char)*s))
+        s++;
+    end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+        *--end = '\0';
+    return s;
+}
+
+static int apply_key(struct rl_config *cfg, enum section sec,
+                     struct rl_iface *iface, const char *key, const char *val)
+{
+    switch (sec) {
+    case SEC_POLICY:
+        return rl_policy_set(&cfg->policy, key, val);
+    case SEC_MAPS:
+        if (!strcmp(key, "rate_map_size"))
+            return parse_u32(val, &cfg->rate_map_size);
+        if (!strcmp(key, "prefix_map_size"))
+            return parse_u32(val, &cfg->prefix_map_size);
+        if (!strcmp(key, "ringbuf_size"))
+            return parse_u32(val, &cfg->ringbuf_size);
+        return -ENOENT;
+    case SEC_CONTROL:
+        if (!strcmp(key, "socket")) {
+            if (strlen(val) >= sizeof(cfg->ctl_path))
+                return -EINVAL;
+            strcpy(cfg->ctl_path, val);
+            return 0;
+        }
+        if (!strcmp(key, "busy_poll_us"))
+            return parse_u32(val, &cfg->busy_poll_us);
+        if (!strcmp(key, "core_cache_dir")) {
+            if (strlen(val) >= sizeof(cfg->core_cache_dir))
+                return -EINVAL;
+            strcpy(cfg->core_cache_dir, val);
+            return 0;
+        }
+        if (!strcmp(key, "top_decay_ms"))
+            return parse_u32(val, &cfg->top_decay_ms);
+        if (!strcmp(key, "prog_stats")) {
+            if (strcmp(val, "true") && strcmp(val, "false"))
+                return -EINVAL;
+            cfg->prog_stats = !strcmp(val, "true");
+            return 0;
+        }
+        if (!strcmp(key, "verbose")) {
+            if (strcmp(val, "true") && strcmp(val, "false"))
+                return -EINVAL;
+            cfg->verbose = !strcmp(val, "true");
+            return 0;
+        }
+        return -ENOENT;
+    case SEC_CLOCK:
+        if (!strcmp(key, "quantum_ms")) {
+            if (parse_u32(val, &cfg->quantum_ms) || !cfg->quantum_ms)
+                return -EINVAL;
+            return 0;
+        }
+        if (!strcmp(key, "engine"))
+            return parse_refill(val, &cfg->refill_mode);
+        return -ENOENT;
+    case SEC_IFACE:
+        if (!strcmp(key, "mode"))
+            return parse_mode(val, &iface->mode);
+        return -ENOENT;
+    default:
+        return -ENOENT;
+    }
+}
+
+int rl_config_load(struct rl_config *cfg, const char *path)
+{
+    enum section sec = SEC_NONE;
+    struct rl_iface *iface = NULL;
+    bool ifaces_reset = false;
+    char line[512];
+    int lineno = 0, err = 0;
+    FILE *f;
+
+    f = fopen(path, "r");
+    if (!f) {
+        err = -errno;
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return err;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        char *s, *eq, *key, *val;
+
+        lineno++;
+        s = strchr(line, '#');
+        if (s)
+            *s = '\0';
+        s = trim(line);
+        if (!*s)
+            continue;
+
+        if (*s == '[') {
+            char *end = strchr(s, ']');
+
+            if (!end || end[1]) {
+                fprintf(stderr, "%s:%d: malformed section header\n", path, lineno);
+                err = -EINVAL;
+                break;
+            }
+            *end = '\0';
+            s = trim(s + 1);
+
+            iface = NULL;
+            if (!strcmp(s, "policy")) {
+                sec = SEC_POLICY;
+            } else if (!strcmp(s, "maps")) {
+                sec = SEC_MAPS;
+            } else if (!strcmp(s, "control")) {
+                sec = SEC_CONTROL;
+            } else if (!strcmp(s, "clock")) {
+                sec = SEC_CLOCK;
+            } else if (!strncmp(s, "interface", 9) && isspace((unsigned char)s[9])) {
+                // The file's interface list replaces the built-in default.
+                if (!ifaces_reset) {
+                    cfg->iface_cnt = 0;
+                    ifaces_reset = true;
+                }
+                err = rl_config_add_iface(cfg, trim(s + 9), NULL);
+                if (err) {
+                    fprintf(stderr, "%s:%d: invalid interface '%s'\n",
+                            path, lineno, trim(s + 9));
+                    break;
+                }
+                iface = &cfg->ifaces[cfg->iface_cnt - 1];
+                sec = SEC_IFACE;
+            } else {
+                fprintf(stderr, "%s:%d: unknown section [%s]\n", path, lineno, s);
+                err = -EINVAL;
+                break;
+            }
+            continue;
+        }
+
+        eq = strchr(s, '=');
+        if (!eq) {
+            fprintf(stderr, "%s:%d: expected key = value\n", path, lineno);
+            err = -EINVAL;
+            break;
+        }
+        *eq = '\0';
+        key = trim(s);
+        val = trim(eq + 1);
+
+        err = apply_key(cfg, sec, iface, key, val);
+        if (err == -ENOENT) {
+            fprintf(stderr, "%s:%d: unknown key '%s'\n", path, lineno, key);
+            break;
+        }
+        if (err) {
+            fprintf(stderr, "%s:%d: invalid value for '%s': %s\n",
+                    path, lineno, key, val);
+            break;
+        }
+    }
+
+    fclose(f);
+    return err;
+}
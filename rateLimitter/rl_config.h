@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// rl_config.h
+#ifndef __RL_CONFIG_H
+#define __RL_CONFIG_H
+
+#include <stdbool.h>
+#include <limits.h>
+#include <net/if.h>
+#include <sys/un.h>
+#include <linux/types.h>
+#include <linux/bpf.h>      // struct bpf_spin_lock
+
+#include "rateLimiter.h"   // struct rl_policy
+
+#define RL_MAX_IFACES 16
+
+// How the eBPF program is hooked into an interface.
+enum rl_mode {
+    RL_MODE_TC = 0,       // TC ingress (clsact)
+    RL_MODE_XDP,          // offload-friendly XDP variant, native (driver) mode
+    RL_MODE_XDP_OFFLOAD,  // XDP variant on the NIC, falling back to native
+};
+
+struct rl_iface {
+    char name[IFNAMSIZ];
+    enum rl_mode mode;
+};
+
+/*
+ * Everything the daemon needs to start: where to attach, which limits to
+ * enforce and how big the maps are. Filled from defaults, then from the
+ * config file (-c), then from command-line overrides.
+ */
+struct rl_config {
+    struct rl_iface ifaces[RL_MAX_IFACES];
+    int iface_cnt;
+
+    struct rl_policy policy;
+
+    // Map sizes (0 keeps the size compiled into the eBPF object)
+    __u32 rate_map_size;
+    __u32 prefix_map_size;
+    __u32 ringbuf_size;
+
+    // Length of one epoch of the quantized clocks (milliseconds): the
+    // userspace-driven clock of the XDP variant, and the refill clock of
+    // the TC program unless refill_mode is RL_REFILL_KTIME
+    __u32 quantum_ms;
+
+    // Time source for token bucket refills in the TC program
+    enum rl_refill_mode refill_mode;
+
+    // Half-life of the drop counts behind `top` (0 keeps the built-in 1s)
+    __u32 top_decay_ms;
+
+    // Spin budget (microseconds) on the ring buffer before sleeping in
+    // epoll_wait(); 0 always sleeps. Needs the bundled libbpf.
+    __u32 busy_poll_us;
+
+    // UNIX control socket path ("" disables the control socket)
+    char ctl_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+
+    // Where libbpf keeps CO-RE relocation results across restarts
+    // ("" disables the cache). Needs the bundled libbpf.
+    char core_cache_dir[PATH_MAX];
+
+    // Sample the BPF programs' run time (BPF_ENABLE_STATS) and report it
+    // in `stats`. Costs a little on every packet. Needs the bundled libbpf.
+    bool prog_stats;
+
+    bool verbose;
+};
+
+/*
+ * rl_config_init():
+ *  - fills cfg with the built-in defaults (ens160/tc, 1000 pps, burst 200,
+ *    10ms quantum)
+ */
+void rl_config_init(struct rl_config *cfg);
+
+/*
+ * rl_config_load():
+ *  - parses the config file at path on top of the current contents of cfg
+ *  - reports problems as "path:line: message" on stderr
+ *
+ * returns 0 on success, negative errno on failure
+ */
+int rl_config_load(struct rl_config *cfg, const char *path);
+
+/*
+ * rl_config_add_iface():
+ *  - appends an interface to cfg (replacing an existing entry of that name)
+ *
+ * returns 0 on success, negative errno on failure
+ */
+int rl_config_add_iface(struct rl_config *cfg, const char *name, const char *mode);
+
+/*
+ * rl_policy_set():
+ *  - sets one policy field by name ("rate", "burst", "prefix_rate",
+ *    "prefix_burst", "agg_rate", "agg_burst", "agg_batch")
+ *  - shared by the config file parser and the `set-policy` control command
+ *
+ * returns 0 on success, -ENOENT for an unknown key, -EINVAL for a bad value
+ */
+int rl_policy_set(struct rl_policy *policy, const char *key, const char *val);
+
+/*
+ * rl_policy_finalize():
+ *  - fills in derived values: missing bursts default to one second of rate,
+ *    agg_batch is sized so per-CPU caches hold at most a quarter of agg_burst
+ */
+void rl_policy_finalize(struct rl_policy *policy);
+
+const char *rl_mode_str(enum rl_mode mode);
+const char *rl_refill_str(enum rl_refill_mode mode);
+
+#endif /* __RL_CONFIG_H */
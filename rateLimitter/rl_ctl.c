@@ -0,0 +1,472 @@
+// SPDX-License-Identifier: BSD-3-Clause
+#define _GNU_SOURCE      // accept4()
+#include "rl_ctl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <linux/membarrier.h>
+
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+
+#include "common_um.h"     // RL_HAVE_LIBBPF_EXT
+#include "rl_config.h"     // rl_policy_set(), rl_policy_finalize()
+
+#define RL_CTL_MAX_LINE 512
+
+struct rl_ctl {
+    int fd;
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    struct rl_ctl_maps maps;
+};
+
+struct rl_ctl *rl_ctl_open(const char *path, const struct rl_ctl_maps *maps)
+{
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    struct rl_ctl *ctl;
+    int err;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        errno = ENAMETOOLONG;
+        return NULL;
+    }
+
+    ctl = calloc(1, sizeof(*ctl));
+    if (!ctl)
+        return NULL;
+    strcpy(ctl->path, path);
+    strcpy(addr.sun_path, path);
+    ctl->maps = *maps;
+
+    // Non-blocking, so rl_ctl_process() can drain it from the poll loop.
+    ctl->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (ctl->fd < 0)
+        goto err_free;
+
+    // A previous instance that was killed may have left its socket behind.
+    unlink(path);
+    if (bind(ctl->fd, (struct sockaddr *)&addr, sizeof(addr)))
+        goto err_close;
+    // Control commands can change the policy: root only.
+    if (chmod(path, 0600) || listen(ctl->fd, 8))
+        goto err_unlink;
+
+    return ctl;
+
+err_unlink:
+    err = errno;
+    unlink(path);
+    errno = err;
+err_close:
+    err = errno;
+    close(ctl->fd);
+    errno = err;
+err_free:
+    free(ctl);
+    return NULL;
+}
+
+void rl_ctl_close(struct rl_ctl *ctl)
+{
+    if (!ctl)
+        return;
+    close(ctl->fd);
+    unlink(ctl->path);
+    free(ctl);
+}
+
+static const struct rl_policy *live_policy(const struct rl_ctl *ctl)
+{
+    return &ctl->maps.policies[*ctl->maps.policy_idx % RL_POLICY_SLOTS];
+}
+
+// Waits until every packet that may have read policy_idx before now is done.
+// TC and XDP programs run in RCU read-side sections, and
+// MEMBARRIER_CMD_GLOBAL waits for an RCU grace period (it returns at once on
+// a single CPU, where no packet can be in flight while we run). nohz_full
+// kernels refuse it; packets take microseconds, so sleeping is enough there.
+static void wait_for_readers(void)
+{
+    struct timespec ts = { .tv_nsec = 10 * 1000 * 1000 };
+
+    if (syscall(__NR_membarrier, MEMBARRIER_CMD_GLOBAL, 0, 0))
+        nanosleep(&ts, NULL);
+}
+
+// The eBPF program copies the policy field by field, so never write a copy
+// that may be in use: fill in the other one, switch over with a single store,
+// and wait for packets still copying the old one before it can be reused by
+// the next update.
+static void publish_policy(struct rl_ctl *ctl, const struct rl_policy *pol)
+{
+    __u32 next = (*ctl->maps.policy_idx + 1) % RL_POLICY_SLOTS;
+
+    ctl->maps.policies[next] = *pol;
+    __atomic_store_n(ctl->maps.policy_idx, next, __ATOMIC_RELEASE);
+    wait_for_readers();
+}
+
+static void print_policy(FILE *out, const struct rl_policy *p)
+{
+    fprintf(out, "policy rate=%u burst=%u prefix_rate=%u prefix_burst=%u "
+                 "agg_rate=%u agg_burst=%u agg_batch=%u\n",
+            p->rate_pps, p->burst, p->prefix_rate_pps, p->prefix_burst,
+            p->agg_rate_pps, p->agg_burst, p->agg_batch);
+}
+
+static const char *ip_str(__u32 ip, char *buf, size_t sz)
+{
+    struct in_addr addr = { .s_addr = ip };
+
+    return inet_ntop(AF_INET, &addr, buf, sz) ?: "<invalid>";
+}
+
+static void cmd_stats(struct rl_ctl *ctl, FILE *out)
+{
+    struct rl_stats *percpu, sum = {};
+    __u32 zero = 0;
+    int ncpus, i, j;
+
+    ncpus = libbpf_num_possible_cpus();
+    if (ncpus <= 0) {
+        fprintf(out, "error: cannot determine number of CPUs\n");
+        return;
+    }
+
+    percpu = calloc(ncpus, sizeof(*percpu));
+    if (!percpu) {
+        fprintf(out, "error: out of memory\n");
+        return;
+    }
+
+    // Per-CPU array: one lookup returns the slot of every CPU.
+    if (bpf_map_lookup_elem(ctl->maps.stats_map_fd, &zero, percpu)) {
+        fprintf(out, "error: reading stats_map: %s\n", strerror(errno));
+        free(percpu);
+        return;
+    }
+
+    for (i = 0; i < ncpus; i++) {
+        sum.packets += percpu[i].packets;
+        sum.passed += percpu[i].passed;
+        for (j = 0; j < RL_DROP_MAX; j++)
+            sum.dropped[j] += percpu[i].dropped[j];
+    }
+    free(percpu);
+
+    fprintf(out, "packets %llu\n", (unsigned long long)sum.packets);
+    fprintf(out, "passed %llu\n", (unsigned long long)sum.passed);
+    fprintf(out, "dropped_source %llu\n", (unsigned long long)sum.dropped[RL_DROP_SOURCE]);
+    fprintf(out, "dropped_prefix %llu\n", (unsigned long long)sum.dropped[RL_DROP_PREFIX]);
+    fprintf(out, "dropped_aggregate %llu\n", (unsigned long long)sum.dropped[RL_DROP_AGGREGATE]);
+    print_policy(out, live_policy(ctl));
+    if (ctl->maps.print_stats)
+        ctl->maps.print_stats(out, ctl->maps.ctx);
+}
+
+// One source as seen by one CPU's summary, while merging them.
+struct topn_entry {
+    __u32 src_ip;
+    __u32 cpu;
+    __u64 count;
+    __u64 error;
+};
+
+static int cmp_entry_ip(const void *a, const void *b)
+{
+    const struct topn_entry *x = a, *y = b;
+
+    return x->src_ip < y->src_ip ? -1 : (x->src_ip > y->src_ip ? 1 : 0);
+}
+
+static int cmp_entry_desc(const void *a, const void *b)
+{
+    const struct topn_entry *x = a, *y = b;
+
+    return x->count < y->count ? 1 : (x->count > y->count ? -1 : 0);
+}
+
+// Answers from the in-kernel Space-Saving summaries: one map read per CPU, no
+// matter how many sources rate_map tracks.
+//
+// The per-CPU summaries are merged by adding up each source's counts. A CPU
+// whose summary is full and does not list the source may still have seen it
+// up to its smallest count times, so that is added to both count and error:
+// count stays an over-estimate bounded by error, and a source behind more
+// than 1/RL_TOPN_SLOTS of all drops is behind that share on some CPU, so it
+// is still listed.
+static void cmd_top(struct rl_ctl *ctl, FILE *out, const char *arg)
+{
+    char ipbuf[INET_ADDRSTRLEN];
+    struct topn_entry *ent = NULL, *merged;
+    struct rl_topn *topn = NULL;
+    __u64 *min = NULL, min_sum = 0, seen_min;
+    int ncpus, cpu, i, j, nent = 0, nmerged = 0;
+    long n = 10;
+
+    if (arg) {
+        n = strtol(arg, NULL, 10);
+        if (n <= 0 || n > RL_TOPN_SLOTS) {
+            fprintf(out, "error: N must be between 1 and %d\n", RL_TOPN_SLOTS);
+            return;
+        }
+    }
+
+    ncpus = libbpf_num_possible_cpus();
+    if (ncpus <= 0) {
+        fprintf(out, "error: cannot determine number of CPUs\n");
+        return;
+    }
+
+    topn = calloc(ncpus, sizeof(*topn));
+    min = calloc(ncpus, sizeof(*min));
+    ent = calloc((size_t)ncpus * RL_TOPN_SLOTS, sizeof(*ent));
+    if (!topn || !min || !ent) {
+        fprintf(out, "error: out of memory\n");
+        goto out;
+    }
+
+    for (cpu = 0; cpu < ncpus; cpu++) {
+        // BPF_F_LOCK copies the value under its spin lock: a consistent
+        // snapshot of that CPU's summary.
+        if (bpf_map_lookup_elem_flags(ctl->maps.topn_map_fd, &cpu, &topn[cpu],
+                                      BPF_F_LOCK)) {
+            fprintf(out, "error: reading topn_map: %s\n", strerror(errno));
+            goto out;
+        }
+
+        // A summary with a free slot has seen every source it was told about.
+        min[cpu] = topn[cpu].slots[0].count;
+        for (i = 0; i < RL_TOPN_SLOTS; i++) {
+            const struct rl_topn_slot *slot = &topn[cpu].slots[i];
+
+            if (slot->count < min[cpu])
+                min[cpu] = slot->count;
+            if (!slot->count)
+                continue;
+            ent[nent].src_ip = slot->src_ip;
+            ent[nent].cpu = cpu;
+            ent[nent].count = slot->count;
+            ent[nent].error = slot->error;
+            nent++;
+        }
+        min_sum += min[cpu];
+    }
+
+    // Fold the entries of each source into the first one.
+    qsort(ent, nent, sizeof(*ent), cmp_entry_ip);
+    for (i = 0; i < nent; i = j) {
+        merged = &ent[nmerged++];
+        *merged = ent[i];
+        seen_min = min[ent[i].cpu];
+        for (j = i + 1; j < nent && ent[j].src_ip == ent[i].src_ip; j++) {
+            merged->count += ent[j].count;
+            merged->error += ent[j].error;
+            seen_min += min[ent[j].cpu];
+        }
+        merged->count += min_sum - seen_min;
+        merged->error += min_sum - seen_min;
+    }
+
+    qsort(ent, nmerged, sizeof(*ent), cmp_entry_desc);
+    for (i = 0; i < n && i < nmerged; i++)
+        fprintf(out, "%s count=%llu error=%llu\n",
+                ip_str(ent[i].src_ip, ipbuf, sizeof(ipbuf)),
+                (unsigned long long)ent[i].count,
+                (unsigned long long)ent[i].error);
+out:
+    free(ent);
+    free(min);
+    free(topn);
+}
+
+static void cmd_set_policy(struct rl_ctl *ctl, FILE *out, char **saveptr)
+{
+    struct rl_policy pol = *live_policy(ctl);
+    bool agg_changed = false, batch_given = false;
+    char *tok, *eq;
+    int err;
+
+    while ((tok = strtok_r(NULL, " \t\r\n", saveptr))) {
+        eq = strchr(tok, '=');
+        if (!eq) {
+            fprintf(out, "error: expected KEY=VALUE, got '%s'\n", tok);
+            return;
+        }
+        *eq = '\0';
+
+        err = rl_policy_set(&pol, tok, eq + 1);
+        if (err == -ENOENT) {
+            fprintf(out, "error: unknown policy key '%s'\n", tok);
+            return;
+        }
+        if (err) {
+            fprintf(out, "error: invalid value for '%s': %s\n", tok, eq + 1);
+            return;
+        }
+
+        if (!strcmp(tok, "agg_batch"))
+            batch_given = true;
+        else if (!strncmp(tok, "agg_", 4))
+            agg_changed = true;
+    }
+
+    // Re-derive the per-CPU batch for a new aggregate bucket unless asked for one.
+    if (agg_changed && !batch_given)
+        pol.agg_batch = 0;
+    rl_policy_finalize(&pol);
+
+    publish_policy(ctl, &pol);
+    if (ctl->maps.policy_changed)
+        ctl->maps.policy_changed(&pol, ctl->maps.ctx);
+    print_policy(out, &pol);
+}
+
+static void cmd_flush_source(struct rl_ctl *ctl, FILE *out, const char *arg)
+{
+    struct in_addr addr;
+
+    if (!arg || inet_pton(AF_INET, arg, &addr) != 1) {
+        fprintf(out, "error: usage: flush-source IPV4\n");
+        return;
+    }
+
+    if (bpf_map_delete_elem(ctl->maps.rate_map_fd, &addr.s_addr)) {
+        fprintf(out, "error: %s: %s\n", arg,
+                errno == ENOENT ? "not tracked" : strerror(errno));
+        return;
+    }
+    fprintf(out, "flushed %s\n", arg);
+}
+
+static void dump_one(FILE *out, __u32 key, const struct rate_state *st)
+{
+    char ipbuf[INET_ADDRSTRLEN];
+
+    fprintf(out, "%s tokens=%u dropped=%u last_ts_ns=%llu\n",
+            ip_str(key, ipbuf, sizeof(ipbuf)), st->tokens, st->dropped,
+            (unsigned long long)st->last_ts_ns);
+}
+
+#if RL_HAVE_LIBBPF_EXT
+// Batched lookups: a handful of syscalls instead of two per source.
+static void cmd_dump(struct rl_ctl *ctl, FILE *out)
+{
+    struct bpf_map_dump *d;
+    const void *key, *st;
+    int err;
+
+    d = bpf_map_dump__new(ctl->maps.rate_map_fd, NULL);
+    if (!d) {
+        fprintf(out, "error: reading rate_map: %s\n", strerror(errno));
+        return;
+    }
+    while (!(err = bpf_map_dump__next(d, &key, &st)))
+        dump_one(out, *(const __u32 *)key, st);
+    if (err != -ENOENT)
+        fprintf(out, "error: reading rate_map: %s\n", strerror(-err));
+    bpf_map_dump__free(d);
+}
+#else
+static void cmd_dump(struct rl_ctl *ctl, FILE *out)
+{
+    struct rate_state st;
+    __u32 key, *prev = NULL;
+
+    while (!bpf_map_get_next_key(ctl->maps.rate_map_fd, prev, &key)) {
+        prev = &key;
+        if (bpf_map_lookup_elem(ctl->maps.rate_map_fd, &key, &st))
+            continue;
+        dump_one(out, key, &st);
+    }
+}
+#endif
+
+static void handle_command(struct rl_ctl *ctl, char *line, FILE *out)
+{
+    char *saveptr, *cmd, *arg;
+
+    cmd = strtok_r(line, " \t\r\n", &saveptr);
+    if (!cmd) {
+        fprintf(out, "error: empty command\n");
+        return;
+    }
+
+    if (!strcmp(cmd, "set-policy")) {
+        cmd_set_policy(ctl, out, &saveptr);
+        return;
+    }
+
+    arg = strtok_r(NULL, " \t\r\n", &saveptr);
+    if (!strcmp(cmd, "stats"))
+        cmd_stats(ctl, out);
+    else if (!strcmp(cmd, "top"))
+        cmd_top(ctl, out, arg);
+    else if (!strcmp(cmd, "flush-source"))
+        cmd_flush_source(ctl, out, arg);
+    else if (!strcmp(cmd, "dump"))
+        cmd_dump(ctl, out);
+    else
+        fprintf(out, "error: unknown command '%s' "
+                     "(stats, top, set-policy, flush-source, dump)\n", cmd);
+}
+
+// Reads one command line from a freshly accepted client.
+static int read_line(int fd, char *buf, size_t sz)
+{
+    size_t len = 0;
+    ssize_t n;
+
+    while (len < sz - 1) {
+        n = read(fd, buf + len, sz - 1 - len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        len += n;
+        if (memchr(buf + len - n, '\n', n))
+            break;
+    }
+    buf[len] = '\0';
+    return len ? 0 : -1;
+}
+
+void rl_ctl_process(struct rl_ctl *ctl)
+{
+    // Never let a slow client stall the event loop for long.
+    struct timeval tv = { .tv_sec = 0, .tv_usec = 100 * 1000 };
+    char line[RL_CTL_MAX_LINE];
+    FILE *out;
+    int cfd;
+
+    if (!ctl)
+        return;
+
+    while ((cfd = accept4(ctl->fd, NULL, NULL, SOCK_CLOEXEC)) >= 0) {
+        setsockopt(cfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(cfd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+        if (read_line(cfd, line, sizeof(line))) {
+            close(cfd);
+            continue;
+        }
+
+        out = fdopen(cfd, "w");
+        if (!out) {
+            close(cfd);
+            continue;
+        }
+        handle_command(ctl, line, out);
+        fclose(out);
+    }
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// rl_ctl.h
+#ifndef __RL_CTL_H
+#define __RL_CTL_H
+
+#include <stdio.h>
+#include <linux/types.h>
+#include <linux/bpf.h>      // struct bpf_spin_lock
+
+#include "rateLimiter.h"   // struct rl_policy
+
+struct rl_ctl;
+
+// Kernel-side objects the control socket answers from. Everything is read
+// straight from the maps, so queries never stop or reload the datapath.
+struct rl_ctl_maps {
+    int rate_map_fd;              // per-source state (struct rate_state)
+    int stats_map_fd;             // per-CPU packet counters (struct rl_stats)
+    int topn_map_fd;              // heavy-hitter summary (struct rl_topn)
+    struct rl_policy *policies;   // RL_POLICY_SLOTS copies in the mmap'ed .data section
+    __u32 *policy_idx;            // the copy in use
+
+    // Optional hooks for datapaths that keep their own maps (XDP variant)
+    void (*policy_changed)(const struct rl_policy *policy, void *ctx);
+    void (*print_stats)(FILE *out, void *ctx);
+    void *ctx;
+};
+
+/*
+ * rl_ctl_open():
+ *  - creates a listening UNIX stream socket at path (replacing a stale one)
+ *
+ * returns the control socket handle, or NULL with errno set
+ */
+struct rl_ctl *rl_ctl_open(const char *path, const struct rl_ctl_maps *maps);
+
+/*
+ * rl_ctl_process():
+ *  - serves every client currently waiting on the socket, without blocking
+ *
+ * A client sends one command line and receives a text reply:
+ *   stats                       packet counters and current policy
+ *   top [N]                     N most rate-limited sources (default 10)
+ *   set-policy KEY=VAL ...      change limits on the fly
+ *   flush-source IP             forget the bucket of one source
+ *   dump                        every tracked source
+ */
+void rl_ctl_process(struct rl_ctl *ctl);
+
+// rl_ctl_close(): closes the socket and removes its path.
+void rl_ctl_close(struct rl_ctl *ctl);
+
+#endif /* __RL_CTL_H */
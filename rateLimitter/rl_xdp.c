@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+#include "rl_xdp.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <net/if.h>
+#include <linux/if_link.h>  // XDP_FLAGS_*
+
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+
+#include "common_um.h"     // RL_HAVE_LIBBPF_EXT
+#include "rateLimiter_xdp.skel.h"
+
+struct rl_xdp {
+    struct rateLimiter_xdp_bpf *skel;
+    char ifname[IFNAMSIZ];
+    int ifindex;
+    __u32 attach_flags;   // XDP_FLAGS_HW_MODE or XDP_FLAGS_DRV_MODE
+    __u32 quantum_ms;
+};
+
+/*
+ * Opens the XDP skeleton and loads it, either onto the NIC (offload) or
+ * into the kernel. For offload, the program and every map have to be bound
+ * to the device before loading: offloaded maps live in NIC memory.
+ */
+static struct rateLimiter_xdp_bpf *load_skel(int ifindex, bool offload,
+                                             const struct rl_xdp_opts *opts)
+{
+    LIBBPF_OPTS(bpf_object_open_opts, open_opts);
+    struct rateLimiter_xdp_bpf *skel;
+    struct bpf_map *map;
+    int err;
+
+#if RL_HAVE_LIBBPF_EXT
+    open_opts.core_cache_dir = opts->core_cache_dir;
+#endif
+    skel = rateLimiter_xdp_bpf__open_opts(&open_opts);
+    if (!skel)
+        return NULL;
+
+    if (opts->map_size) {
+        err = bpf_map__set_max_entries(skel->maps.xdp_rate_map, opts->map_size);
+        if (err)
+            goto err_destroy;
+    }
+
+    if (offload) {
+        bpf_program__set_ifindex(skel->progs.xdp_ingress, ifindex);
+        bpf_object__for_each_map(map, skel->obj) {
+            err = bpf_map__set_ifindex(map, ifindex);
+            if (err)
+                goto err_destroy;
+        }
+    }
+
+    err = rateLimiter_xdp_bpf__load(skel);
+    if (err)
+        goto err_destroy;
+    return skel;
+
+err_destroy:
+    rateLimiter_xdp_bpf__destroy(skel);
+    errno = -err;
+    return NULL;
+}
+
+// Loads and attaches in the given mode; on success x->skel is set.
+static int try_attach(struct rl_xdp *x, bool offload, const struct rl_xdp_opts *opts)
+{
+    __u32 flags = offload ? XDP_FLAGS_HW_MODE : XDP_FLAGS_DRV_MODE;
+    struct rateLimiter_xdp_bpf *skel;
+    int err;
+
+    skel = load_skel(x->ifindex, offload, opts);
+    if (!skel)
+        return -errno;
+
+    err = bpf_xdp_attach(x->ifindex, bpf_program__fd(skel->progs.xdp_ingress),
+                         flags | XDP_FLAGS_UPDATE_IF_NOEXIST, NULL);
+    if (err) {
+        rateLimiter_xdp_bpf__destroy(skel);
+        return err;
+    }
+
+    x->skel = skel;
+    x->attach_flags = flags;
+    return 0;
+}
+
+struct rl_xdp *rl_xdp_attach(const char *ifname, bool offload,
+                             const struct rl_policy *policy,
+                             const struct rl_xdp_opts *opts)
+{
+    struct rl_xdp *x;
+    int err;
+
+    x = calloc(1, sizeof(*x));
+    if (!x)
+        return NULL;
+
+    strncpy(x->ifname, ifname, sizeof(x->ifname) - 1);
+    x->quantum_ms = opts->quantum_ms ?: 1;
+    x->ifindex = if_nametoindex(ifname);
+    if (!x->ifindex) {
+        fprintf(stderr, "if_nametoindex(%s) failed: %s\n", ifname, strerror(errno));
+        free(x);
+        return NULL;
+    }
+
+    err = -EOPNOTSUPP;
+    if (offload) {
+        err = try_attach(x, true, opts);
+        if (err && opts->verbose)
+            printf("XDP offload not available on %s (%d), using native XDP\n",
+                   ifname, err);
+    }
+    if (err)
+        err = try_attach(x, false, opts);
+    if (err) {
+        fprintf(stderr, "Failed to attach XDP program on %s: %d\n", ifname, err);
+        free(x);
+        return NULL;
+    }
+
+    err = rl_xdp_set_policy(x, policy);
+    if (!err)
+        err = rl_xdp_tick(x, 0);
+    if (err) {
+        fprintf(stderr, "Failed to configure XDP program on %s: %d\n", ifname, err);
+        rl_xdp_detach(x);
+        return NULL;
+    }
+
+    if (opts->verbose)
+        printf("Attached XDP program on %s (ifindex %d, %s mode)\n", ifname,
+               x->ifindex, rl_xdp_offloaded(x) ? "offload" : "native");
+    return x;
+}
+
+bool rl_xdp_offloaded(const struct rl_xdp *x)
+{
+    return x->attach_flags == XDP_FLAGS_HW_MODE;
+}
+
+const char *rl_xdp_ifname(const struct rl_xdp *x)
+{
+    return x->ifname;
+}
+
+int rl_xdp_prog_fd(const struct rl_xdp *x)
+{
+    return bpf_program__fd(x->skel->progs.xdp_ingress);
+}
+
+int rl_xdp_set_policy(struct rl_xdp *x, const struct rl_policy *policy)
+{
+    struct rl_xdp_cfg cfg = {};
+    __u64 tokens, epochs;
+    __u32 zero = 0;
+
+    // The datapath cannot divide: pre-scale the rate to tokens per epoch.
+    // With tokens in 1/1000 of a packet and epochs in ms this is exact.
+    tokens = (__u64)policy->rate_pps * x->quantum_ms * RL_XDP_TOKEN_SCALE / 1000;
+    cfg.tokens_per_epoch = tokens < 1 ? 1 : (tokens > UINT32_MAX ? UINT32_MAX : tokens);
+    cfg.max_tokens = (__u64)policy->burst * RL_XDP_TOKEN_SCALE;
+    epochs = (cfg.max_tokens + cfg.tokens_per_epoch - 1) / cfg.tokens_per_epoch;
+    cfg.refill_epochs = epochs < 1 ? 1 : (epochs > UINT32_MAX ? UINT32_MAX : epochs);
+
+    if (bpf_map_update_elem(bpf_map__fd(x->skel->maps.xdp_cfg_map), &zero, &cfg, BPF_ANY))
+        return -errno;
+    return 0;
+}
+
+int rl_xdp_tick(struct rl_xdp *x, __u64 epoch)
+{
+    __u32 zero = 0;
+
+    if (bpf_map_update_elem(bpf_map__fd(x->skel->maps.xdp_clock), &zero, &epoch, BPF_ANY))
+        return -errno;
+    return 0;
+}
+
+int rl_xdp_read_stats(struct rl_xdp *x, struct rl_stats *out)
+{
+    __u32 zero = 0;
+
+    if (bpf_map_lookup_elem(bpf_map__fd(x->skel->maps.xdp_stats), &zero, out))
+        return -errno;
+    return 0;
+}
+
+void rl_xdp_detach(struct rl_xdp *x)
+{
+    if (!x)
+        return;
+    bpf_xdp_detach(x->ifindex, x->attach_flags, NULL);
+    rateLimiter_xdp_bpf__destroy(x->skel);
+    free(x);
+}
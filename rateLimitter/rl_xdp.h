@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// rl_xdp.h
+#ifndef __RL_XDP_H
+#define __RL_XDP_H
+
+#include <stdbool.h>
+#include <linux/types.h>
+#include <linux/bpf.h>      // struct bpf_spin_lock
+
+#include "rateLimiter.h"   // struct rl_policy, struct rl_stats
+
+// One interface running the offload-friendly XDP variant (rateLimiter_xdp.bpf.c).
+struct rl_xdp;
+
+struct rl_xdp_opts {
+    __u32 quantum_ms;   // length of one epoch
+    __u32 map_size;     // xdp_rate_map entries (0 = compiled-in size)
+    const char *core_cache_dir;  // CO-RE relocation cache (NULL = off)
+    bool verbose;
+};
+
+/*
+ * rl_xdp_attach():
+ *  - loads a private instance of the XDP variant for ifname
+ *  - with offload, first tries to load it onto the NIC and attach it with
+ *    XDP_FLAGS_HW_MODE; if the driver refuses, falls back to native
+ *    (XDP_FLAGS_DRV_MODE)
+ *
+ * returns the instance, or NULL on failure
+ */
+struct rl_xdp *rl_xdp_attach(const char *ifname, bool offload,
+                             const struct rl_policy *policy,
+                             const struct rl_xdp_opts *opts);
+
+// rl_xdp_offloaded(): true if the program runs on the NIC.
+bool rl_xdp_offloaded(const struct rl_xdp *x);
+
+/*
+ * rl_xdp_set_policy():
+ *  - rescales the policy to tokens per epoch and writes it to xdp_cfg_map
+ *
+ * returns 0 on success, negative errno on failure
+ */
+int rl_xdp_set_policy(struct rl_xdp *x, const struct rl_policy *policy);
+
+/*
+ * rl_xdp_tick():
+ *  - publishes the current epoch to the datapath (xdp_clock)
+ *
+ * returns 0 on success, negative errno on failure
+ */
+int rl_xdp_tick(struct rl_xdp *x, __u64 epoch);
+
+/*
+ * rl_xdp_read_stats():
+ *  - copies the packet counters of this instance into out
+ *
+ * returns 0 on success, negative errno on failure
+ */
+int rl_xdp_read_stats(struct rl_xdp *x, struct rl_stats *out);
+
+const char *rl_xdp_ifname(const struct rl_xdp *x);
+
+// rl_xdp_prog_fd(): fd of the loaded XDP program, e.g. for run-time stats.
+int rl_xdp_prog_fd(const struct rl_xdp *x);
+
+// rl_xdp_detach(): detaches the program and destroys the instance.
+void rl_xdp_detach(struct rl_xdp *x);
+
+#endif /* __RL_XDP_H */
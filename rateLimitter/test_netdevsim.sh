@@ -0,0 +1,130 @@
+#!/bin/bash
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Exercises the XDP offload path (-m xdp-offload) on a netdevsim device:
+# the program must attach in offload mode, its configuration must reach the
+# offloaded xdp_cfg_map with the rate scaled exactly, set-policy must update
+# it, and the program must be detached on shutdown.
+#
+# netdevsim accepts offloaded programs and maps but does not run them on
+# traffic, so this checks the control path, not the drop rate.
+#
+# Needs root, the netdevsim module, bpftool, jq and socat:
+#   sudo ./test_netdevsim.sh [path/to/rateLimiter]
+
+set -u
+
+RL=${1:-./rateLimiter}
+BPFTOOL=${BPFTOOL:-bpftool}
+NSIM_ID=$((RANDOM % 1000 + 1000))
+SOCK=$(mktemp -u /tmp/rl-nsim.XXXXXX.sock)
+QUANTUM_MS=10   # rateLimiter.conf default, [clock] quantum_ms
+RL_PID=
+NSIM=
+FAILED=0
+
+fail() { echo "FAIL: $*"; FAILED=1; }
+pass() { echo "ok:   $*"; }
+
+cleanup() {
+    [ -n "$RL_PID" ] && kill "$RL_PID" 2>/dev/null && wait "$RL_PID" 2>/dev/null
+    [ -e /sys/bus/netdevsim/devices/netdevsim$NSIM_ID ] &&
+        echo "$NSIM_ID" > /sys/bus/netdevsim/del_device
+    rm -f "$SOCK"
+}
+trap cleanup EXIT
+
+ctl() { echo "$*" | socat - UNIX-CONNECT:"$SOCK"; }
+
+# Prints the offloaded XDP program id on $NSIM, empty if none.
+xdp_prog_id() {
+    ip -j -details link show dev "$NSIM" | jq -r '.[0].xdp.prog.id // empty'
+}
+
+# Prints field $1 of xdp_cfg_map[0] of the program attached to $NSIM.
+xdp_cfg() {
+    local prog map
+
+    prog=$(xdp_prog_id) || return 1
+    for map in $($BPFTOOL -j prog show id "$prog" | jq -r '.map_ids[]'); do
+        if [ "$($BPFTOOL -j map show id "$map" | jq -r .name)" = xdp_cfg_map ]; then
+            $BPFTOOL -j map lookup id "$map" key 0 0 0 0 | jq -r ".formatted.value.$1"
+            return
+        fi
+    done
+    return 1
+}
+
+# Checks the offloaded config against rate $1 pps, burst $2 packets.
+check_cfg() {
+    local want_tpe=$(($1 * QUANTUM_MS)) want_max=$(($2 * 1000)) tpe max
+
+    tpe=$(xdp_cfg tokens_per_epoch)
+    max=$(xdp_cfg max_tokens)
+    if [ "$tpe" = "$want_tpe" ] && [ "$max" = "$want_max" ]; then
+        pass "xdp_cfg_map: rate $1 burst $2 -> tokens_per_epoch=$tpe max_tokens=$max"
+    else
+        fail "xdp_cfg_map: rate $1 burst $2 -> tokens_per_epoch=$tpe max_tokens=$max," \
+             "want $want_tpe and $want_max"
+    fi
+}
+
+if [ "$(id -u)" -ne 0 ]; then
+    echo "must run as root" >&2
+    exit 2
+fi
+for tool in "$BPFTOOL" jq socat; do
+    if ! command -v "$tool" >/dev/null; then
+        echo "$tool not found" >&2
+        exit 2
+    fi
+done
+if [ ! -x "$RL" ]; then
+    echo "$RL not found, run make first" >&2
+    exit 2
+fi
+
+modprobe netdevsim || exit 2
+echo "$NSIM_ID 1" > /sys/bus/netdevsim/new_device || exit 2
+udevadm settle 2>/dev/null
+NSIM=$(ls /sys/bus/netdevsim/devices/netdevsim$NSIM_ID/net/)
+ip link set dev "$NSIM" up
+
+# 7 pps is 0.07 packets per 10ms epoch: rounding it to whole tokens would
+# let 100 pps through, milli-tokens keep it exact.
+"$RL" -i "$NSIM" -m xdp-offload -r 7 -b 20 -s "$SOCK" -v &
+RL_PID=$!
+for _ in $(seq 50); do
+    [ -S "$SOCK" ] && break
+    sleep 0.1
+done
+[ -S "$SOCK" ] || { fail "daemon did not start"; exit 1; }
+
+if ip -details link show dev "$NSIM" | grep -q 'prog/xdpoffload'; then
+    pass "program attached in offload mode"
+else
+    fail "program not attached in offload mode"
+fi
+
+if ctl stats | grep -q "^xdp $NSIM mode=offload"; then
+    pass "stats reports mode=offload"
+else
+    fail "stats does not report mode=offload"
+fi
+
+check_cfg 7 20
+
+ctl "set-policy rate=150 burst=30" >/dev/null
+check_cfg 150 30
+
+kill "$RL_PID"
+wait "$RL_PID"
+RL_PID=
+if [ -z "$(xdp_prog_id)" ]; then
+    pass "program detached on shutdown"
+else
+    fail "program still attached after shutdown"
+fi
+
+[ "$FAILED" -eq 0 ] && echo PASS || echo FAIL
+exit "$FAILED"